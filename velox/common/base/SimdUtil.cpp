@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/SimdUtil.h"
+#include <folly/CpuId.h>
 #include <folly/Preprocessor.h>
 
 namespace facebook::velox::simd {
@@ -92,7 +93,35 @@ bool initializeSimdUtil() {
   return true;
 }
 
-int32_t indicesOfSetBits(
+namespace {
+
+SimdLevel detectLevel() {
+  folly::CpuId cpuId;
+  if (cpuId.avx512f() && cpuId.avx512vl()) {
+    return SimdLevel::kAvx512;
+  }
+  if (cpuId.avx2()) {
+    return SimdLevel::kAvx2;
+  }
+  return SimdLevel::kScalar;
+}
+
+SimdLevel& mutableSimdLevel() {
+  static SimdLevel level = detectedSimdLevel();
+  return level;
+}
+
+int32_t indicesOfSetBitsScalar(
+    const uint64_t* bits,
+    int32_t begin,
+    int32_t end,
+    int32_t* result) {
+  auto originalResult = result;
+  bits::forEachSetBit(bits, begin, end, [&](int32_t row) { *result++ = row; });
+  return result - originalResult;
+}
+
+int32_t indicesOfSetBitsAvx2(
     const uint64_t* bits,
     int32_t begin,
     int32_t end,
@@ -148,6 +177,303 @@ int32_t indicesOfSetBits(
   return result - originalResult;
 }
 
+// Same as indicesOfSetBitsAvx2 but compresses 16 lanes at a time.
+__attribute__((target("avx512f"))) int32_t indicesOfSetBitsAvx512(
+    const uint64_t* bits,
+    int32_t begin,
+    int32_t end,
+    int32_t* result) {
+  if (end <= begin) {
+    return 0;
+  }
+  const auto iota = _mm512_set_epi32(
+      15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  int32_t row = begin & ~63;
+  auto originalResult = result;
+  int32_t endWord = bits::roundUp(end, 64) / 64;
+  auto firstWord = begin / 64;
+  for (auto wordIndex = firstWord; wordIndex < endWord; ++wordIndex) {
+    uint64_t word = bits[wordIndex];
+    if (wordIndex == firstWord && begin) {
+      word &= bits::highMask(64 - (begin - firstWord * 64));
+    }
+    if (wordIndex == endWord - 1) {
+      int32_t lastBits = end - (endWord - 1) * 64;
+      if (lastBits < 64) {
+        word &= bits::lowMask(lastBits);
+      }
+    }
+    if (!word) {
+      row += 64;
+      continue;
+    }
+    if (result - originalResult < (row >> 2)) {
+      do {
+        *result++ = __builtin_ctzll(word) + row;
+        word = word & (word - 1);
+      } while (word);
+    } else {
+      for (auto i = 0; i < 4; ++i) {
+        __mmask16 mask = word >> (i * 16);
+        if (mask) {
+          auto indices = _mm512_maskz_compress_epi32(
+              mask, _mm512_add_epi32(iota, _mm512_set1_epi32(row + i * 16)));
+          auto numBits = __builtin_popcount(mask);
+          _mm512_mask_storeu_epi32(result, bits::lowMask(numBits), indices);
+          result += numBits;
+        }
+      }
+    }
+    row += 64;
+  }
+  return result - originalResult;
+}
+
+template <typename T>
+int32_t filterRangeScalar(
+    const T* values,
+    int32_t numValues,
+    T lower,
+    T upper,
+    int32_t firstRow,
+    int32_t* rows,
+    T* passingValues) {
+  int32_t numPassed = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    auto value = values[i];
+    if (value >= lower && value <= upper) {
+      rows[numPassed] = firstRow + i;
+      if (passingValues) {
+        passingValues[numPassed] = value;
+      }
+      ++numPassed;
+    }
+  }
+  return numPassed;
+}
+
+template <typename T>
+int32_t filterRangeAvx2(
+    const T* values,
+    int32_t numValues,
+    T lower,
+    T upper,
+    int32_t firstRow,
+    int32_t* rows,
+    T* passingValues) {
+  using TV = Vectors<T>;
+  constexpr int32_t kWidth = TV::VSize;
+  auto lowerV = TV::setAll(lower);
+  auto upperV = TV::setAll(upper);
+  int32_t numPassed = 0;
+  int32_t i = 0;
+  for (; i + kWidth <= numValues; i += kWidth) {
+    auto data = TV::load(values + i);
+    uint8_t passed = TV::kAllTrue &
+        ~TV::compareBitMask(
+            TV::compareGt(lowerV, data) | TV::compareGt(data, upperV));
+    if (!passed) {
+      continue;
+    }
+    if (passed == TV::kAllTrue) {
+      V32::store(rows + numPassed, V32::iota() + (firstRow + i));
+      if (passingValues) {
+        TV::store(passingValues + numPassed, data);
+      }
+    } else if constexpr (sizeof(T) == 4) {
+      auto setBits = V32::compareSetBits(passed);
+      V32::store(rows + numPassed, setBits + (firstRow + i));
+      if (passingValues) {
+        storePermute(passingValues + numPassed, data, setBits);
+      }
+    } else {
+      V32::store(rows + numPassed, V64::compareSetBits(passed) + (firstRow + i));
+      if (passingValues) {
+        storePermute(
+            passingValues + numPassed,
+            reinterpret_cast<__m256si>(data),
+            V32::load(&V64::permuteIndices()[passed]));
+      }
+    }
+    numPassed += __builtin_popcount(passed);
+  }
+  return numPassed +
+      filterRangeScalar(
+             values + i,
+             numValues - i,
+             lower,
+             upper,
+             firstRow + i,
+             rows + numPassed,
+             passingValues ? passingValues + numPassed : nullptr);
+}
+
+__attribute__((target("avx512f,avx512vl"))) int32_t filterRangeAvx512(
+    const int32_t* values,
+    int32_t numValues,
+    int32_t lower,
+    int32_t upper,
+    int32_t firstRow,
+    int32_t* rows,
+    int32_t* passingValues) {
+  const auto iota = _mm512_set_epi32(
+      15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  auto lowerV = _mm512_set1_epi32(lower);
+  auto upperV = _mm512_set1_epi32(upper);
+  int32_t numPassed = 0;
+  int32_t i = 0;
+  for (; i < numValues; i += 16) {
+    __mmask16 active = numValues - i >= 16 ? 0xffff : bits::lowMask(numValues - i);
+    auto data = _mm512_maskz_loadu_epi32(active, values + i);
+    __mmask16 passed = _mm512_mask_cmple_epi32_mask(
+        _mm512_mask_cmpge_epi32_mask(active, data, lowerV), data, upperV);
+    if (!passed) {
+      continue;
+    }
+    auto numBits = __builtin_popcount(passed);
+    __mmask16 storeMask = bits::lowMask(numBits);
+    _mm512_mask_storeu_epi32(
+        rows + numPassed,
+        storeMask,
+        _mm512_maskz_compress_epi32(
+            passed, _mm512_add_epi32(iota, _mm512_set1_epi32(firstRow + i))));
+    if (passingValues) {
+      _mm512_mask_storeu_epi32(
+          passingValues + numPassed,
+          storeMask,
+          _mm512_maskz_compress_epi32(passed, data));
+    }
+    numPassed += numBits;
+  }
+  return numPassed;
+}
+
+__attribute__((target("avx512f,avx512vl"))) int32_t filterRangeAvx512(
+    const int64_t* values,
+    int32_t numValues,
+    int64_t lower,
+    int64_t upper,
+    int32_t firstRow,
+    int32_t* rows,
+    int64_t* passingValues) {
+  const auto iota = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  auto lowerV = _mm512_set1_epi64(lower);
+  auto upperV = _mm512_set1_epi64(upper);
+  int32_t numPassed = 0;
+  int32_t i = 0;
+  for (; i < numValues; i += 8) {
+    __mmask8 active = numValues - i >= 8 ? 0xff : bits::lowMask(numValues - i);
+    auto data = _mm512_maskz_loadu_epi64(active, values + i);
+    __mmask8 passed = _mm512_mask_cmple_epi64_mask(
+        _mm512_mask_cmpge_epi64_mask(active, data, lowerV), data, upperV);
+    if (!passed) {
+      continue;
+    }
+    auto numBits = __builtin_popcount(passed);
+    __mmask8 storeMask = bits::lowMask(numBits);
+    _mm256_mask_storeu_epi32(
+        rows + numPassed,
+        storeMask,
+        _mm256_maskz_compress_epi32(
+            passed, _mm256_add_epi32(iota, _mm256_set1_epi32(firstRow + i))));
+    if (passingValues) {
+      _mm512_mask_storeu_epi64(
+          passingValues + numPassed,
+          storeMask,
+          _mm512_maskz_compress_epi64(passed, data));
+    }
+    numPassed += numBits;
+  }
+  return numPassed;
+}
+
+} // namespace
+
+SimdLevel detectedSimdLevel() {
+  static const SimdLevel level = detectLevel();
+  return level;
+}
+
+SimdLevel simdLevel() {
+  return mutableSimdLevel();
+}
+
+void setSimdLevel(SimdLevel level) {
+  VELOX_CHECK_LE(
+      static_cast<int32_t>(level),
+      static_cast<int32_t>(detectedSimdLevel()),
+      "SIMD level {} is not supported by the CPU",
+      simdLevelName(level));
+  mutableSimdLevel() = level;
+}
+
+const char* simdLevelName(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kScalar:
+      return "scalar";
+    case SimdLevel::kAvx2:
+      return "avx2";
+    case SimdLevel::kAvx512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+int32_t indicesOfSetBits(
+    const uint64_t* bits,
+    int32_t begin,
+    int32_t end,
+    int32_t* result) {
+  switch (simdLevel()) {
+    case SimdLevel::kAvx512:
+      return indicesOfSetBitsAvx512(bits, begin, end, result);
+    case SimdLevel::kAvx2:
+      return indicesOfSetBitsAvx2(bits, begin, end, result);
+    default:
+      return indicesOfSetBitsScalar(bits, begin, end, result);
+  }
+}
+
+template <typename T>
+int32_t filterRange(
+    const T* values,
+    int32_t numValues,
+    T lower,
+    T upper,
+    int32_t firstRow,
+    int32_t* rows,
+    T* passingValues) {
+  switch (simdLevel()) {
+    case SimdLevel::kAvx512:
+      return filterRangeAvx512(
+          values, numValues, lower, upper, firstRow, rows, passingValues);
+    case SimdLevel::kAvx2:
+      return filterRangeAvx2(
+          values, numValues, lower, upper, firstRow, rows, passingValues);
+    default:
+      return filterRangeScalar(
+          values, numValues, lower, upper, firstRow, rows, passingValues);
+  }
+}
+
+template int32_t filterRange(
+    const int32_t*,
+    int32_t,
+    int32_t,
+    int32_t,
+    int32_t,
+    int32_t*,
+    int32_t*);
+
+template int32_t filterRange(
+    const int64_t*,
+    int32_t,
+    int64_t,
+    int64_t,
+    int32_t,
+    int32_t*,
+    int64_t*);
+
 static bool FB_ANONYMOUS_VARIABLE(g_simdConstants) = initializeSimdUtil();
 
 } // namespace facebook::velox::simd
@@ -82,13 +82,48 @@ bool initializeSimdUtil();
 // Returns positions of set bits in 'bits' in 'indices'. Bits from
 // 'begin' to 'end' are considered and the return value is the number
 // of found set bits. For bits 0xff and begin 2 and end 5 we have a return value
-// of 3 and indices is set to {2, 3, 4}.
+// of 3 and indices is set to {2, 3, 4}. Dispatches on simdLevel().
 int32_t indicesOfSetBits(
     const uint64_t* bits,
     int32_t begin,
     int32_t end,
     int32_t* indices);
 
+// Instruction sets for kernels that select their implementation at run
+// time. The rest of this file is AVX2.
+enum class SimdLevel { kScalar, kAvx2, kAvx512 };
+
+// Returns the widest level supported by the CPU.
+SimdLevel detectedSimdLevel();
+
+// Returns the level used by kernels that dispatch at run time. Defaults to
+// detectedSimdLevel().
+SimdLevel simdLevel();
+
+// Sets the level used by kernels that dispatch at run time. Used for
+// comparing levels in tests and benchmarks. 'level' must be supported by
+// the CPU.
+void setSimdLevel(SimdLevel level);
+
+const char* simdLevelName(SimdLevel level);
+
+// Writes the row numbers of the values in 'values[0]' to 'values[numValues -
+// 1]' that are between 'lower' and 'upper', inclusive, to 'rows'. The row
+// number of values[i] is 'firstRow' + i. If 'passingValues' is not nullptr,
+// writes the passing values there. Returns the number of passing values.
+// 'rows' and 'passingValues' may be written up to kPadding bytes past the
+// last passing value. Defined for int32_t and int64_t. Dispatches on
+// simdLevel(), so that AVX512 compresses 16 lanes at a time.
+template <typename T>
+int32_t filterRange(
+    const T* values,
+    int32_t numValues,
+    T lower,
+    T upper,
+    int32_t firstRow,
+    int32_t* rows,
+    T* passingValues);
+
 // Casts an arbitrary 256 bit vector to __m256i, which all integer intrinsics
 // expect.
 template <typename T>
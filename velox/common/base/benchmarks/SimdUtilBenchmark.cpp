@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/base/SimdUtil.h"
+
+namespace facebook::velox::test {
+namespace {
+
+constexpr int32_t kNumValues = 10000;
+
+template <typename T>
+std::vector<T> makeValues() {
+  folly::Random::DefaultGenerator rng(1);
+  std::vector<T> values(kNumValues);
+  for (auto& value : values) {
+    value = folly::Random::rand32(rng) % 1000;
+  }
+  return values;
+}
+
+std::vector<uint64_t> makeBits(int32_t onesPer1000) {
+  folly::Random::DefaultGenerator rng(1);
+  std::vector<uint64_t> bits(bits::nwords(kNumValues));
+  for (auto i = 0; i < kNumValues; ++i) {
+    if (folly::Random::rand32(rng) % 1000 < onesPer1000) {
+      bits::setBit(bits.data(), i);
+    }
+  }
+  return bits;
+}
+
+// Runs 'kernel' 100 times at 'level'. Returns 0 if the CPU does not support
+// 'level'.
+template <typename Kernel>
+size_t runAtLevel(simd::SimdLevel level, Kernel kernel) {
+  if (level > simd::detectedSimdLevel()) {
+    return 0;
+  }
+  simd::setSimdLevel(level);
+  int32_t count = 0;
+  for (auto i = 0; i < 100; ++i) {
+    count += kernel();
+  }
+  folly::doNotOptimizeAway(count);
+  simd::setSimdLevel(simd::detectedSimdLevel());
+  return 100;
+}
+
+// Passes about 30% of the values.
+template <typename T>
+size_t filterRange(simd::SimdLevel level) {
+  static const auto values = makeValues<T>();
+  std::vector<int32_t> rows(kNumValues + simd::kPadding);
+  std::vector<T> passingValues(kNumValues + simd::kPadding);
+  return runAtLevel(level, [&]() {
+    return simd::filterRange<T>(
+        values.data(),
+        kNumValues,
+        100,
+        399,
+        0,
+        rows.data(),
+        passingValues.data());
+  });
+}
+
+size_t indicesOfSetBits(simd::SimdLevel level, int32_t onesPer1000) {
+  auto bits = makeBits(onesPer1000);
+  std::vector<int32_t> indices(kNumValues + simd::kPadding);
+  return runAtLevel(level, [&]() {
+    return simd::indicesOfSetBits(bits.data(), 0, kNumValues, indices.data());
+  });
+}
+
+BENCHMARK_MULTI(filterRange32Scalar) {
+  return filterRange<int32_t>(simd::SimdLevel::kScalar);
+}
+
+BENCHMARK_RELATIVE_MULTI(filterRange32Avx2) {
+  return filterRange<int32_t>(simd::SimdLevel::kAvx2);
+}
+
+BENCHMARK_RELATIVE_MULTI(filterRange32Avx512) {
+  return filterRange<int32_t>(simd::SimdLevel::kAvx512);
+}
+
+BENCHMARK_MULTI(filterRange64Scalar) {
+  return filterRange<int64_t>(simd::SimdLevel::kScalar);
+}
+
+BENCHMARK_RELATIVE_MULTI(filterRange64Avx2) {
+  return filterRange<int64_t>(simd::SimdLevel::kAvx2);
+}
+
+BENCHMARK_RELATIVE_MULTI(filterRange64Avx512) {
+  return filterRange<int64_t>(simd::SimdLevel::kAvx512);
+}
+
+BENCHMARK_MULTI(indicesOfSetBits50Scalar) {
+  return indicesOfSetBits(simd::SimdLevel::kScalar, 500);
+}
+
+BENCHMARK_RELATIVE_MULTI(indicesOfSetBits50Avx2) {
+  return indicesOfSetBits(simd::SimdLevel::kAvx2, 500);
+}
+
+BENCHMARK_RELATIVE_MULTI(indicesOfSetBits50Avx512) {
+  return indicesOfSetBits(simd::SimdLevel::kAvx512, 500);
+}
+
+} // namespace
+} // namespace facebook::velox::test
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -98,16 +98,94 @@ class SimdUtilTest : public testing::Test {
     EXPECT_EQ(reference, target);
   }
 
+  // Checks filterRange at the current simd level against a scalar loop.
+  template <typename T>
+  void testFilterRange(int32_t numValues) {
+    std::vector<T> values(numValues);
+    for (auto& value : values) {
+      value = folly::Random::rand32(rng_) % 1000 - 500;
+    }
+    const T lower = -200;
+    const T upper = 300;
+    const int32_t firstRow = 17;
+    std::vector<int32_t> expectedRows;
+    std::vector<T> expectedValues;
+    for (auto i = 0; i < numValues; ++i) {
+      if (values[i] >= lower && values[i] <= upper) {
+        expectedRows.push_back(firstRow + i);
+        expectedValues.push_back(values[i]);
+      }
+    }
+    auto padding = simd::kPadding / sizeof(int32_t);
+    std::vector<int32_t> rows(numValues + padding);
+    std::vector<T> passingValues(numValues + padding);
+    auto numPassed = simd::filterRange<T>(
+        values.data(),
+        numValues,
+        lower,
+        upper,
+        firstRow,
+        rows.data(),
+        passingValues.data());
+    ASSERT_EQ(expectedRows.size(), numPassed);
+    for (auto i = 0; i < numPassed; ++i) {
+      ASSERT_EQ(expectedRows[i], rows[i]);
+      ASSERT_EQ(expectedValues[i], passingValues[i]);
+    }
+    std::fill(rows.begin(), rows.end(), 0);
+    numPassed = simd::filterRange<T>(
+        values.data(), numValues, lower, upper, firstRow, rows.data(), nullptr);
+    ASSERT_EQ(expectedRows.size(), numPassed);
+    for (auto i = 0; i < numPassed; ++i) {
+      ASSERT_EQ(expectedRows[i], rows[i]);
+    }
+  }
+
+  // Returns the simd levels supported by the CPU.
+  std::vector<simd::SimdLevel> supportedLevels() {
+    std::vector<simd::SimdLevel> levels;
+    for (auto level :
+         {simd::SimdLevel::kScalar,
+          simd::SimdLevel::kAvx2,
+          simd::SimdLevel::kAvx512}) {
+      if (level <= simd::detectedSimdLevel()) {
+        levels.push_back(level);
+      }
+    }
+    return levels;
+  }
+
   folly::Random::DefaultGenerator rng_;
 };
 
 TEST_F(SimdUtilTest, bitIndices) {
-  testIndices(1);
-  testIndices(10);
-  testIndices(100);
-  testIndices(250);
-  testIndices(500);
-  testIndices(999);
+  for (auto level : supportedLevels()) {
+    SCOPED_TRACE(simd::simdLevelName(level));
+    simd::setSimdLevel(level);
+    testIndices(1);
+    testIndices(10);
+    testIndices(100);
+    testIndices(250);
+    testIndices(500);
+    testIndices(999);
+  }
+  simd::setSimdLevel(simd::detectedSimdLevel());
+}
+
+TEST_F(SimdUtilTest, filterRange) {
+  for (auto level : supportedLevels()) {
+    SCOPED_TRACE(simd::simdLevelName(level));
+    simd::setSimdLevel(level);
+    for (auto numValues : {0, 1, 7, 8, 15, 16, 17, 100, 1001}) {
+      testFilterRange<int32_t>(numValues);
+      testFilterRange<int64_t>(numValues);
+    }
+  }
+  simd::setSimdLevel(simd::detectedSimdLevel());
+  EXPECT_THROW(
+      simd::setSimdLevel(static_cast<simd::SimdLevel>(
+          static_cast<int>(simd::detectedSimdLevel()) + 1)),
+      VeloxException);
 }
 
 TEST_F(SimdUtilTest, gather32) {
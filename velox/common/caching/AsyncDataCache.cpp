@@ -15,10 +15,12 @@
  */
 
 #include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/DecodedDataCache.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 
 #include <folly/executors/QueuedImmediateExecutor.h>
+#include <folly/futures/Future.h>
 #include "velox/common/caching/FileIds.h"
 
 namespace facebook::velox::cache {
@@ -50,7 +52,7 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
     hook(*this);
   }
 
-  if (!ssdFile_ && shard_->cache()->ssdCache()) {
+  if (!ssdFile_ && isAdmitted_ && shard_->cache()->ssdCache()) {
     auto ssdCache = shard_->cache()->ssdCache();
     assert(ssdCache); // for lint only.
     if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_)) {
@@ -149,9 +151,13 @@ CachePin CacheShard::findOrCreate(
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
   AsyncDataCacheEntry* entryToInit = nullptr;
+  const auto hash = admission_ ? std::hash<RawFileCacheKey>()(key) : 0;
   {
     std::lock_guard<std::mutex> l(mutex_);
     ++eventCounter_;
+    if (admission_) {
+      admission_->recordAccess(hash);
+    }
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
       auto found = it->second;
@@ -165,6 +171,10 @@ CachePin CacheShard::findOrCreate(
       }
       if (found->size() >= size) {
         found->touch();
+        if (!found->isAdmitted_ &&
+            admission_->frequency(hash) > admissionThreshold_) {
+          found->isAdmitted_ = true;
+        }
         // The entry is in a readable state. Add a pin.
         if (found->isPrefetch_) {
           found->isFirstUse_ = true;
@@ -204,6 +214,11 @@ CachePin CacheShard::findOrCreate(
     VELOX_CHECK_EQ(0, entryToInit->size_);
     entryToInit->size_ = size;
     entryToInit->isFirstUse_ = true;
+    entryToInit->isAdmitted_ =
+        !admission_ || admission_->frequency(hash) > admissionThreshold_;
+    if (!entryToInit->isAdmitted_) {
+      ++numNotAdmitted_;
+    }
   }
   return initEntry(key, entryToInit);
 }
@@ -358,8 +373,10 @@ void CacheShard::evict(uint64_t bytesToFree, bool evictAllUnpinned) {
         eventCounter_ = 0;
       }
       int32_t score = 0;
+      // A prefetched entry that is not admitted is kept until its first use.
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
+           (!candidate->isAdmitted_ && !candidate->isPrefetch_) ||
            (score = candidate->score(now)) >= evictionThreshold_)) {
         if (skipSsdSaveable && candidate->ssdSaveable_ && !evictAllUnpinned) {
           ++evictSaveableSkipped;
@@ -419,6 +436,24 @@ void CacheShard::calibrateThreshold() {
       },
       numSamples,
       80);
+  if (!admission_) {
+    return;
+  }
+  // As in TinyLFU, a new entry must be accessed more often than a typical
+  // eviction victim, here the least frequently accessed fifth of the
+  // sampled admitted entries.
+  std::vector<int32_t> frequencies;
+  entryIndex = (clockHand_ % entries_.size());
+  for (auto i = 0; i < numSamples; ++i) {
+    auto element = entries_[(entryIndex + i * step) % entries_.size()].get();
+    if (element && element->key_.fileNum.hasValue() && element->isAdmitted_) {
+      frequencies.push_back(admission_->frequency(std::hash<RawFileCacheKey>()(
+          {element->key_.fileNum.id(), element->key_.offset})));
+    }
+  }
+  std::sort(frequencies.begin(), frequencies.end());
+  admissionThreshold_ =
+      frequencies.empty() ? 0 : frequencies[frequencies.size() / 5];
 }
 
 void CacheShard::updateStats(CacheStats& stats) {
@@ -449,6 +484,7 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numWaitExclusive += numWaitExclusive_;
   stats.sumEvictScore += sumEvictScore_;
   stats.allocClocks += allocClocks_;
+  stats.numNotAdmitted += numNotAdmitted_;
 }
 
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
@@ -487,6 +523,37 @@ AsyncDataCache::AsyncDataCache(
   }
 }
 
+AsyncDataCache::~AsyncDataCache() {
+  // The decoded entries free their memory through 'this'.
+  decodedCache_ = nullptr;
+  decodedCacheHolder_.reset();
+}
+
+void AsyncDataCache::enableDecodedCache(uint64_t maxBytes) {
+  VELOX_CHECK_LE(maxBytes, maxBytes_);
+  std::lock_guard<std::mutex> l(decodedCacheMutex_);
+  if (decodedCacheHolder_) {
+    return;
+  }
+  decodedCacheHolder_ = std::make_unique<DecodedDataCache>(maxBytes, this);
+  decodedCache_ = decodedCacheHolder_.get();
+}
+
+void AsyncDataCache::enableAdmission() {
+  // Sized for entries of 64K. The count is approximate since entries range
+  // from a few bytes to the load quantum.
+  constexpr int32_t kAdmissionEntrySize = 64 << 10;
+  for (auto& shard : shards_) {
+    shard->enableAdmission(std::max<int64_t>(
+        1024, maxBytes_ / kNumShards / kAdmissionEntrySize));
+  }
+  if (ssdCache_) {
+    ssdCache_->enableAdmission(std::min<int64_t>(
+        ssdCache_->maxBytes() / kAdmissionEntrySize,
+        std::numeric_limits<int32_t>::max()));
+  }
+}
+
 CachePin AsyncDataCache::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
@@ -568,9 +635,20 @@ bool AsyncDataCache::makeSpace(
     // Evict from next shard. If we have gone through all shards once
     // and still have not made the allocation, we go to desperate mode
     // with 'evictAllUnpinned' set to true.
-    shards_[shardCounter_ & (kShardMask)]->evict(
+    auto& shard = shards_[shardCounter_ & (kShardMask)];
+    shard->evict(
         numPages * sizeMultiplier * MappedMemory::kPageSize,
         nthAttempt >= kNumShards);
+    // Decoded entries compete with raw entries: The ones whose weighted
+    // score is over the eviction threshold of the shard are evicted
+    // together with its raw entries. All unused decoded entries are evicted
+    // only in the last round.
+    if (auto decodedCache = decodedCache_.load()) {
+      decodedCache->evict(
+          numPages * sizeMultiplier * MappedMemory::kPageSize,
+          nthAttempt >= kMaxAttempts - kNumShards,
+          shard->evictionThreshold());
+    }
     if (numPages < kSmallSizePages && sizeMultiplier < 4) {
       sizeMultiplier *= 2;
     }
@@ -664,6 +742,9 @@ void AsyncDataCache::clear() {
   for (auto& shard : shards_) {
     shard->evict(std::numeric_limits<int32_t>::max(), true);
   }
+  if (auto decodedCache = decodedCache_.load()) {
+    decodedCache->clear();
+  }
 }
 
 std::string AsyncDataCache::toString() const {
@@ -677,9 +758,17 @@ std::string AsyncDataCache::toString() const {
       << stats.numEvict << "\n"
       << " read pins " << stats.numShared << " write pins "
       << stats.numExclusive << " unused prefetch " << stats.numPrefetch
+      << " not admitted " << stats.numNotAdmitted
       << " Alloc Megaclocks " << (stats.allocClocks >> 20)
       << " allocated pages " << numAllocated() << " cached pages "
       << cachedPages_;
+  if (auto decodedCache = decodedCache_.load()) {
+    auto decoded = decodedCache->stats();
+    out << "\nDecoded: " << decoded.bytes << " / " << decodedCache->maxBytes()
+        << " bytes in " << decoded.numEntries << " entries Miss "
+        << decoded.numMiss << " Hit " << decoded.numHit << " evict "
+        << decoded.numEvict;
+  }
   out << "\nBacking: " << mappedMemory_->toString();
   if (ssdCache_) {
     out << "\nSSD: " << ssdCache_->toString();
@@ -736,4 +825,21 @@ CoalesceIoStats readPins(
       readFunc);
 }
 
+void waitForReads(
+    std::vector<folly::SemiFuture<uint64_t>>& reads,
+    const std::vector<uint64_t>& sizes) {
+  VELOX_CHECK_EQ(reads.size(), sizes.size());
+  if (reads.empty()) {
+    return;
+  }
+  auto results = folly::collectAll(std::move(reads)).get();
+  reads.clear();
+  for (auto i = 0; i < results.size(); ++i) {
+    // Rethrows the error of a failed read.
+    auto bytes = results[i].value();
+    VELOX_CHECK_EQ(
+        bytes, sizes[i], "IOERR: Short read of coalesced cache entries");
+  }
+}
+
 } // namespace facebook::velox::cache
@@ -24,6 +24,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/caching/CacheAdmission.h"
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
@@ -34,6 +35,7 @@ namespace facebook::velox::cache {
 
 class AsyncDataCache;
 class CacheShard;
+class DecodedDataCache;
 class SsdCache;
 class SsdFile;
 
@@ -178,6 +180,17 @@ class AsyncDataCacheEntry {
     return accessStats_.score(now, size_);
   }
 
+  int32_t numUses() const {
+    return accessStats_.numUses;
+  }
+
+  // False if the admission filter of the cache found the key of 'this'
+  // less frequently accessed than the resident entries. Such an entry is
+  // evicted first once unpinned.
+  bool isAdmitted() const {
+    return isAdmitted_;
+  }
+
   bool isShared() const {
     return numPins_ > 0;
   }
@@ -219,6 +232,12 @@ class AsyncDataCacheEntry {
     return ssdFile_;
   }
 
+  // Called when the SSD cache declines to store 'this'. The entry is not
+  // protected from eviction for a pending SSD write after this.
+  void clearSsdSaveable() {
+    ssdSaveable_ = false;
+  }
+
   uint64_t ssdOffset() const {
     return ssdOffset_;
   }
@@ -295,6 +314,9 @@ class AsyncDataCacheEntry {
   // True if this should be saved to SSD.
   bool ssdSaveable_{false};
 
+  // See isAdmitted().
+  bool isAdmitted_{true};
+
   friend class CacheShard;
   friend class CachePin;
 };
@@ -479,6 +501,8 @@ struct CacheStats {
   // Sum of scores of evicted entries. This serves to infer an average
   // lifetime for entries in cache.
   int64_t sumEvictScore{};
+  // Number of new entries that the admission filter did not admit.
+  int64_t numNotAdmitted{};
 };
 
 class ClockTimer {
@@ -530,9 +554,23 @@ class CacheShard {
   // Removes 'entry' from 'this'.
   void removeEntry(AsyncDataCacheEntry* FOLLY_NONNULL entry);
 
+  // Returns the score above which entries are evicted. This is the maximum
+  // int32_t until the shard has first evicted.
+  int32_t evictionThreshold() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return evictionThreshold_;
+  }
+
   // Adds the stats of 'this' to 'stats'.
   void updateStats(CacheStats& stats);
 
+  // Adds a TinyLFU admission filter for about 'numEntries' entries. New
+  // entries whose key is less frequently accessed than the resident entries
+  // are evicted first. Must be called before 'this' is used.
+  void enableAdmission(int32_t numEntries) {
+    admission_ = std::make_unique<CacheAdmission>(numEntries);
+  }
+
   // Appends a batch of non-saved SSD saveable entries in 'this' to
   // 'pins'. This may have to be called several times since this keeps
   // limits on the batch to write at one time. The saveable entries
@@ -572,6 +610,14 @@ class CacheShard {
   uint32_t eventCounter_{};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
+  // Admission filter. nullptr if all new entries are admitted.
+  std::unique_ptr<CacheAdmission> admission_;
+  // A new entry is admitted if its key is accessed more often than
+  // this. Sampled from resident entries together with 'evictionThreshold_',
+  // so that all is admitted until the cache first evicts.
+  int32_t admissionThreshold_{0};
+  // Count of new entries that were not admitted.
+  uint64_t numNotAdmitted_{};
   // Cumulative count of cache hits.
   uint64_t numHit_{};
   // Cumulative count of hits on entries held in exclusive mode.
@@ -598,6 +644,8 @@ class AsyncDataCache : public memory::MappedMemory {
       uint64_t maxBytes,
       std::unique_ptr<SsdCache> ssdCache = nullptr);
 
+  ~AsyncDataCache() override;
+
   // Finds or creates a cache entry corresponding to 'key'. The entry
   // is returned in 'pin'. If the entry is new, it is pinned in
   // exclusive mode and its 'data_' has uninitialized space for at
@@ -676,6 +724,23 @@ class AsyncDataCache : public memory::MappedMemory {
     return ssdCache_.get();
   }
 
+  // Adds a tier for decoded data of up to 'maxBytes'. The memory of the
+  // decoded data is allocated from 'this' and counts against 'maxBytes_'.
+  // Does nothing if the tier is already enabled. May be called concurrently
+  // with other uses of 'this', e.g. by the first scan that asks for the
+  // tier. The decoded data must not outlive 'this'.
+  void enableDecodedCache(uint64_t maxBytes);
+
+  // Adds a TinyLFU admission filter to the shards and to 'ssdCache_'. Keys
+  // seen once, e.g. in a large scan, then do not displace the frequently
+  // used entries. Must be called before 'this' is used.
+  void enableAdmission();
+
+  // Returns the decoded data tier or nullptr if not enabled.
+  DecodedDataCache* FOLLY_NULLABLE decodedCache() const {
+    return decodedCache_;
+  }
+
   // Updates stats for creation of a new cache entry of 'size' bytes,
   // i.e. a cache miss. Periodically updates SSD admission criteria,
   // i.e. reconsider criteria every half cache capacity worth of misses.
@@ -747,6 +812,11 @@ class AsyncDataCache : public memory::MappedMemory {
 
   std::shared_ptr<memory::MappedMemory> mappedMemory_;
   std::unique_ptr<SsdCache> ssdCache_;
+  // Owns the decoded data tier. Set once under 'decodedCacheMutex_'.
+  std::unique_ptr<DecodedDataCache> decodedCacheHolder_;
+  std::mutex decodedCacheMutex_;
+  // The tier in 'decodedCacheHolder_', read without 'decodedCacheMutex_'.
+  std::atomic<DecodedDataCache*> decodedCache_{nullptr};
   std::vector<std::unique_ptr<CacheShard>> shards_;
   int32_t shardCounter_{};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
@@ -826,6 +896,24 @@ CoalesceIoStats readPins(
         uint64_t offset,
         const std::vector<folly::Range<char*>>& buffers)> readFunc);
 
+// Returns the number of bytes a preadv() of 'buffers' reads, including the
+// gaps, which have no data.
+inline uint64_t readSize(const std::vector<folly::Range<char*>>& buffers) {
+  uint64_t size = 0;
+  for (auto& range : buffers) {
+    size += range.size();
+  }
+  return size;
+}
+
+// Waits for 'reads', e.g. issued asynchronously by the 'readFunc' of
+// readPins(). 'sizes' has the expected number of bytes of each read. Throws
+// the first error or short read only after all reads have completed, so that
+// no read is still writing into pins the caller releases on error.
+void waitForReads(
+    std::vector<folly::SemiFuture<uint64_t>>& reads,
+    const std::vector<uint64_t>& sizes);
+
 } // namespace facebook::velox::cache
 
 template <>
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheAdmission.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+
+FrequencySketch::FrequencySketch(int32_t numEntries)
+    : rowSize_(bits::nextPowerOfTwo(std::max<int32_t>(numEntries, 64))) {
+  table_.resize(kNumRows * rowSize_ / kCountersPerWord);
+}
+
+uint64_t FrequencySketch::counterIndex(uint64_t hash, int32_t row) const {
+  // Each row uses a different mix of the hash.
+  auto rowHash = (hash + row * 0x9e3779b97f4a7c15ULL) * 0xc2b2ae3d27d4eb4fULL;
+  rowHash ^= rowHash >> 32;
+  return row * rowSize_ + (rowHash & (rowSize_ - 1));
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  for (auto row = 0; row < kNumRows; ++row) {
+    auto index = counterIndex(hash, row);
+    if (counterAt(index) < kMaxCount) {
+      table_[index / kCountersPerWord] += 1UL
+          << ((index % kCountersPerWord) * 4);
+    }
+  }
+}
+
+int32_t FrequencySketch::frequency(uint64_t hash) const {
+  int32_t result = kMaxCount;
+  for (auto row = 0; row < kNumRows; ++row) {
+    result = std::min(result, counterAt(counterIndex(hash, row)));
+  }
+  return result;
+}
+
+void FrequencySketch::age() {
+  for (auto& word : table_) {
+    // Shifts all 16 counters right by one bit and clears the bit shifted in
+    // from the next counter.
+    word = (word >> 1) & 0x7777777777777777UL;
+  }
+}
+
+CacheAdmission::CacheAdmission(int32_t numEntries)
+    : numEntries_(numEntries),
+      sampleSize_(10L * std::max<int32_t>(numEntries, 64)),
+      sketch_(numEntries) {
+  doorkeeper_.reset(numEntries_);
+}
+
+void CacheAdmission::recordAccess(uint64_t hash) {
+  if (++numAccesses_ >= sampleSize_) {
+    numAccesses_ = 0;
+    sketch_.age();
+    doorkeeper_.reset(numEntries_);
+  }
+  if (!doorkeeper_.mayContain(hash)) {
+    doorkeeper_.insert(hash);
+    return;
+  }
+  sketch_.increment(hash);
+}
+
+int32_t CacheAdmission::frequency(uint64_t hash) const {
+  return sketch_.frequency(hash) + (doorkeeper_.mayContain(hash) ? 1 : 0);
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "velox/common/base/BloomFilter.h"
+
+namespace facebook::velox::cache {
+
+// Count-min sketch of access frequencies with 4 bit counters. Each key
+// increments one counter in each of 4 rows. The frequency of a key is the
+// smallest of its counters.
+class FrequencySketch {
+ public:
+  static constexpr int32_t kMaxCount = 15;
+
+  // Sizes the sketch for tracking about 'numEntries' distinct keys.
+  explicit FrequencySketch(int32_t numEntries);
+
+  // Increments the counters of 'hash'.
+  void increment(uint64_t hash);
+
+  // Returns the estimated number of increments of 'hash', up to kMaxCount.
+  int32_t frequency(uint64_t hash) const;
+
+  // Halves all counters, so that the frequencies reflect recent history.
+  void age();
+
+ private:
+  static constexpr int32_t kNumRows = 4;
+  static constexpr int32_t kCountersPerWord = 16;
+
+  // Returns the index of the counter of 'hash' in row 'row'.
+  uint64_t counterIndex(uint64_t hash, int32_t row) const;
+
+  int32_t counterAt(uint64_t index) const {
+    return (table_[index / kCountersPerWord] >>
+            ((index % kCountersPerWord) * 4)) &
+        kMaxCount;
+  }
+
+  // Counters of all rows. Each row has 'rowSize_' counters.
+  std::vector<uint64_t> table_;
+  uint64_t rowSize_;
+};
+
+// TinyLFU admission filter. Keeps an approximate count of recent accesses
+// of cache keys. The first access of a key after aging only sets a bit in a
+// doorkeeper bloom filter, so that the many keys seen once, e.g. in a large
+// scan, do not dilute the counts of the sketch. After 10 accesses per
+// entry of capacity, the sketch is halved and the doorkeeper is cleared. A
+// cache consults this when deciding whether new data should displace
+// existing data. This is not thread safe. The caller serializes access.
+class CacheAdmission {
+ public:
+  // Sizes the filter for a cache of about 'numEntries' entries.
+  explicit CacheAdmission(int32_t numEntries);
+
+  // Records an access of the key with 'hash'.
+  void recordAccess(uint64_t hash);
+
+  // Returns the estimated number of recent accesses of the key with 'hash'.
+  int32_t frequency(uint64_t hash) const;
+
+  // Returns true if the key with 'candidateHash' is accessed more often than
+  // the key with 'victimHash'.
+  bool admit(uint64_t candidateHash, uint64_t victimHash) const {
+    return frequency(candidateHash) > frequency(victimHash);
+  }
+
+ private:
+  const int32_t numEntries_;
+  // Number of accesses between aging the sketch.
+  const int64_t sampleSize_;
+  int64_t numAccesses_{0};
+  FrequencySketch sketch_;
+  BloomFilter<> doorkeeper_;
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/DecodedDataCache.h"
+
+namespace facebook::velox::cache {
+
+void* DecodedDataAllocator::alloc(int64_t size) {
+  // A 'maxMallocSize' of 0 takes all sizes from the pages of 'mappedMemory_'.
+  auto result = mappedMemory_->allocateBytes(size, 0);
+  VELOX_CHECK_NOT_NULL(
+      result, "Cannot allocate {} bytes for decoded data in cache", size);
+  return result;
+}
+
+void* DecodedDataAllocator::allocZeroFilled(
+    int64_t numMembers,
+    int64_t sizeEach) {
+  auto result = alloc(numMembers * sizeEach);
+  memset(result, 0, numMembers * sizeEach);
+  return result;
+}
+
+void* DecodedDataAllocator::allocAligned(uint16_t alignment, int64_t size) {
+  // Allocations are page aligned.
+  VELOX_CHECK_LE(alignment, memory::MappedMemory::kPageSize);
+  return alloc(size);
+}
+
+void* DecodedDataAllocator::realloc(void* p, int64_t size, int64_t newSize) {
+  auto result = alloc(newSize);
+  if (p) {
+    memcpy(result, p, std::min(size, newSize));
+    free(p, size);
+  }
+  return result;
+}
+
+void* DecodedDataAllocator::reallocAligned(
+    void* p,
+    uint16_t alignment,
+    int64_t size,
+    int64_t newSize) {
+  VELOX_CHECK_LE(alignment, memory::MappedMemory::kPageSize);
+  return realloc(p, size, newSize);
+}
+
+void DecodedDataAllocator::free(void* p, int64_t size) {
+  mappedMemory_->freeBytes(p, size, 0);
+}
+
+DecodedDataCache::DecodedDataCache(
+    uint64_t maxBytes,
+    memory::MappedMemory* mappedMemory)
+    : maxBytes_(maxBytes),
+      memoryManager_(
+          std::make_unique<memory::MemoryManager<DecodedDataAllocator>>(
+              std::make_shared<DecodedDataAllocator>(mappedMemory))),
+      pool_(memoryManager_->getScopedPool()) {}
+
+DecodedDataCache::~DecodedDataCache() {
+  clear();
+  // Buffers of the artifacts reference 'pool_', which is freed with 'this'.
+  VELOX_CHECK_EQ(
+      0,
+      pool_->getCurrentBytes(),
+      "Decoded data is in use at destruction of the decoded data cache");
+}
+
+std::shared_ptr<DecodedData> DecodedDataCache::find(
+    const DecodedCacheKey& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    ++numMiss_;
+    return nullptr;
+  }
+  ++numHit_;
+  it->second.accessStats.touch();
+  return it->second.data;
+}
+
+bool DecodedDataCache::insert(
+    const DecodedCacheKey& key,
+    std::shared_ptr<DecodedData> data) {
+  const auto size = data->byteSize();
+  if (size > maxBytes_ / 8) {
+    return false;
+  }
+  if (cachedBytes_ + size > maxBytes_) {
+    evict(cachedBytes_ + size - maxBytes_);
+  }
+  std::shared_ptr<DecodedData> replaced;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto& entry = entries_[key];
+    if (entry.data) {
+      cachedBytes_ -= entry.size;
+      // Destructed outside of 'mutex_'.
+      replaced = std::move(entry.data);
+    }
+    entry.data = std::move(data);
+    entry.size = size;
+    entry.accessStats.reset();
+    cachedBytes_ += size;
+  }
+  return true;
+}
+
+uint64_t DecodedDataCache::evict(
+    uint64_t bytesToFree,
+    bool evictAll,
+    int32_t minScore) {
+  std::vector<std::shared_ptr<DecodedData>> toFree;
+  uint64_t freed = 0;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto now = accessTime();
+    std::vector<std::pair<int64_t, const DecodedCacheKey*>> candidates;
+    candidates.reserve(entries_.size());
+    uint64_t candidateBytes = 0;
+    for (auto& [key, entry] : entries_) {
+      // An entry in use by a reader would not free memory.
+      if (!evictAll && entry.data.use_count() > 1) {
+        continue;
+      }
+      auto score = entry.accessStats.score(now, entry.size) / kScoreWeight;
+      if (!evictAll && score < minScore) {
+        continue;
+      }
+      candidates.emplace_back(score, &key);
+      candidateBytes += entry.size;
+    }
+    // Ordering by score matters only if some candidates are kept. The heap
+    // costs linear time to make plus a logarithmic time per entry freed.
+    auto lowerScore = [](const auto& left, const auto& right) {
+      return left.first < right.first;
+    };
+    const bool freeAll = candidateBytes <= bytesToFree;
+    if (!freeAll) {
+      std::make_heap(candidates.begin(), candidates.end(), lowerScore);
+    }
+    std::vector<DecodedCacheKey> evicted;
+    while (!candidates.empty() && freed < bytesToFree) {
+      if (!freeAll) {
+        std::pop_heap(candidates.begin(), candidates.end(), lowerScore);
+      }
+      const auto* key = candidates.back().second;
+      candidates.pop_back();
+      auto& entry = entries_.find(*key)->second;
+      freed += entry.size;
+      toFree.push_back(std::move(entry.data));
+      evicted.push_back(*key);
+    }
+    for (auto& key : evicted) {
+      entries_.erase(key);
+    }
+    cachedBytes_ -= freed;
+    numEvict_ += evicted.size();
+  }
+  return freed;
+}
+
+DecodedCacheStats DecodedDataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  DecodedCacheStats stats;
+  stats.numEntries = entries_.size();
+  stats.bytes = cachedBytes_;
+  stats.numHit = numHit_;
+  stats.numMiss = numMiss_;
+  stats.numEvict = numEvict_;
+  return stats;
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox::cache {
+
+// Kinds of decoded data. Distinguishes different artifacts made from the same
+// column of a stripe.
+enum class DecodedKind : int32_t {
+  kStringDictionary = 0,
+};
+
+// Identifies a decoded artifact by file, stripe or row group, column and
+// kind. 'sequence' is the flat map sequence or 0.
+struct DecodedCacheKey {
+  uint64_t fileNum;
+  int32_t stripe;
+  int32_t column;
+  int32_t sequence;
+  DecodedKind kind;
+
+  bool operator==(const DecodedCacheKey& other) const {
+    return fileNum == other.fileNum && stripe == other.stripe &&
+        column == other.column && sequence == other.sequence &&
+        kind == other.kind;
+  }
+};
+
+struct DecodedCacheKeyHasher {
+  size_t operator()(const DecodedCacheKey& key) const {
+    return bits::hashMix(
+        bits::hashMix(key.fileNum, key.stripe),
+        bits::hashMix(
+            key.column,
+            (static_cast<uint64_t>(key.sequence) << 8) |
+                static_cast<int32_t>(key.kind)));
+  }
+};
+
+// Allocator for a MemoryManager that takes memory from the MappedMemory of a
+// cache. Allocations are in whole pages, so that all bytes count towards
+// MappedMemory::numAllocated() and allocating makes space in the cache.
+class DecodedDataAllocator {
+ public:
+  explicit DecodedDataAllocator(memory::MappedMemory* FOLLY_NONNULL
+                                    mappedMemory)
+      : mappedMemory_(mappedMemory) {}
+
+  void* alloc(int64_t size);
+  void* allocZeroFilled(int64_t numMembers, int64_t sizeEach);
+  void* allocAligned(uint16_t alignment, int64_t size);
+  void* realloc(void* p, int64_t size, int64_t newSize);
+  void*
+  reallocAligned(void* p, uint16_t alignment, int64_t size, int64_t newSize);
+  void free(void* p, int64_t size);
+
+ private:
+  memory::MappedMemory* const FOLLY_NONNULL mappedMemory_;
+};
+
+// Base class for decoded artifacts, e.g. a string dictionary, held by
+// DecodedDataCache. The memory of the artifact must come from
+// DecodedDataCache::pool() so that it is counted in the cache and the
+// artifact may outlive the reader that made it. The artifact and any buffers
+// taken from it must not outlive the cache.
+class DecodedData {
+ public:
+  virtual ~DecodedData() = default;
+
+  // Returns the memory held by 'this'.
+  virtual uint64_t byteSize() const = 0;
+};
+
+struct DecodedCacheStats {
+  int32_t numEntries{0};
+  int64_t bytes{0};
+  int64_t numHit{0};
+  int64_t numMiss{0};
+  int64_t numEvict{0};
+};
+
+// Second tier of AsyncDataCache that holds decoded artifacts like stripe
+// dictionaries and small fully decoded columns. The memory of the artifacts
+// is allocated from the MappedMemory of the AsyncDataCache, so that raw
+// entries are evicted to make space for decoded ones and the decoded bytes
+// count against the capacity of the cache. Decoded artifacts are costly to
+// recreate from the raw bytes in the first tier, so their eviction score is
+// divided by kScoreWeight before comparing it with the threshold for
+// evicting raw entries.
+class DecodedDataCache {
+ public:
+  // Decoded entries count as this many uses of a raw entry in eviction.
+  static constexpr int32_t kScoreWeight = 4;
+
+  // 'maxBytes' is the most this may hold. Artifacts over 1/8 of this are not
+  // cached. The memory of the artifacts comes from 'mappedMemory'.
+  DecodedDataCache(
+      uint64_t maxBytes,
+      memory::MappedMemory* FOLLY_NONNULL mappedMemory);
+
+  // Frees all entries. Checks that no memory of the artifacts is referenced
+  // from outside of 'this'.
+  ~DecodedDataCache();
+
+  // Returns the entry for 'key' or nullptr. Updates the access time of the
+  // entry.
+  std::shared_ptr<DecodedData> find(const DecodedCacheKey& key);
+
+  template <typename T>
+  std::shared_ptr<T> find(const DecodedCacheKey& key) {
+    return std::dynamic_pointer_cast<T>(find(key));
+  }
+
+  // Adds 'data' for 'key', replacing any previous entry. Evicts other
+  // entries if over capacity. Returns false if 'data' is too large to
+  // cache.
+  bool insert(const DecodedCacheKey& key, std::shared_ptr<DecodedData> data);
+
+  // Frees at least 'bytesToFree' worth of entries with a weighted score of
+  // at least 'minScore', highest score first. Entries that are also
+  // referenced outside of 'this' are skipped unless 'evictAll' is true, in
+  // which case all entries are dropped. Returns the number of bytes freed.
+  // Called after each round of eviction over the raw entries, so this orders
+  // the candidates only as far as needed.
+  uint64_t
+  evict(uint64_t bytesToFree, bool evictAll = false, int32_t minScore = 0);
+
+  void clear() {
+    evict(std::numeric_limits<uint64_t>::max(), true);
+  }
+
+  // Returns the size of all entries.
+  uint64_t cachedBytes() const {
+    return cachedBytes_;
+  }
+
+  uint64_t maxBytes() const {
+    return maxBytes_;
+  }
+
+  // Memory pool for allocating the memory of cached artifacts.
+  memory::MemoryPool& pool() const {
+    return *pool_;
+  }
+
+  DecodedCacheStats stats() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<DecodedData> data;
+    uint64_t size;
+    AccessStats accessStats;
+  };
+
+  const uint64_t maxBytes_;
+  const std::unique_ptr<memory::MemoryManager<DecodedDataAllocator>>
+      memoryManager_;
+  // Declared after 'memoryManager_' and before 'entries_' so that the
+  // entries are freed first.
+  const std::unique_ptr<memory::ScopedMemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<DecodedCacheKey, Entry, DecodedCacheKeyHasher> entries_;
+  std::atomic<uint64_t> cachedBytes_{0};
+  uint64_t numHit_{0};
+  uint64_t numMiss_{0};
+  uint64_t numEvict_{0};
+};
+
+} // namespace facebook::velox::cache
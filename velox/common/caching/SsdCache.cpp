@@ -60,6 +60,40 @@ bool SsdCache::startWrite() {
 
 void SsdCache::write(std::vector<CachePin> pins) {
   VELOX_CHECK_LE(numShards_, writesInProgress_);
+  if (admission_) {
+    // TinyLFU: an entry is admitted if its frequency is higher than that
+    // of the data it would displace. The frequency of the candidate is
+    // the count of times it has been offered plus its hits in RAM.
+    // Entries are admitted freely while the target file can still grow.
+    std::vector<std::optional<uint64_t>> victims(numShards_);
+    for (auto i = 0; i < numShards_; ++i) {
+      victims[i] = files_[i]->evictionVictimHash();
+    }
+    std::lock_guard<std::mutex> l(admissionMutex_);
+    auto numAdmitted = 0;
+    for (auto i = 0; i < pins.size(); ++i) {
+      auto entry = pins[i].checkedEntry();
+      const auto hash = std::hash<RawFileCacheKey>()(
+          {entry->key().fileNum.id(), entry->key().offset});
+      admission_->recordAccess(hash);
+      const auto& victim =
+          victims[file(entry->key().fileNum.id()).shardId()];
+      if (victim.has_value() &&
+          admission_->frequency(hash) + entry->numUses() <=
+              admission_->frequency(victim.value())) {
+        // Not offered again unless the entry is reloaded. The entry is
+        // no longer protected from eviction by the pending write.
+        entry->clearSsdSaveable();
+        ++numNotAdmitted_;
+        continue;
+      }
+      if (numAdmitted != i) {
+        pins[numAdmitted] = std::move(pins[i]);
+      }
+      ++numAdmitted;
+    }
+    pins.resize(numAdmitted);
+  }
   uint64_t bytes = 0;
   auto start = getCurrentTimeMicro();
   std::vector<std::vector<CachePin>> shards(numShards_);
@@ -127,6 +161,9 @@ std::string SsdCache::toString() const {
       << (data.bytesRead >> 20) << "MB Size " << (capacity >> 30)
       << "GB Occupied " << (data.bytesCached >> 30) << "GB";
   out << (data.entriesCached >> 10) << "K entries.";
+  if (admission_) {
+    out << " Not admitted " << numNotAdmitted_;
+  }
   out << "\nGroupStats: " << groupStats_->toString(capacity);
   return out.str();
 }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/caching/CacheAdmission.h"
 #include "velox/common/caching/SsdFile.h"
 
 namespace facebook::velox::cache {
@@ -57,9 +58,24 @@ class SsdCache {
   // Stores the entries of 'pins' into the corresponding files. Sets
   // the file for the successfully stored entries. May evict existing
   // entries from unpinned regions. startWrite() must have been called first and
-  // it must have returned true.
+  // it must have returned true. With an admission filter, once the files are
+  // full an entry is stored only if it has been offered more often than an
+  // entry in the region it would displace. Declined entries are no longer
+  // marked SSD saveable.
   void write(std::vector<CachePin> pins);
 
+  // Adds a TinyLFU admission filter for about 'numEntries' entries. Must be
+  // called before the first write().
+  void enableAdmission(int32_t numEntries) {
+    admission_ = std::make_unique<CacheAdmission>(numEntries);
+  }
+
+  // Returns the number of entries not stored because of the admission
+  // filter.
+  uint64_t numNotAdmitted() const {
+    return numNotAdmitted_;
+  }
+
   // Returns  stats aggregated from all shards.
   SsdCacheStats stats() const;
 
@@ -88,6 +104,11 @@ class SsdCache {
   // Stats for selecting entries to save from AsyncDataCache.
   std::unique_ptr<FileGroupStats> groupStats_;
   folly::Executor* executor_;
+
+  // Serializes access to 'admission_'.
+  std::mutex admissionMutex_;
+  std::unique_ptr<CacheAdmission> admission_;
+  std::atomic<uint64_t> numNotAdmitted_{0};
 };
 
 } // namespace facebook::velox::cache
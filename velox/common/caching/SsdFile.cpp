@@ -18,6 +18,9 @@
 #include <folly/Executor.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/caching/FileIds.h"
+#ifdef VELOX_ENABLE_IO_URING
+#include "velox/common/file/IoUringFile.h"
+#endif
 
 #include <fcntl.h>
 #include <sys/stat.h>
@@ -26,6 +29,11 @@
 
 DEFINE_bool(ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 DEFINE_bool(ssd_verify_write, false, "Read back data after writing to SSD");
+DEFINE_bool(
+    ssd_io_uring,
+    false,
+    "Use io_uring for SSD cache IO. Has no effect unless built with "
+    "VELOX_ENABLE_IO_URING");
 
 namespace facebook::velox::cache {
 
@@ -78,7 +86,14 @@ SsdFile::SsdFile(
     LOG(ERROR) << "Cannot open or create " << filename << " error " << errno;
     exit(1);
   }
-  readFile_ = std::make_unique<LocalReadFile>(fd_);
+#ifdef VELOX_ENABLE_IO_URING
+  if (FLAGS_ssd_io_uring) {
+    readFile_ = std::make_unique<IoUringReadFile>(fd_);
+  }
+#endif
+  if (!readFile_) {
+    readFile_ = std::make_unique<LocalReadFile>(fd_);
+  }
   uint64_t size = lseek(fd_, 0, SEEK_END);
   numRegions_ = size / kRegionSize;
   if (numRegions_ > maxRegions_) {
@@ -94,6 +109,7 @@ SsdFile::SsdFile(
   tracker_.resize(maxRegions_);
   regionSize_.resize(maxRegions_);
   regionPins_.resize(maxRegions_);
+  regionKeyHash_.resize(maxRegions_);
 }
 
 void SsdFile::pinRegion(uint64_t offset) {
@@ -187,7 +203,11 @@ CoalesceIoStats SsdFile::load(
   }
   // Do coalesced IO for the pins. For short payloads, the break-even
   // between discrete pread calls and a single preadv that discards
-  // gaps is ~25K per gap. For longer payloads this is ~50-100K.
+  // gaps is ~25K per gap. For longer payloads this is ~50-100K. If the file
+  // reads asynchronously, all the reads are issued before waiting for any.
+  const bool async = readFile_->hasPreadvAsync();
+  std::vector<folly::SemiFuture<uint64_t>> reads;
+  std::vector<uint64_t> readSizes;
   auto stats = readPins(
       pins,
       payloadTotal / pins.size() < 10000 ? 25000 : 50000,
@@ -201,8 +221,14 @@ CoalesceIoStats SsdFile::load(
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        if (async) {
+          reads.push_back(readFile_->preadvAsync(offset, buffers));
+          readSizes.push_back(readSize(buffers));
+        } else {
+          read(offset, buffers);
+        }
       });
+  waitForReads(reads, readSizes);
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -213,7 +239,30 @@ CoalesceIoStats SsdFile::load(
 void SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
-  readFile_->preadv(offset, buffers);
+  auto bytes = readFile_->preadv(offset, buffers);
+  VELOX_CHECK_EQ(
+      bytes, readSize(buffers), "IOERR: Short read of SSD cache entries");
+}
+
+int64_t SsdFile::write(uint64_t offset, const std::vector<iovec>& iovecs) {
+#ifdef VELOX_ENABLE_IO_URING
+  if (readFile_->hasPreadvAsync()) {
+    IoUring::Request request{fd_, offset, {}};
+    request.buffers.reserve(iovecs.size());
+    for (auto& iov : iovecs) {
+      request.buffers.emplace_back(
+          static_cast<char*>(iov.iov_base), iov.iov_len);
+    }
+    auto& ring = static_cast<IoUringReadFile*>(readFile_.get())->ring();
+    try {
+      return ring.pwritev(request).get();
+    } catch (const std::system_error& e) {
+      errno = e.code().value();
+      return -1;
+    }
+  }
+#endif
+  return folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
 }
 
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
@@ -299,6 +348,7 @@ void SsdFile::clearRegionEntriesLocked(
     // ahead of the best.
     tracker_.regionCleared(region);
     regionSize_[region] = 0;
+    regionKeyHash_[region].reset();
   }
 }
 
@@ -335,7 +385,7 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       ++numWritten;
     }
     VELOX_CHECK_GE(fileSize_, offset + bytes);
-    auto rc = folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
+    auto rc = write(offset, iovecs);
     if (rc != bytes) {
       LOG(ERROR) << "Failed to write to SSD " << errno;
       // If the write fails we return without adding the pins to the cache. The
@@ -350,6 +400,11 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         auto size = entry->size();
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
+        auto& regionKeyHash = regionKeyHash_[regionIndex(offset)];
+        if (!regionKeyHash.has_value()) {
+          regionKeyHash = std::hash<RawFileCacheKey>()(
+              {key.fileNum.id(), key.offset});
+        }
         entries_[std::move(key)] = SsdRun(offset, size);
         if (FLAGS_ssd_verify_write) {
           verifyWrite(*entry, SsdRun(offset, size));
@@ -417,10 +472,24 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   }
 }
 
+std::optional<uint64_t> SsdFile::evictionVictimHash() {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numRegions_ < maxRegions_) {
+    return std::nullopt;
+  }
+  auto candidates =
+      tracker_.findEvictionCandidates(1, numRegions_, regionPins_);
+  if (candidates.empty()) {
+    return std::nullopt;
+  }
+  return regionKeyHash_[candidates[0]];
+}
+
 void SsdFile::clear() {
   std::lock_guard<std::mutex> l(mutex_);
   entries_.clear();
   std::fill(regionSize_.begin(), regionSize_.end(), 0);
+  std::fill(regionKeyHash_.begin(), regionKeyHash_.end(), std::nullopt);
   writableRegions_.resize(numRegions_);
   std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
 }
@@ -24,6 +24,7 @@
 
 DECLARE_bool(ssd_odirect);
 DECLARE_bool(ssd_verify_write);
+DECLARE_bool(ssd_io_uring);
 
 namespace facebook::velox::cache {
 
@@ -186,6 +187,12 @@ class SsdFile {
     return shardId_;
   }
 
+  // Returns the key hash of an entry in the region that would be evicted
+  // next, or std::nullopt if the file can still grow or no region can be
+  // evicted. Used for comparing the access frequency of a write
+  // candidate with that of the data it would displace.
+  std::optional<uint64_t> evictionVictimHash();
+
   // Adds 'stats_' to 'stats'.
   void updateStats(SsdCacheStats& stats) const;
 
@@ -222,6 +229,10 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
+  // Writes 'iovecs' at 'offset' of the backing file. Returns the number of
+  // bytes written or -1 on error.
+  int64_t write(uint64_t offset, const std::vector<iovec>& iovecs);
+
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
@@ -257,6 +268,10 @@ class SsdFile {
   // Pin count for each region.
   std::vector<int32_t> regionPins_;
 
+  // Key hash of the first entry written to each region since the region
+  // was last cleared. Represents the region in admission decisions.
+  std::vector<std::optional<uint64_t>> regionKeyHash_;
+
   // Map of file number and offset to location in file.
   folly::F14FastMap<FileCacheKey, SsdRun> entries_;
 
@@ -269,7 +284,8 @@ class SsdFile {
   // Size of the backing file in bytes. Must be multiple of kRegionSize.
   uint64_t fileSize_{0};
 
-  // ReadFile made from 'fd_'.
+  // ReadFile made from 'fd_'. An IoUringReadFile if 'FLAGS_ssd_io_uring' is
+  // set and the build has io_uring.
   std::unique_ptr<ReadFile> readFile_;
 
   // Counters.
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <random>
+
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/MmapAllocator.h"
+
+DEFINE_int64(cache_mb, 256, "Capacity of the cache");
+DEFINE_int32(entry_kb, 64, "Size of a cache entry");
+DEFINE_int32(hot_pct, 50, "Size of the hot set as % of cache capacity");
+DEFINE_int32(num_lookups, 2000000, "Number of lookups in the trace");
+DEFINE_int32(
+    scan_every,
+    10000,
+    "Number of lookups between scans of data that is read once");
+DEFINE_int32(scan_pct, 200, "Size of a scan as % of cache capacity");
+DEFINE_int32(seed, 1, "Seed of the trace");
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+// Replays a trace of lookups of a hot working set interleaved with large
+// scans of data that is read once. Reports the hit rate of the lookups and
+// of all accesses with and without the admission filter.
+//
+// Usage: velox_cache_admission_benchmark --cache_mb 256 --scan_pct 200
+namespace {
+
+struct ReplayResult {
+  int64_t numLookups{0};
+  int64_t numLookupHits{0};
+  int64_t numAccesses{0};
+  int64_t numHits{0};
+};
+
+// A key of the trace. Scans have offsets above all hot keys.
+struct TraceKey {
+  uint64_t offset;
+  bool isLookup;
+};
+
+std::vector<TraceKey> makeTrace() {
+  const int64_t numEntries = (FLAGS_cache_mb << 20) / (FLAGS_entry_kb << 10);
+  const int64_t numHot = numEntries * FLAGS_hot_pct / 100;
+  const int64_t scanSize = numEntries * FLAGS_scan_pct / 100;
+  const uint64_t entrySize = FLAGS_entry_kb << 10;
+  std::mt19937 rng(FLAGS_seed);
+  // Skewed access to the hot set: the square of a uniform variable puts
+  // most accesses on the first keys.
+  std::uniform_real_distribution<double> uniform(0, 1);
+  std::vector<TraceKey> trace;
+  uint64_t scanOffset = numHot * entrySize;
+  for (auto i = 0; i < FLAGS_num_lookups; ++i) {
+    if (i % FLAGS_scan_every == 0 && i > 0) {
+      for (auto j = 0; j < scanSize; ++j) {
+        trace.push_back({scanOffset, false});
+        scanOffset += entrySize;
+      }
+    }
+    auto r = uniform(rng);
+    auto index = static_cast<int64_t>(r * r * numHot);
+    trace.push_back({index * entrySize, true});
+  }
+  return trace;
+}
+
+ReplayResult replay(const std::vector<TraceKey>& trace, bool admission) {
+  const uint64_t maxBytes = FLAGS_cache_mb << 20;
+  memory::MmapAllocatorOptions options = {maxBytes};
+  auto cache = std::make_shared<AsyncDataCache>(
+      std::make_shared<memory::MmapAllocator>(options), maxBytes);
+  if (admission) {
+    cache->enableAdmission();
+  }
+  StringIdLease file(fileIds(), "cache_admission_benchmark_file");
+  ReplayResult result;
+  for (auto& key : trace) {
+    auto pin =
+        cache->findOrCreate({file.id(), key.offset}, FLAGS_entry_kb << 10);
+    VELOX_CHECK(!pin.empty());
+    const bool hit = pin.checkedEntry()->isShared();
+    if (!hit) {
+      // The trace does not read the data. The entry becomes readable as if
+      // loaded.
+      pin.checkedEntry()->setExclusiveToShared();
+    }
+    ++result.numAccesses;
+    result.numHits += hit;
+    if (key.isLookup) {
+      ++result.numLookups;
+      result.numLookupHits += hit;
+    }
+  }
+  LOG(INFO) << cache->toString();
+  return result;
+}
+
+void printResult(const char* title, const ReplayResult& result) {
+  std::cout << fmt::format(
+                   "{:<20} lookup hit rate {:.1f}% overall hit rate {:.1f}%",
+                   title,
+                   100.0 * result.numLookupHits / result.numLookups,
+                   100.0 * result.numHits / result.numAccesses)
+            << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  auto trace = makeTrace();
+  std::cout << fmt::format(
+                   "Replaying {} accesses, cache {}MB, hot set {}%, scan {}% "
+                   "every {} lookups",
+                   trace.size(),
+                   FLAGS_cache_mb,
+                   FLAGS_hot_pct,
+                   FLAGS_scan_pct,
+                   FLAGS_scan_every)
+            << std::endl;
+  printResult("No admission", replay(trace, false));
+  printResult("TinyLFU admission", replay(trace, true));
+  return 0;
+}
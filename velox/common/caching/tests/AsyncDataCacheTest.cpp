@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include "velox/buffer/Buffer.h"
+#include "velox/common/caching/DecodedDataCache.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/memory/MmapAllocator.h"
@@ -572,6 +574,157 @@ TEST_F(AsyncDataCacheTest, outOfCapacity) {
   EXPECT_EQ(4092, cache_->numAllocated());
 }
 
+namespace {
+class TestDecodedData : public DecodedData {
+ public:
+  TestDecodedData(uint64_t size, memory::MemoryPool& pool)
+      : size_(size), data_(AlignedBuffer::allocate<char>(size, &pool)) {}
+
+  uint64_t byteSize() const override {
+    return size_;
+  }
+
+ private:
+  const uint64_t size_;
+  const BufferPtr data_;
+};
+} // namespace
+
+TEST_F(AsyncDataCacheTest, decodedTier) {
+  constexpr int64_t kMaxBytes = 16 << 20;
+  constexpr int32_t kDecodedSize = 1 << 20;
+  initializeCache(kMaxBytes);
+  cache_->enableDecodedCache(8 << 20);
+  auto decoded = cache_->decodedCache();
+  // Enabling again keeps the existing tier.
+  cache_->enableDecodedCache(4 << 20);
+  EXPECT_EQ(decoded, cache_->decodedCache());
+  EXPECT_EQ(8 << 20, decoded->maxBytes());
+  auto makeData = [&](uint64_t size) {
+    return std::make_shared<TestDecodedData>(size, decoded->pool());
+  };
+
+  DecodedCacheKey key{1, 0, 2, 0, DecodedKind::kStringDictionary};
+  EXPECT_EQ(nullptr, decoded->find(key));
+  EXPECT_TRUE(decoded->insert(key, makeData(kDecodedSize)));
+  EXPECT_NE(nullptr, decoded->find<TestDecodedData>(key));
+  auto otherStripe = key;
+  otherStripe.stripe = 1;
+  EXPECT_EQ(nullptr, decoded->find(otherStripe));
+  // Over 1/8 of the capacity of the tier.
+  EXPECT_FALSE(decoded->insert(otherStripe, makeData(2 * kDecodedSize)));
+
+  // Inserting past the capacity of the tier evicts. An entry that is
+  // referenced outside of the cache is not evicted.
+  std::shared_ptr<TestDecodedData> inUse;
+  for (auto i = 0; i < 10; ++i) {
+    auto columnKey = key;
+    columnKey.column = 100 + i;
+    auto data = makeData(kDecodedSize);
+    if (i == 0) {
+      inUse = data;
+    }
+    EXPECT_TRUE(decoded->insert(columnKey, std::move(data)));
+  }
+  EXPECT_EQ(8 << 20, decoded->cachedBytes());
+  EXPECT_EQ(3, decoded->stats().numEvict);
+  decoded->evict(std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(kDecodedSize, decoded->cachedBytes());
+  inUse.reset();
+  EXPECT_TRUE(decoded->insert(key, makeData(kDecodedSize)));
+  EXPECT_EQ(2 * kDecodedSize, decoded->cachedBytes());
+  // Entries under the eviction threshold of raw entries are kept.
+  EXPECT_EQ(
+      0,
+      decoded->evict(
+          std::numeric_limits<uint64_t>::max(),
+          false,
+          std::numeric_limits<int32_t>::max()));
+
+  // The decoded data is allocated from the cache. Allocating the whole
+  // capacity evicts it.
+  auto numAllocated = cache_->numAllocated();
+  EXPECT_LE(2 * kDecodedSize / MappedMemory::kPageSize, numAllocated);
+  constexpr int32_t kPages = 16;
+  std::deque<MappedMemory::Allocation> allocations;
+  for (;;) {
+    MappedMemory::Allocation allocation(cache_.get());
+    if (!cache_->allocate(kPages, 0, allocation)) {
+      break;
+    }
+    allocations.push_back(std::move(allocation));
+  }
+  EXPECT_EQ(0, decoded->cachedBytes());
+  EXPECT_EQ(12, decoded->stats().numEvict);
+}
+
+TEST_F(AsyncDataCacheTest, admission) {
+  constexpr int64_t kMaxBytes = 16 << 20;
+  constexpr int32_t kSize = 64 << 10;
+  constexpr int32_t kNumHot = 64;
+  initializeCache(kMaxBytes);
+  cache_->enableAdmission();
+  auto access = [&](uint64_t offset) {
+    auto pin = cache_->findOrCreate({filenames_[0].id(), offset}, kSize);
+    EXPECT_FALSE(pin.empty());
+    if (pin.checkedEntry()->isExclusive()) {
+      pin.checkedEntry()->setExclusiveToShared();
+    }
+    return pin;
+  };
+
+  // The hot set is accessed repeatedly and stays pinned.
+  std::vector<CachePin> hotPins;
+  for (auto round = 0; round < 4; ++round) {
+    for (auto i = 0; i < kNumHot; ++i) {
+      auto pin = access(i * kSize);
+      if (round == 3) {
+        hotPins.push_back(std::move(pin));
+      }
+    }
+  }
+  // A scan reads twice the capacity of the cache once.
+  uint64_t offset = kNumHot * kSize;
+  for (auto i = 0; i < 2 * kMaxBytes / kSize; ++i) {
+    access(offset);
+    offset += kSize;
+  }
+  // Once the cache has evicted, a key seen once is not admitted.
+  EXPECT_FALSE(access(offset).checkedEntry()->isAdmitted());
+  EXPECT_TRUE(access(0).checkedEntry()->isAdmitted());
+  EXPECT_LT(0, cache_->refreshStats().numNotAdmitted);
+}
+
+TEST_F(AsyncDataCacheTest, waitForReads) {
+  FLAGS_velox_exception_stacktrace = false;
+  // The first read fails while the second is still in flight. The error is
+  // thrown only after the second read has completed.
+  folly::Promise<uint64_t> promise;
+  std::vector<folly::SemiFuture<uint64_t>> reads;
+  reads.push_back(folly::makeSemiFuture<uint64_t>(
+      std::runtime_error("Testing read error")));
+  reads.push_back(promise.getSemiFuture());
+  std::atomic<bool> completed{false};
+  std::thread reader([&]() {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    completed = true;
+    promise.setValue(100);
+  });
+  EXPECT_THROW(waitForReads(reads, {100, 100}), std::runtime_error);
+  EXPECT_TRUE(completed);
+  reader.join();
+
+  // A short read is an error.
+  reads.push_back(folly::makeSemiFuture<uint64_t>(100));
+  reads.push_back(folly::makeSemiFuture<uint64_t>(50));
+  EXPECT_THROW(waitForReads(reads, {100, 100}), VeloxException);
+
+  reads.push_back(folly::makeSemiFuture<uint64_t>(100));
+  waitForReads(reads, {100});
+  EXPECT_TRUE(reads.empty());
+}
+
 TEST_F(AsyncDataCacheTest, ssd) {
   constexpr uint64_t kRamBytes = 32 << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
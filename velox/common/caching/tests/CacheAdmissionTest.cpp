@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheAdmission.h"
+
+#include <folly/hash/Hash.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+namespace {
+uint64_t keyHash(uint64_t key) {
+  return folly::hasher<uint64_t>()(key);
+}
+} // namespace
+
+TEST(CacheAdmissionTest, sketch) {
+  FrequencySketch sketch(1000);
+  for (auto i = 0; i < 5; ++i) {
+    sketch.increment(keyHash(1));
+  }
+  for (auto i = 0; i < 20; ++i) {
+    sketch.increment(keyHash(2));
+  }
+  EXPECT_EQ(5, sketch.frequency(keyHash(1)));
+  // Counters saturate.
+  EXPECT_EQ(FrequencySketch::kMaxCount, sketch.frequency(keyHash(2)));
+  EXPECT_EQ(0, sketch.frequency(keyHash(3)));
+
+  sketch.age();
+  EXPECT_EQ(2, sketch.frequency(keyHash(1)));
+  EXPECT_EQ(FrequencySketch::kMaxCount / 2, sketch.frequency(keyHash(2)));
+}
+
+TEST(CacheAdmissionTest, admission) {
+  constexpr int32_t kNumEntries = 1000;
+  CacheAdmission admission(kNumEntries);
+  // The first access only sets the doorkeeper.
+  admission.recordAccess(keyHash(1));
+  EXPECT_EQ(1, admission.frequency(keyHash(1)));
+  for (auto i = 0; i < 3; ++i) {
+    admission.recordAccess(keyHash(1));
+  }
+  EXPECT_EQ(4, admission.frequency(keyHash(1)));
+
+  // A scan of keys seen once.
+  for (auto i = 0; i < kNumEntries; ++i) {
+    admission.recordAccess(keyHash(1000 + i));
+  }
+  EXPECT_TRUE(admission.admit(keyHash(1), keyHash(1000)));
+  EXPECT_FALSE(admission.admit(keyHash(1000), keyHash(1)));
+  EXPECT_FALSE(admission.admit(keyHash(1000), keyHash(1001)));
+
+  // After 10 accesses per entry, the counts are halved and the doorkeeper is
+  // cleared.
+  for (auto i = 0; i < 9 * kNumEntries; ++i) {
+    admission.recordAccess(keyHash(100000 + i));
+  }
+  EXPECT_EQ(1, admission.frequency(keyHash(1)));
+}
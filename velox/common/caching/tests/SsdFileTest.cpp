@@ -229,6 +229,8 @@ TEST_F(SsdFileTest, writeAndRead) {
   std::vector<TestEntry> allEntries;
   initializeCache(128 * kMB, kSsdSize);
   FLAGS_ssd_verify_write = true;
+  // Nothing is displaced while the file can grow.
+  EXPECT_FALSE(ssdFile_->evictionVictimHash().has_value());
   for (auto startOffset = 0; startOffset <= kSsdSize - SsdFile::kRegionSize;
        startOffset += SsdFile::kRegionSize) {
     auto pins =
@@ -240,6 +242,7 @@ TEST_F(SsdFileTest, writeAndRead) {
           pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
     };
   }
+  EXPECT_TRUE(ssdFile_->evictionVictimHash().has_value());
 
   // The SsdFile is almost full and the memory cache has the last batch written
   // and a few entries from the batch before that.
@@ -16,6 +16,10 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#ifdef VELOX_ENABLE_IO_URING
+#include <fcntl.h>
+#include "velox/common/file/IoUringFile.h"
+#endif
 #include "velox/exec/tests/utils/TempFilePath.h"
 
 #include "gtest/gtest.h"
@@ -92,6 +96,40 @@ TEST(LocalFile, writeAndRead) {
   readData(&readFile);
 }
 
+#ifdef VELOX_ENABLE_IO_URING
+TEST(IoUringFile, writeAndRead) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // A queue depth of 2 makes the batch below wait for completions.
+  auto ring = std::make_shared<IoUring>(2);
+  IoUringReadFile readFile(filename, false, ring);
+  readData(&readFile);
+
+  std::vector<char> buffer(10 * 5);
+  const auto fd = open(filename, O_RDONLY);
+  std::vector<IoUring::Request> reads;
+  for (auto i = 0; i < 10; ++i) {
+    reads.push_back(
+        {fd,
+         static_cast<uint64_t>(i % 2 == 0 ? 0 : 10 + kOneMB),
+         {folly::Range<char*>(buffer.data() + i * 5, 5)}});
+  }
+  auto futures = ring->preadv(reads);
+  for (auto i = 0; i < 10; ++i) {
+    ASSERT_EQ(5, std::move(futures[i]).get());
+    ASSERT_EQ(
+        std::string_view(buffer.data() + i * 5, 5),
+        i % 2 == 0 ? "aaaaa" : "ddddd");
+  }
+  close(fd);
+}
+#endif
+
 TEST(LocalFile, viaRegistry) {
   filesystems::registerLocalFileSystem();
   auto tempFile = ::exec::test::TempFilePath::create();
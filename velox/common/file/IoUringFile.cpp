@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUringFile.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <system_error>
+
+#include <folly/String.h>
+#include <glog/logging.h>
+
+namespace facebook::velox {
+
+namespace {
+// Target of skipped ranges of reads. Sized so that a typical dropped range of
+// 50K is not too many iovecs.
+char droppedBytes[16 * 1024];
+} // namespace
+
+// State of a submitted request. Owned by the ring from submission until
+// completion.
+struct IoUring::Operation {
+  folly::Promise<uint64_t> promise;
+  std::vector<struct iovec> iovecs;
+};
+
+IoUring::IoUring(int32_t queueDepth) : queueDepth_(queueDepth) {
+  VELOX_CHECK_GT(queueDepth_, 0);
+  // One extra entry for the no-op that stops the completion thread.
+  auto rc = io_uring_queue_init(queueDepth_ + 1, &ring_, 0);
+  VELOX_CHECK_EQ(rc, 0, "io_uring_queue_init failed: {}", folly::errnoStr(-rc));
+  completionThread_ = std::thread([this]() { reapCompletions(); });
+}
+
+IoUring::~IoUring() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto sqe = io_uring_get_sqe(&ring_);
+    VELOX_CHECK_NOT_NULL(sqe);
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    io_uring_submit(&ring_);
+  }
+  completionThread_.join();
+  io_uring_queue_exit(&ring_);
+}
+
+// static
+std::shared_ptr<IoUring> IoUring::defaultInstance() {
+  static auto instance = std::make_shared<IoUring>(kDefaultQueueDepth);
+  return instance;
+}
+
+void IoUring::registerBuffers(const std::vector<folly::Range<char*>>& buffers) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(registeredBuffers_.empty(), "Buffers are already registered");
+  std::vector<struct iovec> iovecs;
+  iovecs.reserve(buffers.size());
+  for (auto& buffer : buffers) {
+    iovecs.push_back({buffer.data(), buffer.size()});
+  }
+  auto rc = io_uring_register_buffers(&ring_, iovecs.data(), iovecs.size());
+  VELOX_CHECK_EQ(
+      rc, 0, "io_uring_register_buffers failed: {}", folly::errnoStr(-rc));
+  registeredBuffers_ = buffers;
+}
+
+int32_t IoUring::registeredBufferIndex(folly::Range<char*> buffer) const {
+  for (auto i = 0; i < registeredBuffers_.size(); ++i) {
+    auto& registered = registeredBuffers_[i];
+    if (buffer.begin() >= registered.begin() &&
+        buffer.end() <= registered.end()) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+std::vector<folly::SemiFuture<uint64_t>> IoUring::preadv(
+    const std::vector<Request>& reads) {
+  std::vector<folly::SemiFuture<uint64_t>> futures;
+  futures.reserve(reads.size());
+  std::unique_lock<std::mutex> l(mutex_);
+  for (auto& read : reads) {
+    futures.push_back(prepareLocked(read, false, l));
+  }
+  auto rc = io_uring_submit(&ring_);
+  VELOX_CHECK_GE(rc, 0, "io_uring_submit failed: {}", folly::errnoStr(-rc));
+  return futures;
+}
+
+folly::SemiFuture<uint64_t> IoUring::pwritev(const Request& write) {
+  std::unique_lock<std::mutex> l(mutex_);
+  auto future = prepareLocked(write, true, l);
+  auto rc = io_uring_submit(&ring_);
+  VELOX_CHECK_GE(rc, 0, "io_uring_submit failed: {}", folly::errnoStr(-rc));
+  return future;
+}
+
+folly::SemiFuture<uint64_t> IoUring::prepareLocked(
+    const Request& request,
+    bool isWrite,
+    std::unique_lock<std::mutex>& lock) {
+  while (numInFlight_ >= queueDepth_) {
+    // Submits what the caller prepared so far, else the wait may not end.
+    io_uring_submit(&ring_);
+    queueSpace_.wait(lock);
+  }
+  auto sqe = io_uring_get_sqe(&ring_);
+  VELOX_CHECK_NOT_NULL(sqe, "No free io_uring submission entry");
+  ++numInFlight_;
+
+  auto operation = std::make_unique<Operation>();
+  auto future = operation->promise.getSemiFuture();
+  if (!isWrite && request.buffers.size() == 1 &&
+      request.buffers[0].data() != nullptr) {
+    auto index = registeredBufferIndex(request.buffers[0]);
+    if (index >= 0) {
+      io_uring_prep_read_fixed(
+          sqe,
+          request.fd,
+          request.buffers[0].data(),
+          request.buffers[0].size(),
+          request.offset,
+          index);
+      io_uring_sqe_set_data(sqe, operation.release());
+      return future;
+    }
+  }
+
+  auto& iovecs = operation->iovecs;
+  iovecs.reserve(request.buffers.size());
+  for (auto& range : request.buffers) {
+    if (!range.data()) {
+      VELOX_CHECK(!isWrite, "Writes may not have skipped ranges");
+      auto skipSize = range.size();
+      while (skipSize) {
+        auto bytes = std::min<size_t>(sizeof(droppedBytes), skipSize);
+        iovecs.push_back({droppedBytes, bytes});
+        skipSize -= bytes;
+      }
+    } else {
+      iovecs.push_back({range.data(), range.size()});
+    }
+  }
+  if (isWrite) {
+    io_uring_prep_writev(
+        sqe, request.fd, iovecs.data(), iovecs.size(), request.offset);
+  } else {
+    io_uring_prep_readv(
+        sqe, request.fd, iovecs.data(), iovecs.size(), request.offset);
+  }
+  io_uring_sqe_set_data(sqe, operation.release());
+  return future;
+}
+
+void IoUring::reapCompletions() {
+  for (;;) {
+    struct io_uring_cqe* cqe;
+    auto rc = io_uring_wait_cqe(&ring_, &cqe);
+    if (rc == -EINTR) {
+      continue;
+    }
+    if (rc < 0) {
+      LOG(ERROR) << "io_uring_wait_cqe failed: " << folly::errnoStr(-rc);
+      continue;
+    }
+    std::unique_ptr<Operation> operation(
+        static_cast<Operation*>(io_uring_cqe_get_data(cqe)));
+    const auto result = cqe->res;
+    io_uring_cqe_seen(&ring_, cqe);
+    if (!operation) {
+      // The no-op from the destructor.
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      --numInFlight_;
+    }
+    queueSpace_.notify_all();
+    if (result < 0) {
+      operation->promise.setException(
+          std::system_error(-result, std::system_category(), "io_uring"));
+    } else {
+      operation->promise.setValue(result);
+    }
+  }
+}
+
+IoUringReadFile::IoUringReadFile(
+    std::string_view path,
+    bool oDirect,
+    std::shared_ptr<IoUring> ring)
+    : ring_(std::move(ring)), ownsFd_(true) {
+  const std::string pathString(path);
+  fd_ = open(pathString.c_str(), O_RDONLY | (oDirect ? O_DIRECT : 0));
+  VELOX_CHECK_GE(
+      fd_,
+      0,
+      "open failure in IoUringReadFile constructor, {}: {}",
+      path,
+      folly::errnoStr(errno));
+}
+
+IoUringReadFile::IoUringReadFile(int32_t fd, std::shared_ptr<IoUring> ring)
+    : ring_(std::move(ring)), fd_(fd), ownsFd_(false) {}
+
+IoUringReadFile::~IoUringReadFile() {
+  if (ownsFd_ && fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+std::string_view
+IoUringReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
+  auto bytesRead =
+      preadv(offset, {folly::Range<char*>(static_cast<char*>(buf), length)});
+  VELOX_CHECK_EQ(
+      bytesRead,
+      length,
+      "pread failure in IoUringReadFile::pread, {} vs {}.",
+      bytesRead,
+      length);
+  return {static_cast<char*>(buf), length};
+}
+
+std::string IoUringReadFile::pread(uint64_t offset, uint64_t length) const {
+  std::string result(length, 0);
+  pread(offset, length, result.data());
+  return result;
+}
+
+uint64_t IoUringReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  return preadvAsync(offset, buffers).get();
+}
+
+folly::SemiFuture<uint64_t> IoUringReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  for (auto& range : buffers) {
+    bytesRead_ += range.size();
+  }
+  auto futures = ring_->preadv({IoUring::Request{fd_, offset, buffers}});
+  return std::move(futures[0]);
+}
+
+uint64_t IoUringReadFile::size() const {
+  if (size_ != -1) {
+    return size_;
+  }
+  const off_t rc = lseek(fd_, 0, SEEK_END);
+  VELOX_CHECK_GE(rc, 0, "fseek failure in IoUringReadFile::size, {}.", rc);
+  size_ = rc;
+  return size_;
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Local file IO over io_uring. Available if built with
+// VELOX_ENABLE_IO_URING.
+
+#pragma once
+
+#include <liburing.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+
+#include "velox/common/file/File.h"
+
+namespace facebook::velox {
+
+/// An io_uring submission and completion queue pair shared by any number of
+/// files and threads. Submissions are serialized by a mutex. Completions are
+/// reaped by a thread owned by 'this', which fulfills the SemiFuture of the
+/// request.
+class IoUring {
+ public:
+  static constexpr int32_t kDefaultQueueDepth = 128;
+
+  /// A vectored read or write of 'buffers' at 'offset'. A buffer with nullptr
+  /// data skips its size worth of bytes of a read, as in ReadFile::preadv().
+  struct Request {
+    int32_t fd;
+    uint64_t offset;
+    std::vector<folly::Range<char*>> buffers;
+  };
+
+  /// Creates a ring with room for 'queueDepth' requests in flight.
+  explicit IoUring(int32_t queueDepth);
+
+  ~IoUring();
+
+  /// Returns a process wide ring.
+  static std::shared_ptr<IoUring> defaultInstance();
+
+  /// Registers 'buffers' with the kernel so that reads into them do not
+  /// need to map the pages for each read. A read with a single buffer that
+  /// is inside a registered buffer uses the registered buffer. May be called
+  /// once, before any reads.
+  void registerBuffers(const std::vector<folly::Range<char*>>& buffers);
+
+  /// Submits 'reads' with a single system call and returns the number of
+  /// bytes read by each. Submission blocks while the queue is full.
+  std::vector<folly::SemiFuture<uint64_t>> preadv(
+      const std::vector<Request>& reads);
+
+  folly::SemiFuture<uint64_t> pwritev(const Request& write);
+
+  int32_t queueDepth() const {
+    return queueDepth_;
+  }
+
+ private:
+  struct Operation;
+
+  // Adds a submission for 'request'. If the queue is full, submits what is
+  // prepared and waits for completions. Returns the SemiFuture of the result.
+  folly::SemiFuture<uint64_t> prepareLocked(
+      const Request& request,
+      bool isWrite,
+      std::unique_lock<std::mutex>& lock);
+
+  // Returns the index of the registered buffer 'buffer' is in or -1.
+  int32_t registeredBufferIndex(folly::Range<char*> buffer) const;
+
+  // Loop of 'completionThread_'.
+  void reapCompletions();
+
+  const int32_t queueDepth_;
+  io_uring ring_;
+
+  // Serializes submissions.
+  std::mutex mutex_;
+  std::condition_variable queueSpace_;
+  int32_t numInFlight_{0};
+
+  std::vector<folly::Range<char*>> registeredBuffers_;
+  std::thread completionThread_;
+};
+
+/// ReadFile over a local file with native preadvAsync(). Reads are issued to
+/// an IoUring, so that one thread can keep many reads in flight.
+class IoUringReadFile final : public ReadFile {
+ public:
+  /// Opens 'path'. With 'oDirect' the file is opened with O_DIRECT and reads
+  /// bypass the page cache. Offsets, sizes and buffers of reads must then be
+  /// aligned to the block size of the device.
+  IoUringReadFile(
+      std::string_view path,
+      bool oDirect = false,
+      std::shared_ptr<IoUring> ring = IoUring::defaultInstance());
+
+  /// Reads from 'fd', which is not owned by 'this'.
+  explicit IoUringReadFile(
+      int32_t fd,
+      std::shared_ptr<IoUring> ring = IoUring::defaultInstance());
+
+  ~IoUringReadFile() override;
+
+  std::string_view
+  pread(uint64_t offset, uint64_t length, void* FOLLY_NONNULL buf) const final;
+
+  std::string pread(uint64_t offset, uint64_t length) const final;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return true;
+  }
+
+  bool shouldCoalesce() const final {
+    return false;
+  }
+
+  uint64_t size() const final;
+
+  uint64_t memoryUsage() const final {
+    return sizeof(*this);
+  }
+
+  IoUring& ring() const {
+    return *ring_;
+  }
+
+ private:
+  const std::shared_ptr<IoUring> ring_;
+  int32_t fd_;
+  const bool ownsFd_;
+  mutable int64_t size_{-1};
+};
+
+} // namespace facebook::velox
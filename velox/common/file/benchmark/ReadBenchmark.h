@@ -29,8 +29,12 @@
 #include <folly/portability/SysUio.h>
 #include <gflags/gflags.h>
 
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#ifdef VELOX_ENABLE_IO_URING
+#include "velox/common/file/IoUringFile.h"
+#endif
 #include "velox/common/time/Timer.h"
 
 DECLARE_string(path);
@@ -273,6 +277,59 @@ class ReadBenchmark {
               << std::endl;
   }
 
+#ifdef VELOX_ENABLE_IO_URING
+  // Measures the throughput of the same reads as randomReads() in Pread mode
+  // from a single thread that keeps up to 'queueDepth' reads in flight on an
+  // io_uring. Each read goes to its own slot of a registered buffer.
+  void ioUringReads(
+      int32_t size,
+      int32_t gap,
+      int32_t count,
+      int32_t repeats,
+      int32_t queueDepth) {
+    clearCache();
+    const int32_t rangeSize = size * count + gap * (count - 1);
+    auto ring = std::make_shared<IoUring>(queueDepth);
+    IoUringReadFile file(FLAGS_path, FLAGS_odirect, ring);
+    // Aligned for O_DIRECT.
+    const uint64_t slotSize = bits::roundUp(rangeSize, 4096);
+    std::unique_ptr<char, decltype(&free)> buffer(
+        static_cast<char*>(aligned_alloc(4096, slotSize * queueDepth)), free);
+    ring->registerBuffers(
+        {folly::Range<char*>(buffer.get(), slotSize * queueDepth)});
+    std::vector<folly::SemiFuture<uint64_t>> inFlight;
+    uint64_t usec = 0;
+    {
+      MicrosecondTimer timer(&usec);
+      for (auto repeat = 0; repeat < repeats; ++repeat) {
+        const auto slot = repeat % queueDepth;
+        if (repeat >= queueDepth) {
+          std::move(inFlight[slot]).get();
+        }
+        int64_t offset = folly::Random::rand64(rng_) % (fileSize_ - rangeSize);
+        auto future = file.preadvAsync(
+            offset,
+            {folly::Range<char*>(buffer.get() + slot * slotSize, rangeSize)});
+        if (repeat < queueDepth) {
+          inFlight.push_back(std::move(future));
+        } else {
+          inFlight[slot] = std::move(future);
+        }
+      }
+      for (auto& future : inFlight) {
+        if (future.valid()) {
+          std::move(future).get();
+        }
+      }
+    }
+    std::cout << fmt::format(
+                     "{} MB/s io_uring qd {}",
+                     (static_cast<float>(count) * size * repeats) / usec,
+                     queueDepth)
+              << std::endl;
+  }
+#endif
+
   void modes(int32_t size, int32_t gap, int32_t count) {
     int repeats =
         std::max<int32_t>(3, (FLAGS_measurement_size) / (size * count));
@@ -289,6 +346,11 @@ class ReadBenchmark {
     randomReads(size, gap, count, repeats, Mode::Pread, true);
     randomReads(size, gap, count, repeats, Mode::Preadv, true);
     randomReads(size, gap, count, repeats, Mode::Multiple, true);
+#ifdef VELOX_ENABLE_IO_URING
+    for (auto queueDepth : {1, 8, 32, 128}) {
+      ioUringReads(size, gap, count, repeats, queueDepth);
+    }
+#endif
   }
 
   void run();
@@ -261,6 +261,26 @@ class HashStringAllocator : public StreamArena {
     return minFree;
   }
 
+  // Returns the sum of the sizes of the blocks in the free list, including
+  // their headers.
+  uint64_t freeBytes() const {
+    return freeBytes_;
+  }
+
+  // Returns the number of blocks in the free list.
+  uint64_t numFreeBlocks() const {
+    return numFree_;
+  }
+
+  // Returns the bytes in blocks that are not free, including their headers.
+  // retainedSize() - usedBytes() is the memory held by 'this' that is not in
+  // use. Freed blocks are only reused for allocations that fit them, so a
+  // large difference indicates fragmentation.
+  uint64_t usedBytes() const {
+    uint64_t retained = retainedSize();
+    return retained > freeBytes_ ? retained - freeBytes_ : 0;
+  }
+
   // Frees all memory associated with 'this' and leaves 'this' ready for reuse.
   void clear() {
     numFree_ = 0;
@@ -326,7 +346,7 @@ class HashStringAllocator : public StreamArena {
   // Count of elements in 'free_'. This is 0 when free_.next() == &free_.
   uint64_t numFree_ = 0;
 
-  // Sum of the size of blocks in 'free_', excluding headers.
+  // Sum of the size of blocks in 'free_', including headers.
   uint64_t freeBytes_ = 0;
 
   // Counter of allocated bytes. The difference of two point in time values
@@ -107,6 +107,45 @@ TEST_F(HashStringAllocatorTest, allocate) {
   EXPECT_LE(instance_->retainedSize() - instance_->freeSpace(), 200);
 }
 
+TEST_F(HashStringAllocatorTest, usedBytes) {
+  EXPECT_EQ(0, instance_->usedBytes());
+  std::vector<HashStringAllocator::Header*> headers;
+  uint64_t expectedUsed = 0;
+  for (auto i = 0; i < 10'000; ++i) {
+    headers.push_back(allocate(100));
+    expectedUsed +=
+        headers.back()->size() + sizeof(HashStringAllocator::Header);
+  }
+  auto retained = instance_->retainedSize();
+  // usedBytes() also counts the end markers of the slabs.
+  EXPECT_LE(expectedUsed, instance_->usedBytes());
+  EXPECT_EQ(retained - instance_->freeBytes(), instance_->usedBytes());
+
+  // Freeing every other block fragments the memory: The footprint stays the
+  // same and the freed blocks can not be coalesced.
+  auto usedBefore = instance_->usedBytes();
+  uint64_t freed = 0;
+  for (auto i = 0; i < headers.size(); i += 2) {
+    freed += headers[i]->size() + sizeof(HashStringAllocator::Header);
+    instance_->free(headers[i]);
+    headers[i] = nullptr;
+  }
+  instance_->checkConsistency();
+  EXPECT_EQ(retained, instance_->retainedSize());
+  EXPECT_EQ(usedBefore - freed, instance_->usedBytes());
+  EXPECT_LE(headers.size() / 2, instance_->numFreeBlocks());
+
+  for (auto* header : headers) {
+    if (header) {
+      instance_->free(header);
+    }
+  }
+  EXPECT_LE(instance_->usedBytes(), 200);
+  instance_->clear();
+  EXPECT_EQ(0, instance_->usedBytes());
+  EXPECT_EQ(0, instance_->numFreeBlocks());
+}
+
 TEST_F(HashStringAllocatorTest, multipart) {
   constexpr int32_t kNumSamples = 10'000;
   std::vector<Multipart> data(kNumSamples);
@@ -100,6 +100,16 @@ class DataSource {
   // processed.
   virtual void addSplit(std::shared_ptr<ConnectorSplit> split) = 0;
 
+  // Returns true if preloadSplit() does work ahead of addSplit().
+  virtual bool supportsSplitPreload() {
+    return false;
+  }
+
+  // Starts work for 'split' in the background, e.g. opening its file and
+  // reading its metadata, so that a later addSplit() for the same split does
+  // not wait for this. May be called while another split is being processed.
+  virtual void preloadSplit(const std::shared_ptr<ConnectorSplit>& /*split*/) {}
+
   // Process a split added via addSplit. Returns nullptr if split has been fully
   // processed.
   virtual RowVectorPtr next(uint64_t size) = 0;
@@ -21,6 +21,19 @@
 
 namespace facebook::velox {
 
+bool FileFooterStats::hasStripesInRange(uint64_t offset, uint64_t length)
+    const {
+  if (!stripeOffsets.has_value()) {
+    return true;
+  }
+  for (auto stripeOffset : stripeOffsets.value()) {
+    if (stripeOffset >= offset && stripeOffset - offset < length) {
+      return true;
+    }
+  }
+  return false;
+}
+
 uint64_t FileHandleSizer::operator()(const FileHandle& fileHandle) {
   // TODO: remember to add in the size of the hash map and its contents
   // when we add it later.
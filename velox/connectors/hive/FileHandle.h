@@ -28,15 +28,47 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
+
+#include <folly/Synchronized.h>
 
 #include "velox/common/caching/CachedFactory.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/File.h"
 #include "velox/core/Context.h"
 #include "velox/dwio/common/InputStream.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/type/Type.h"
 
 namespace facebook::velox {
 
+// Summary of a file footer that is sufficient to decide whether a split of the
+// file can be skipped for a set of filters without opening a reader. Footers
+// are immutable, so the summary is captured by the first reader of a file and
+// shared by later splits and queries through the FileHandle cache.
+struct FileFooterStats {
+  // Number of rows in the file. std::nullopt if the footer does not say.
+  std::optional<uint64_t> numRows;
+
+  RowTypePtr rowType;
+
+  // Statistics of the top level columns keyed on column name. Columns without
+  // statistics are absent.
+  std::unordered_map<
+      std::string,
+      std::shared_ptr<dwio::common::ColumnStatistics>>
+      columnStats;
+
+  // Byte offsets of the stripes in the file. std::nullopt if the format does
+  // not expose stripe placement.
+  std::optional<std::vector<uint64_t>> stripeOffsets;
+
+  // Returns true if at least one stripe starts in [offset, offset + length),
+  // i.e. a split with this range has rows to read. True if stripe placement is
+  // unknown.
+  bool hasStripesInRange(uint64_t offset, uint64_t length) const;
+};
+
 // See the file comment.
 struct FileHandle {
   std::unique_ptr<ReadFile> file;
@@ -51,6 +83,10 @@ struct FileHandle {
   // example to decide placing on SSD.
   StringIdLease groupId;
 
+  // Footer summary of the file. nullptr until the first reader of the file
+  // has read the footer.
+  folly::Synchronized<std::shared_ptr<const FileFooterStats>> footerStats;
+
   // We'll want to have a hash map here to record the identifier->byte range
   // mappings. Different formats may have different identifiers, so we may need
   // a union of maps. For example in orc you need 3 integers (I think, to be
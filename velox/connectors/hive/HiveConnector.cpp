@@ -196,7 +196,9 @@ HiveDataSource::HiveDataSource(
     ExpressionEvaluator* expressionEvaluator,
     memory::MappedMemory* mappedMemory,
     const std::string& scanId,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    bool zeroCopyStrings,
+    int32_t decodedCachePct)
     : outputType_(outputType),
       fileHandleFactory_(fileHandleFactory),
       pool_(pool),
@@ -274,6 +276,14 @@ HiveDataSource::HiveDataSource(
   }
 
   rowReaderOpts_.setScanSpec(scanSpec_.get());
+  rowReaderOpts_.setZeroCopyStrings(zeroCopyStrings);
+
+  auto asyncCache = dynamic_cast<cache::AsyncDataCache*>(mappedMemory_);
+  if (asyncCache && decodedCachePct > 0) {
+    VELOX_CHECK_LE(decodedCachePct, 100);
+    asyncCache->enableDecodedCache(
+        asyncCache->maxBytes() * decodedCachePct / 100);
+  }
 
   ioStats_ = std::make_shared<dwio::common::IoStatistics>();
 }
@@ -281,11 +291,9 @@ HiveDataSource::HiveDataSource(
 namespace {
 bool testFilters(
     common::ScanSpec* scanSpec,
-    dwio::common::Reader* reader,
+    const FileFooterStats& footerStats,
     const std::string& filePath) {
-  auto totalRows = reader->numberOfRows();
-  const auto& fileTypeWithId = reader->typeWithId();
-  const auto& rowType = reader->rowType();
+  const auto& rowType = footerStats.rowType;
   for (const auto& child : scanSpec->children()) {
     if (child->filter()) {
       const auto& name = child->fieldName();
@@ -296,13 +304,16 @@ bool testFilters(
           return false;
         }
       } else {
-        const auto& typeWithId = fileTypeWithId->childByName(name);
-        auto columnStats = reader->columnStatistics(typeWithId->id);
+        auto it = footerStats.columnStats.find(name);
+        if (it == footerStats.columnStats.end() ||
+            !footerStats.numRows.has_value()) {
+          continue;
+        }
         if (!testFilter(
                 child->filter(),
-                columnStats.get(),
-                totalRows.value(),
-                typeWithId->type)) {
+                it->second.get(),
+                footerStats.numRows.value(),
+                rowType->findChild(name))) {
           VLOG(1) << "Skipping " << filePath
                   << " based on stats and filter for column "
                   << child->fieldName();
@@ -315,6 +326,32 @@ bool testFilters(
   return true;
 }
 
+// Captures the parts of the footer of 'reader' needed for deciding whether
+// splits can be skipped.
+std::shared_ptr<const FileFooterStats> makeFooterStats(
+    const dwio::common::Reader& reader) {
+  auto stats = std::make_shared<FileFooterStats>();
+  stats->numRows = reader.numberOfRows();
+  stats->rowType = reader.rowType();
+  const auto& fileTypeWithId = reader.typeWithId();
+  for (auto i = 0; i < stats->rowType->size(); ++i) {
+    auto columnStats = reader.columnStatistics(fileTypeWithId->childAt(i)->id);
+    if (columnStats) {
+      stats->columnStats[stats->rowType->nameOf(i)] = std::move(columnStats);
+    }
+  }
+  if (auto dwrfReader = dynamic_cast<const DwrfReader*>(&reader)) {
+    const auto& footer = dwrfReader->getFooter();
+    std::vector<uint64_t> offsets;
+    offsets.reserve(footer.stripes_size());
+    for (auto i = 0; i < footer.stripes_size(); ++i) {
+      offsets.push_back(footer.stripes(i).offset());
+    }
+    stats->stripeOffsets = std::move(offsets);
+  }
+  return stats;
+}
+
 class InputStreamHolder : public dwrf::AbstractInputStreamHolder {
  public:
   InputStreamHolder(
@@ -382,38 +419,6 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
 
   VLOG(1) << "Adding split " << split_->toString();
 
-  fileHandle_ = fileHandleFactory_->generate(split_->filePath);
-  // For DataCache and no cache, the stream keeps track of IO.
-  auto asyncCache = dynamic_cast<cache::AsyncDataCache*>(mappedMemory_);
-  // Decide between AsyncDataCache, legacy DataCache and no cache. All
-  // three are supported to enable comparison.
-  if (asyncCache) {
-    VELOX_CHECK(
-        !dataCache_,
-        "DataCache should not be present if the MappedMemory is AsyncDataCache");
-    // Make DataCacheConfig to pass the filenum and a null DataCache.
-    if (!readerOpts_.getDataCacheConfig()) {
-      auto dataCacheConfig = std::make_shared<dwio::common::DataCacheConfig>();
-      readerOpts_.setDataCacheConfig(std::move(dataCacheConfig));
-    }
-    readerOpts_.getDataCacheConfig()->filenum = fileHandle_->uuid.id();
-    bufferedInputFactory_ = std::make_unique<dwrf::CachedBufferedInputFactory>(
-        (asyncCache),
-        Connector::getTracker(scanId_, readerOpts_.loadQuantum()),
-        fileHandle_->groupId.id(),
-        [factory = fileHandleFactory_, path = split_->filePath]() {
-          return makeStreamHolder(factory, path);
-        },
-        ioStats_,
-        executor_,
-        readerOpts_);
-    readerOpts_.setBufferedInputFactory(bufferedInputFactory_.get());
-  } else if (dataCache_) {
-    auto dataCacheConfig = std::make_shared<dwio::common::DataCacheConfig>();
-    dataCacheConfig->cache = dataCache_;
-    dataCacheConfig->filenum = fileHandle_->uuid.id();
-    readerOpts_.setDataCacheConfig(std::move(dataCacheConfig));
-  }
   if (readerOpts_.getFileFormat() != dwio::common::FileFormat::UNKNOWN) {
     VELOX_CHECK(
         readerOpts_.getFileFormat() == split_->fileFormat,
@@ -424,27 +429,33 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     readerOpts_.setFileFormat(split_->fileFormat);
   }
 
-  // We run with the default BufferedInputFactory and no DataCacheConfig if
-  // there is no DataCache and the MappedMemory is not an AsyncDataCache.
-  reader_ = dwio::common::getReaderFactory(readerOpts_.getFileFormat())
-                ->createReader(
-                    std::make_unique<dwio::common::ReadFileInputStream>(
-                        fileHandle_->file.get(),
-                        dwio::common::MetricsLog::voidLog(),
-                        asyncCache ? nullptr : ioStats_.get()),
-                    readerOpts_);
+  auto prepared = takePreloadedSplit(split.get());
+  fileHandle_ = prepared ? std::move(prepared->fileHandle)
+                         : fileHandleFactory_->generate(split_->filePath);
 
-  emptySplit_ = false;
-  if (reader_->numberOfRows() == 0) {
-    emptySplit_ = true;
+  // If the footer of the file has been seen before, decide whether the split
+  // can be skipped before any reader state is set up or any IO is done.
+  auto footerStats = *fileHandle_->footerStats.rlock();
+  if (footerStats && skipSplit(*footerStats)) {
+    ++numSplitsSkippedWithoutRead_;
     return;
   }
 
-  // Check filters and see if the whole split can be skipped
-  if (!testFilters(scanSpec_.get(), reader_.get(), split_->filePath)) {
-    emptySplit_ = true;
-    ++runtimeStats_.skippedSplits;
-    runtimeStats_.skippedSplitBytes += split_->length;
+  if (!prepared) {
+    prepared = prepareSplit(*split_, std::move(fileHandle_), readerOpts_);
+    fileHandle_ = std::move(prepared->fileHandle);
+  }
+  // 'reader_' references the BufferedInputFactory and DataCacheConfig of
+  // 'prepared', so these are kept for the lifetime of the split.
+  reader_ = std::move(prepared->reader);
+  bufferedInputFactory_ = std::move(prepared->bufferedInputFactory);
+  dataCacheConfig_ = prepared->readerOpts.getDataCacheConfig();
+
+  if (!footerStats) {
+    footerStats = makeFooterStats(*reader_);
+    *fileHandle_->footerStats.wlock() = footerStats;
+  }
+  if (skipSplit(*footerStats)) {
     return;
   }
 
@@ -511,6 +522,128 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
       rowReaderOpts_.select(cs).range(split_->start, split_->length));
 }
 
+std::unique_ptr<HiveDataSource::PreparedSplit> HiveDataSource::prepareSplit(
+    const HiveConnectorSplit& split,
+    FileHandleCachedPtr fileHandle,
+    dwio::common::ReaderOptions readerOpts) const {
+  auto prepared = std::make_unique<PreparedSplit>();
+  prepared->fileHandle = std::move(fileHandle);
+  auto& handle = *prepared->fileHandle;
+  // For DataCache and no cache, the stream keeps track of IO.
+  auto asyncCache = dynamic_cast<cache::AsyncDataCache*>(mappedMemory_);
+  // Decide between AsyncDataCache, legacy DataCache and no cache. All
+  // three are supported to enable comparison.
+  if (asyncCache) {
+    VELOX_CHECK(
+        !dataCache_,
+        "DataCache should not be present if the MappedMemory is AsyncDataCache");
+    // Make DataCacheConfig to pass the filenum and a null DataCache. Each
+    // split gets its own since splits may be prepared concurrently.
+    auto dataCacheConfig = std::make_shared<dwio::common::DataCacheConfig>();
+    dataCacheConfig->filenum = handle.uuid.id();
+    readerOpts.setDataCacheConfig(std::move(dataCacheConfig));
+    prepared->bufferedInputFactory =
+        std::make_unique<dwrf::CachedBufferedInputFactory>(
+            (asyncCache),
+            Connector::getTracker(scanId_, readerOpts.loadQuantum()),
+            handle.groupId.id(),
+            [factory = fileHandleFactory_, path = split.filePath]() {
+              return makeStreamHolder(factory, path);
+            },
+            ioStats_,
+            executor_,
+            readerOpts);
+    readerOpts.setBufferedInputFactory(prepared->bufferedInputFactory.get());
+  } else if (dataCache_) {
+    auto dataCacheConfig = std::make_shared<dwio::common::DataCacheConfig>();
+    dataCacheConfig->cache = dataCache_;
+    dataCacheConfig->filenum = handle.uuid.id();
+    readerOpts.setDataCacheConfig(std::move(dataCacheConfig));
+  }
+  readerOpts.setFileFormat(split.fileFormat);
+
+  // We run with the default BufferedInputFactory and no DataCacheConfig if
+  // there is no DataCache and the MappedMemory is not an AsyncDataCache.
+  prepared->reader =
+      dwio::common::getReaderFactory(readerOpts.getFileFormat())
+          ->createReader(
+              std::make_unique<dwio::common::ReadFileInputStream>(
+                  handle.file.get(),
+                  dwio::common::MetricsLog::voidLog(),
+                  asyncCache ? nullptr : ioStats_.get()),
+              readerOpts);
+  prepared->readerOpts = std::move(readerOpts);
+  return prepared;
+}
+
+void HiveDataSource::preloadSplit(
+    const std::shared_ptr<ConnectorSplit>& split) {
+  auto hiveSplit = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
+  VELOX_CHECK(hiveSplit, "Wrong type of split");
+  if (!executor_) {
+    return;
+  }
+  // The options are copied here since 'readerOpts_' may change on the driver
+  // thread while the preload runs.
+  auto future = folly::via(
+                    executor_,
+                    [this, hiveSplit, readerOpts = readerOpts_]() {
+                      return prepareSplit(
+                          *hiveSplit,
+                          fileHandleFactory_->generate(hiveSplit->filePath),
+                          readerOpts);
+                    })
+                    .semi();
+  preloads_.push_back({hiveSplit, std::move(future)});
+}
+
+std::unique_ptr<HiveDataSource::PreparedSplit>
+HiveDataSource::takePreloadedSplit(const ConnectorSplit* split) {
+  auto it = std::find_if(
+      preloads_.begin(), preloads_.end(), [&](const auto& preload) {
+        return preload.split.get() == split;
+      });
+  if (it == preloads_.end()) {
+    return nullptr;
+  }
+  auto future = std::move(it->future);
+  preloads_.erase(it);
+  // A failed preload is retried synchronously so that any error is raised
+  // from addSplit() as without preloading.
+  auto result = std::move(future).getTry();
+  if (result.hasException()) {
+    VLOG(1) << "Split preload failed: " << result.exception().what();
+    return nullptr;
+  }
+  ++numPreloadedSplits_;
+  return std::move(result.value());
+}
+
+HiveDataSource::~HiveDataSource() {
+  // Preloads reference 'this' and must finish before it is destroyed.
+  for (auto& preload : preloads_) {
+    preload.future.wait();
+  }
+}
+
+bool HiveDataSource::skipSplit(const FileFooterStats& footerStats) {
+  emptySplit_ = false;
+  if (footerStats.numRows == 0 ||
+      !footerStats.hasStripesInRange(split_->start, split_->length)) {
+    emptySplit_ = true;
+    return true;
+  }
+
+  // Check filters and see if the whole split can be skipped
+  if (!testFilters(scanSpec_.get(), footerStats, split_->filePath)) {
+    emptySplit_ = true;
+    ++runtimeStats_.skippedSplits;
+    runtimeStats_.skippedSplitBytes += split_->length;
+    return true;
+  }
+  return false;
+}
+
 RowVectorPtr HiveDataSource::next(uint64_t size) {
   VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
   if (emptySplit_) {
@@ -635,7 +768,10 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
        {"numRamRead", RuntimeCounter(ioStats_->ramHit().count())},
        {"ramReadBytes",
         RuntimeCounter(
-            ioStats_->ramHit().bytes(), RuntimeCounter::Unit::kBytes)}});
+            ioStats_->ramHit().bytes(), RuntimeCounter::Unit::kBytes)},
+       {"skippedSplitsWithoutRead",
+        RuntimeCounter(numSplitsSkippedWithoutRead_)},
+       {"preloadedSplits", RuntimeCounter(numPreloadedSplits_)}});
   return res;
 }
 
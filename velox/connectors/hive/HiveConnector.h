@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/futures/Future.h>
+
 #include "velox/common/caching/DataCache.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
@@ -141,10 +143,20 @@ class HiveDataSource : public DataSource {
       ExpressionEvaluator* FOLLY_NONNULL expressionEvaluator,
       memory::MappedMemory* FOLLY_NONNULL mappedMemory,
       const std::string& scanId,
-      folly::Executor* FOLLY_NULLABLE executor);
+      folly::Executor* FOLLY_NULLABLE executor,
+      bool zeroCopyStrings = false,
+      int32_t decodedCachePct = 0);
+
+  ~HiveDataSource() override;
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
+  bool supportsSplitPreload() override {
+    return executor_ != nullptr;
+  }
+
+  void preloadSplit(const std::shared_ptr<ConnectorSplit>& split) override;
+
   void addDynamicFilter(
       ChannelIndex outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
@@ -183,9 +195,36 @@ class HiveDataSource : public DataSource {
       const std::string& partitionKey,
       const std::optional<std::string>& value) const;
 
+  // Sets emptySplit_ and returns true if split_ has no rows or cannot pass the
+  // filters according to the footer of its file.
+  bool skipSplit(const FileFooterStats& footerStats);
+
   /// Clear split_, reader_ and rowReader_ after split has been fully processed.
   void resetSplit();
 
+  // A split with its file opened and its reader created, i.e. the footer
+  // read. Made on the driver thread in addSplit() or on 'executor_' by
+  // preloadSplit().
+  struct PreparedSplit {
+    FileHandleCachedPtr fileHandle;
+    // Options for 'reader'. These own the DataCacheConfig of 'reader'.
+    dwio::common::ReaderOptions readerOpts;
+    std::unique_ptr<dwrf::BufferedInputFactory> bufferedInputFactory;
+    std::unique_ptr<dwio::common::Reader> reader;
+  };
+
+  // Creates the reader for 'split' in 'fileHandle'. Does not access mutable
+  // members, so that this can run concurrently with the current split.
+  std::unique_ptr<PreparedSplit> prepareSplit(
+      const HiveConnectorSplit& split,
+      FileHandleCachedPtr fileHandle,
+      dwio::common::ReaderOptions readerOpts) const;
+
+  // Returns the result of preloadSplit() for 'split', waiting for it if not
+  // ready. Returns nullptr if 'split' was not preloaded or the preload failed.
+  std::unique_ptr<PreparedSplit> takePreloadedSplit(
+      const ConnectorSplit* FOLLY_NONNULL split);
+
   const std::shared_ptr<const RowType> outputType_;
   // Column handles for the partition key columns keyed on partition key column
   // name.
@@ -213,6 +252,23 @@ class HiveDataSource : public DataSource {
   ExpressionEvaluator* FOLLY_NONNULL expressionEvaluator_;
   uint64_t completedRows_ = 0;
 
+  // Number of splits skipped using a cached footer, without opening a reader.
+  uint64_t numSplitsSkippedWithoutRead_{0};
+
+  // DataCacheConfig referenced by 'reader_'.
+  std::shared_ptr<dwio::common::DataCacheConfig> dataCacheConfig_;
+
+  struct SplitPreload {
+    std::shared_ptr<HiveConnectorSplit> split;
+    folly::SemiFuture<std::unique_ptr<PreparedSplit>> future;
+  };
+
+  // Splits given to preloadSplit() and not yet added, in order of arrival.
+  std::deque<SplitPreload> preloads_;
+
+  // Number of added splits whose reader was created by preloadSplit().
+  uint64_t numPreloadedSplits_{0};
+
   // Reusable memory for remaining filter evaluation
   VectorPtr filterResult_;
   SelectivityVector filterRows_;
@@ -252,7 +308,9 @@ class HiveConnector final : public Connector {
         connectorQueryCtx->expressionEvaluator(),
         connectorQueryCtx->mappedMemory(),
         connectorQueryCtx->scanId(),
-        executor_);
+        executor_,
+        connectorQueryCtx->config()->get<bool>(kZeroCopyStrings, false),
+        connectorQueryCtx->config()->get<int32_t>(kDecodedCachePct, 0));
   }
 
   std::shared_ptr<DataSink> createDataSink(
@@ -285,6 +343,16 @@ class HiveConnector final : public Connector {
       kNodeSelectionStrategyNoPreference = "NO_PREFERENCE";
   static constexpr const char* FOLLY_NONNULL
       kNodeSelectionStrategySoftAffinity = "SOFT_AFFINITY";
+  // If true, string columns reference the cached file data instead of
+  // copying it. See RowReaderOptions::setZeroCopyStrings().
+  static constexpr const char* FOLLY_NONNULL kZeroCopyStrings =
+      "zero_copy_strings";
+  // Percentage of the capacity of the AsyncDataCache to use for decoded data,
+  // e.g. stripe dictionaries. If over 0, the first scan that runs with this
+  // adds the tier to the cache, see AsyncDataCache::enableDecodedCache().
+  // The tier is then shared by all scans using the cache.
+  static constexpr const char* FOLLY_NONNULL kDecodedCachePct =
+      "decoded_cache_pct";
 };
 
 class HiveConnectorFactory : public ConnectorFactory {
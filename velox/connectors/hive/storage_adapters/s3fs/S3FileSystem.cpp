@@ -15,12 +15,17 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/CoalesceIo.h"
 #include "velox/common/file/File.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/core/Context.h"
 
 #include <fmt/format.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <limits>
 #include <memory>
 #include <stdexcept>
 
@@ -59,10 +64,28 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
   return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
 }
 
+// Tuning of S3ReadFile::preadvAsync().
+struct S3ReadOptions {
+  // Ranges closer than this are read with a single GET and the bytes in
+  // between are dropped. A GET costs about as much time as transferring 1MB.
+  int32_t maxCoalesceDistance{1 << 20};
+
+  // Largest size of a single ranged GET. Longer reads are split into parts
+  // that are fetched concurrently.
+  uint64_t maxPartSize{8 << 20};
+
+  // Number of threads of the executor that runs the GETs.
+  int32_t maxConcurrency{16};
+};
+
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      folly::Executor* executor,
+      const S3ReadOptions& options)
+      : client_(client), executor_(executor), options_(options) {
     bucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
@@ -87,41 +110,97 @@ class S3ReadFile final : public ReadFile {
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buffer)
       const override {
-    preadInternal(offset, length, static_cast<char*>(buffer));
+    preadv(offset, {folly::Range<char*>(static_cast<char*>(buffer), length)});
     return {static_cast<char*>(buffer), length};
   }
 
   std::string pread(uint64_t offset, uint64_t length) const override {
     std::string result(length, 0);
-    char* position = result.data();
-    preadInternal(offset, length, position);
+    pread(offset, length, result.data());
     return result;
   }
 
   uint64_t preadv(
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const override {
-    // 'buffers' contains Ranges(data, size)  with some gaps (data = nullptr) in
-    // between. This call must populate the ranges (except gap ranges)
-    // sequentially starting from 'offset'. AWS S3 GetObject does not support
-    // multi-range. AWS S3 also charges by number of read requests and not size.
-    // The idea here is to use a single read spanning all the ranges and then
-    // populate individual ranges. We pre-allocate a buffer to support this.
-    size_t length = 0;
-    for (const auto range : buffers) {
+    return preadvAsync(offset, buffers).get();
+  }
+
+  // 'buffers' contains Ranges(data, size) with some gaps (data = nullptr) in
+  // between. AWS S3 GetObject does not support multi-range and S3 charges by
+  // number of requests, not size. Ranges separated by gaps shorter than
+  // 'maxCoalesceDistance' are read with one GET and the gaps are dropped.
+  // Each such GET is split into parts that are fetched in parallel on
+  // 'executor_'.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    // The ranges to fill and their offsets in the file.
+    std::vector<std::pair<uint64_t, folly::Range<char*>>> targets;
+    uint64_t length = 0;
+    for (auto range : buffers) {
+      if (range.data() && range.size()) {
+        targets.emplace_back(offset + length, range);
+      }
       length += range.size();
     }
-    // TODO: allocate from a memory pool
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
+    if (targets.empty()) {
+      return folly::makeSemiFuture<uint64_t>(length);
+    }
+    bytesRead_ += length;
+
+    // Coalesces the ranges into GETs. The gaps in a GET are nullptr ranges.
+    std::vector<std::pair<uint64_t, std::vector<folly::Range<char*>>>> gets;
+    coalesceIo<std::pair<uint64_t, folly::Range<char*>>, folly::Range<char*>>(
+        targets,
+        options_.maxCoalesceDistance,
+        std::numeric_limits<int32_t>::max(),
+        [&](int32_t index) { return targets[index].first; },
+        [&](int32_t index) { return targets[index].second.size(); },
+        [&](int32_t /*index*/) { return 1; },
+        [&](const auto& target, std::vector<folly::Range<char*>>& ranges) {
+          ranges.push_back(target.second);
+        },
+        [&](int32_t gap, std::vector<folly::Range<char*>>& ranges) {
+          ranges.push_back(folly::Range<char*>(nullptr, gap));
+        },
+        [&](const auto& /*targets*/,
+            int32_t /*begin*/,
+            int32_t /*end*/,
+            uint64_t getOffset,
+            const std::vector<folly::Range<char*>>& ranges) {
+          gets.emplace_back(getOffset, ranges);
+        });
+
+    std::vector<folly::SemiFuture<folly::Unit>> parts;
+    for (auto& [getOffset, ranges] : gets) {
+      uint64_t getLength = 0;
+      for (auto range : ranges) {
+        getLength += range.size();
+      }
+      const auto partSize = adaptivePartSize(getLength);
+      for (uint64_t partOffset = 0; partOffset < getLength;
+           partOffset += partSize) {
+        parts.push_back(readPart(
+            getOffset,
+            ranges,
+            partOffset,
+            std::min(partSize, getLength - partOffset)));
       }
-      resultOffset += range.size();
     }
-    return length;
+    // Completes only after all parts, so that no part writes into
+    // 'buffers' after a failure of another part is reported.
+    return folly::collectAll(std::move(parts))
+        .deferValue([length](auto&& results) {
+          for (auto& result : results) {
+            result.throwIfFailed();
+          }
+          return length;
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return true;
   }
 
   uint64_t size() const override {
@@ -139,9 +218,62 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
+  // Smallest part a GET is split into unless 'maxPartSize' is smaller.
+  static constexpr uint64_t kMinPartSize = 1 << 20;
+
+  // Returns the part size for a GET of 'length' bytes. Splits the GET so
+  // that all threads of 'executor_' can work on it, but not into parts so
+  // small that the latency of the extra requests dominates.
+  uint64_t adaptivePartSize(uint64_t length) const {
+    const auto minPartSize = std::min(kMinPartSize, options_.maxPartSize);
+    const auto perThread =
+        bits::roundUp(length / options_.maxConcurrency, 64 << 10);
+    return std::max(minPartSize, std::min(options_.maxPartSize, perThread));
+  }
+
+  // Reads 'partLength' bytes at 'partOffset' of the GET of 'ranges' at
+  // 'getOffset' on 'executor_'. If the part falls in a single target range,
+  // the part is read in place. Otherwise it is read into a temporary buffer
+  // and copied to the ranges it overlaps.
+  folly::SemiFuture<folly::Unit> readPart(
+      uint64_t getOffset,
+      const std::vector<folly::Range<char*>>& ranges,
+      uint64_t partOffset,
+      uint64_t partLength) const {
+    // The pieces of target ranges in the part, as offsets in the part.
+    std::vector<std::pair<uint64_t, folly::Range<char*>>> pieces;
+    uint64_t rangeOffset = 0;
+    for (auto range : ranges) {
+      const auto begin = std::max(rangeOffset, partOffset);
+      const auto end =
+          std::min(rangeOffset + range.size(), partOffset + partLength);
+      if (range.data() && begin < end) {
+        pieces.emplace_back(
+            begin - partOffset,
+            folly::Range<char*>(
+                range.data() + (begin - rangeOffset), end - begin));
+      }
+      rangeOffset += range.size();
+    }
+    const uint64_t fileOffset = getOffset + partOffset;
+    auto read = [this, fileOffset, partLength, pieces = std::move(pieces)]() {
+      if (pieces.size() == 1 && pieces[0].second.size() == partLength) {
+        getObject(fileOffset, partLength, pieces[0].second.data());
+        return;
+      }
+      // TODO: allocate from a memory pool
+      std::string buffer(partLength, 0);
+      getObject(fileOffset, partLength, buffer.data());
+      for (auto& [pieceOffset, piece] : pieces) {
+        memcpy(piece.data(), buffer.data() + pieceOffset, piece.size());
+      }
+    };
+    return folly::via(executor_, std::move(read)).semi();
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
-  void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+  void getObject(uint64_t offset, uint64_t length, char* position) const {
     // Read the desired range of bytes.
     Aws::S3::Model::GetObjectRequest request;
     Aws::S3::Model::GetObjectResult result;
@@ -158,6 +290,8 @@ class S3ReadFile final : public ReadFile {
   }
 
   Aws::S3::S3Client* client_;
+  folly::Executor* executor_;
+  const S3ReadOptions options_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -214,6 +348,19 @@ class S3Config {
         "hive.s3.iam-role-session-name", std::string("velox-session"));
   }
 
+  S3ReadOptions readOptions() const {
+    S3ReadOptions options;
+    options.maxCoalesceDistance = config_->get<int32_t>(
+        "hive.s3.max-coalesce-distance", options.maxCoalesceDistance);
+    options.maxPartSize =
+        config_->get<uint64_t>("hive.s3.read-part-size", options.maxPartSize);
+    options.maxConcurrency = config_->get<int32_t>(
+        "hive.s3.max-read-concurrency", options.maxConcurrency);
+    VELOX_USER_CHECK_GT(options.maxPartSize, 0);
+    VELOX_USER_CHECK_GT(options.maxConcurrency, 0);
+    return options;
+  }
+
  private:
   const Config* FOLLY_NONNULL config_;
 };
@@ -313,6 +460,12 @@ class S3FileSystem::Impl {
       clientConfig.scheme = Aws::Http::Scheme::HTTP;
     }
 
+    readOptions_ = s3Config_.readOptions();
+    // The SDK's default of 25 connections would make the GETs beyond that
+    // wait for a connection.
+    clientConfig.maxConnections = std::max<int32_t>(
+        clientConfig.maxConnections, readOptions_.maxConcurrency);
+
     auto credentialsProvider = getCredentialsProvider();
 
     client_ = std::make_shared<Aws::S3::S3Client>(
@@ -320,6 +473,8 @@ class S3FileSystem::Impl {
         clientConfig,
         Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
         s3Config_.useVirtualAddressing());
+    executor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+        readOptions_.maxConcurrency);
   }
 
   // Make it clear that the S3FileSystem instance owns the S3Client.
@@ -329,9 +484,20 @@ class S3FileSystem::Impl {
     return client_.get();
   }
 
+  // Runs the ranged GETs of all files of 'this'.
+  folly::Executor* executor() const {
+    return executor_.get();
+  }
+
+  const S3ReadOptions& readOptions() const {
+    return readOptions_;
+  }
+
  private:
   const S3Config s3Config_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  S3ReadOptions readOptions_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
   static std::atomic<size_t> initCounter_;
 };
 
@@ -349,7 +515,8 @@ void S3FileSystem::initializeClient() {
 
 std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(std::string_view path) {
   const std::string file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      file, impl_->s3Client(), impl_->executor(), impl_->readOptions());
   s3file->initialize();
   return s3file;
 }
@@ -15,11 +15,22 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/s3fs/benchmark/S3ReadBenchmark.h"
+#include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
+#include "velox/connectors/hive/storage_adapters/s3fs/tests/MinioServer.h"
 #include "velox/core/Context.h"
 
 #include <fstream>
 
 DEFINE_string(s3_config, "", "Path of S3 config file");
+DEFINE_bool(
+    use_minio,
+    false,
+    "Read from a local MinIO server started by the benchmark instead of "
+    "--path. Requires the minio executable in PATH");
+DEFINE_int32(
+    minio_file_size_mb,
+    1024,
+    "Size of the file written to MinIO with --use_minio");
 
 namespace facebook::velox {
 
@@ -47,4 +58,25 @@ std::shared_ptr<Config> readConfig(const std::string& filePath) {
   return std::make_shared<facebook::velox::core::MemConfig>(properties);
 }
 
+std::shared_ptr<const Config> S3ReadBenchmark::startMinio() {
+  constexpr const char* kBucket = "velox-benchmark";
+  constexpr const char* kFile = "read-benchmark.bin";
+  minioServer_ = std::make_shared<MinioServer>();
+  minioServer_->start();
+  minioServer_->addBucket(kBucket);
+  {
+    LocalWriteFile writeFile(
+        minioServer_->path() + "/" + kBucket + "/" + kFile);
+    std::string data(1 << 20, 0);
+    for (auto i = 0; i < data.size(); ++i) {
+      data[i] = i * 31;
+    }
+    for (auto i = 0; i < FLAGS_minio_file_size_mb; ++i) {
+      writeFile.append(data);
+    }
+  }
+  FLAGS_path = s3URI(kBucket, kFile);
+  return minioServer_->hiveConfig();
+}
+
 } // namespace facebook::velox
@@ -18,6 +18,10 @@
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
 
 DECLARE_string(s3_config);
+DECLARE_bool(use_minio);
+DECLARE_int32(minio_file_size_mb);
+
+class MinioServer;
 
 namespace facebook::velox {
 
@@ -31,8 +35,10 @@ class S3ReadBenchmark : public ReadBenchmark {
         std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_threads);
 
     filesystems::registerS3FileSystem();
-    std::shared_ptr<Config> config;
-    if (!FLAGS_s3_config.empty()) {
+    std::shared_ptr<const Config> config;
+    if (FLAGS_use_minio) {
+      config = startMinio();
+    } else if (!FLAGS_s3_config.empty()) {
       config = readConfig(FLAGS_s3_config);
     }
     auto s3fs = filesystems::getFileSystem(FLAGS_path, config);
@@ -52,6 +58,14 @@ class S3ReadBenchmark : public ReadBenchmark {
       rng_.seed(FLAGS_seed);
     }
   }
+
+ private:
+  // Starts a local MinIO server as a stand-in for S3, writes a file of
+  // --minio_file_size_mb into it and points --path at the file. Returns the
+  // config for connecting to the server.
+  std::shared_ptr<const Config> startMinio();
+
+  std::shared_ptr<MinioServer> minioServer_;
 };
 
 } // namespace facebook::velox
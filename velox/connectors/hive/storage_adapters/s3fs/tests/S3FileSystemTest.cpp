@@ -152,6 +152,39 @@ TEST_F(S3FileSystemTest, fileHandle) {
   readData(fileHandle->file.get());
 }
 
+TEST_F(S3FileSystemTest, parallelRangedReads) {
+  const char* bucketName = "data4";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Small parts and coalescing distance so that the 1MB reads are split
+  // into parts and the gaps in readData() are not read.
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-part-size", "65536"},
+       {"hive.s3.max-coalesce-distance", "1000"},
+       {"hive.s3.max-read-concurrency", "4"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  s3fs.initializeClient();
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  readData(readFile.get());
+
+  char head[5];
+  char tail[5];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)(5 + kOneMB)),
+      folly::Range<char*>(tail, sizeof(tail))};
+  ASSERT_EQ(15 + kOneMB, readFile->preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaa");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ddddd");
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     const std::unordered_map<std::string, std::string> config(
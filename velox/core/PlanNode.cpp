@@ -67,7 +67,8 @@ AggregationNode::AggregationNode(
     const std::vector<std::shared_ptr<const FieldAccessTypedExpr>>&
         aggregateMasks,
     bool ignoreNullKeys,
-    PlanNodePtr source)
+    PlanNodePtr source,
+    const std::vector<bool>& distinctAggregates)
     : PlanNode(id),
       step_(step),
       groupingKeys_(groupingKeys),
@@ -75,6 +76,7 @@ AggregationNode::AggregationNode(
       aggregateNames_(aggregateNames),
       aggregates_(aggregates),
       aggregateMasks_(aggregateMasks),
+      distinctAggregates_(distinctAggregates),
       ignoreNullKeys_(ignoreNullKeys),
       sources_{source},
       outputType_(getAggregationOutputType(
@@ -88,6 +90,10 @@ AggregationNode::AggregationNode(
   VELOX_CHECK(
       !groupingKeys_.empty() || !aggregates_.empty(),
       "Aggregation must specify either grouping keys or aggregates");
+  VELOX_CHECK(
+      distinctAggregates_.empty() ||
+          distinctAggregates_.size() == aggregates_.size(),
+      "Aggregation must specify a distinct flag for each aggregate or none");
 
   std::unordered_set<std::string> groupingKeyNames;
   groupingKeyNames.reserve(groupingKeys.size());
@@ -130,7 +136,11 @@ void AggregationNode::addDetails(std::stringstream& stream) const {
     if (i > 0) {
       stream << ", ";
     }
-    stream << aggregateNames_[i] << " := " << aggregates_[i]->toString();
+    stream << aggregateNames_[i] << " := ";
+    if (isDistinctAggregate(i)) {
+      stream << "DISTINCT ";
+    }
+    stream << aggregates_[i]->toString();
   }
 }
 
@@ -338,6 +348,75 @@ void AssignUniqueIdNode::addDetails(std::stringstream& /* stream */) const {
   // Nothing to add.
 }
 
+GroupIdNode::GroupIdNode(
+    const PlanNodeId& id,
+    std::vector<std::vector<std::string>> groupingSets,
+    std::vector<GroupingKeyInfo> groupingKeyInfos,
+    std::vector<std::shared_ptr<const FieldAccessTypedExpr>> aggregationInputs,
+    std::string groupIdName,
+    PlanNodePtr source)
+    : PlanNode(id),
+      groupingSets_(std::move(groupingSets)),
+      groupingKeyInfos_(std::move(groupingKeyInfos)),
+      aggregationInputs_(std::move(aggregationInputs)),
+      groupIdName_(std::move(groupIdName)),
+      sources_{std::move(source)} {
+  VELOX_CHECK_GE(
+      groupingSets_.size(),
+      2,
+      "GroupIdNode requires two or more grouping sets.");
+
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::unordered_set<std::string> uniqueNames;
+  for (const auto& info : groupingKeyInfos_) {
+    names.push_back(info.output);
+    types.push_back(info.input->type());
+  }
+  for (const auto& input : aggregationInputs_) {
+    names.push_back(input->name());
+    types.push_back(input->type());
+  }
+  names.push_back(groupIdName_);
+  types.push_back(BIGINT());
+  for (const auto& name : names) {
+    VELOX_CHECK(
+        uniqueNames.insert(name).second,
+        "GroupIdNode output names must be unique: {}",
+        name);
+  }
+
+  for (const auto& groupingSet : groupingSets_) {
+    for (const auto& key : groupingSet) {
+      auto it = std::find_if(
+          groupingKeyInfos_.begin(),
+          groupingKeyInfos_.end(),
+          [&](const auto& info) { return info.output == key; });
+      VELOX_CHECK(
+          it != groupingKeyInfos_.end(),
+          "Grouping set refers to an unknown grouping key: {}",
+          key);
+    }
+  }
+  outputType_ = ROW(std::move(names), std::move(types));
+}
+
+void GroupIdNode::addDetails(std::stringstream& stream) const {
+  for (auto i = 0; i < groupingSets_.size(); ++i) {
+    if (i > 0) {
+      stream << ", ";
+    }
+    stream << "[";
+    for (auto j = 0; j < groupingSets_[i].size(); ++j) {
+      if (j > 0) {
+        stream << ", ";
+      }
+      stream << groupingSets_[i][j];
+    }
+    stream << "]";
+  }
+}
+
 namespace {
 void addSortingKeys(
     std::stringstream& stream,
@@ -454,6 +454,9 @@ class AggregationNode : public PlanNode {
    * @param ignoreNullKeys True if rows with at least one null key should be
    * ignored. Used when group by is a source of a join build side and grouping
    * keys are join keys.
+   * @param distinctAggregates Either empty or one flag per aggregate. If true,
+   * the aggregate only consumes the distinct values of its argument within
+   * each group, e.g. count(distinct a). Requires a single aggregation step.
    */
   AggregationNode(
       const PlanNodeId& id,
@@ -467,7 +470,8 @@ class AggregationNode : public PlanNode {
       const std::vector<std::shared_ptr<const FieldAccessTypedExpr>>&
           aggregateMasks,
       bool ignoreNullKeys,
-      PlanNodePtr source);
+      PlanNodePtr source,
+      const std::vector<bool>& distinctAggregates = {});
 
   const std::vector<PlanNodePtr>& sources() const override {
     return sources_;
@@ -504,6 +508,14 @@ class AggregationNode : public PlanNode {
     return aggregateMasks_;
   }
 
+  const std::vector<bool>& distinctAggregates() const {
+    return distinctAggregates_;
+  }
+
+  bool isDistinctAggregate(size_t i) const {
+    return !distinctAggregates_.empty() && distinctAggregates_[i];
+  }
+
   bool ignoreNullKeys() const {
     return ignoreNullKeys_;
   }
@@ -525,6 +537,9 @@ class AggregationNode : public PlanNode {
   // to a boolean projection column, used to mask out rows for the aggregation.
   const std::vector<std::shared_ptr<const FieldAccessTypedExpr>>
       aggregateMasks_;
+  // Empty or one flag per aggregation. A true flag means the aggregation
+  // consumes only the distinct values of its argument in each group.
+  const std::vector<bool> distinctAggregates_;
   const bool ignoreNullKeys_;
   const std::vector<PlanNodePtr> sources_;
   const RowTypePtr outputType_;
@@ -1392,4 +1407,81 @@ class AssignUniqueIdNode : public PlanNode {
   std::shared_ptr<std::atomic_int64_t> uniqueIdCounter_;
 };
 
+/// Replicates each input row once per grouping set and adds a column with the
+/// index of the grouping set. Grouping keys that are not part of a grouping
+/// set are set to null in the replica for that set. Used to compute GROUPING
+/// SETS, ROLLUP and CUBE with a single aggregation over the grouping keys and
+/// the group id column.
+///
+/// For example, ROLLUP(a, b) uses grouping sets [a, b], [a] and [].
+class GroupIdNode : public PlanNode {
+ public:
+  struct GroupingKeyInfo {
+    // Name of the grouping key in the output.
+    std::string output;
+    // Input column to take the grouping key from.
+    std::shared_ptr<const FieldAccessTypedExpr> input;
+  };
+
+  /// @param groupingSets A list of grouping sets. Each grouping set is a list
+  /// of output names of the grouping keys, see 'groupingKeyInfos'.
+  /// @param groupingKeyInfos The output names and input columns of all
+  /// grouping keys that appear in at least one grouping set.
+  /// @param aggregationInputs Input columns that are projected as is, e.g. the
+  /// arguments of the aggregates.
+  /// @param groupIdName Name of the BIGINT column with the zero-based index of
+  /// the grouping set each output row belongs to.
+  GroupIdNode(
+      const PlanNodeId& id,
+      std::vector<std::vector<std::string>> groupingSets,
+      std::vector<GroupingKeyInfo> groupingKeyInfos,
+      std::vector<std::shared_ptr<const FieldAccessTypedExpr>>
+          aggregationInputs,
+      std::string groupIdName,
+      PlanNodePtr source);
+
+  /// The order of columns in the output is: grouping keys (in the order of
+  /// 'groupingKeyInfos'), aggregation inputs (in the order specified), group
+  /// id column.
+  const RowTypePtr& outputType() const override {
+    return outputType_;
+  }
+
+  const std::vector<PlanNodePtr>& sources() const override {
+    return sources_;
+  }
+
+  const std::vector<std::vector<std::string>>& groupingSets() const {
+    return groupingSets_;
+  }
+
+  const std::vector<GroupingKeyInfo>& groupingKeyInfos() const {
+    return groupingKeyInfos_;
+  }
+
+  const std::vector<std::shared_ptr<const FieldAccessTypedExpr>>&
+  aggregationInputs() const {
+    return aggregationInputs_;
+  }
+
+  const std::string& groupIdName() const {
+    return groupIdName_;
+  }
+
+  std::string_view name() const override {
+    return "GroupId";
+  }
+
+ private:
+  void addDetails(std::stringstream& stream) const override;
+
+  const std::vector<std::vector<std::string>> groupingSets_;
+  const std::vector<GroupingKeyInfo> groupingKeyInfos_;
+  const std::vector<std::shared_ptr<const FieldAccessTypedExpr>>
+      aggregationInputs_;
+  const std::string groupIdName_;
+  const std::vector<PlanNodePtr> sources_;
+  RowTypePtr outputType_;
+};
+
 } // namespace facebook::velox::core
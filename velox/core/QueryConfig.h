@@ -71,6 +71,17 @@ class QueryConfig {
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
+  /// When a partial aggregation reaches kMaxPartialAggregationMemory and at
+  /// least this percentage of its memory was freed by variable width
+  /// accumulators that outgrew their allocation, the groups are compacted
+  /// into new memory instead of being flushed. The aggregation is then
+  /// flushed only if the compacted groups exceed the limit. Applies only to
+  /// aggregates whose input type is their intermediate type or that accept
+  /// their own intermediate results, e.g. array_agg and map_agg. 0 disables
+  /// compaction.
+  static constexpr const char* kPartialAggregationCompactionPct =
+      "partial_aggregation_compaction_pct";
+
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "driver.max-page-partitioning-buffer-size";
 
@@ -87,11 +98,55 @@ class QueryConfig {
 
   static constexpr const char* kCreateEmptyFiles = "driver.create_empty_files";
 
+  /// If true, a TableScan takes one split ahead of the split being read, so
+  /// that the connector can open its file in the background. Only one split
+  /// is taken so that the other drivers of the pipeline still find splits.
+  static constexpr const char* kSplitPreloadEnabled = "split_preload_enabled";
+
+  /// Memory usage of a TableScan above which no new splits are preloaded.
+  static constexpr const char* kMaxSplitPreloadMemory =
+      "max_split_preload_memory";
+
+  /// Number of hash bits used to partition the input of a final or single
+  /// hash aggregation. The input is buffered in 2^bits partitions, which are
+  /// aggregated one at a time after all input is received, so that the hash
+  /// table holds the groups of one partition. 0 aggregates the input as it
+  /// arrives.
+  ///
+  /// This trades memory for cache locality: The key, argument and mask
+  /// columns of all input rows plus 8 bytes per row are held until the last
+  /// partition is aggregated, while the hash table shrinks to the groups of
+  /// one partition. This pays off if there are so many groups that the hash
+  /// table does not fit in the CPU caches. Otherwise the buffered input takes
+  /// more memory than the smaller hash table saves.
+  static constexpr const char* kAggregationPartitionBits =
+      "aggregation_partition_bits";
+
+  /// If true, the drivers of a final hash aggregation may receive input for
+  /// any group, e.g. after a round robin local exchange. When all input is
+  /// received, each driver merges the groups of one hash partition from all
+  /// drivers. Global aggregations combine the accumulators of the drivers
+  /// pairwise in a tree. If false, a final aggregation with multiple drivers
+  /// must get its input partitioned on the grouping keys.
+  static constexpr const char* kParallelFinalAggregation =
+      "parallel_final_aggregation";
+
+  /// Name of the VectorSerde used for data exchanged between the tasks of a
+  /// query, see registerNamedVectorSerde(). PartitionedOutput and Exchange
+  /// both read this, so all tasks of the query agree on the wire format. Empty
+  /// selects the default serde.
+  static constexpr const char* kShuffleSerde = "shuffle_serde";
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
   }
 
+  int32_t partialAggregationCompactionPct() const {
+    static constexpr int32_t kDefault = 25;
+    return get<int32_t>(kPartialAggregationCompactionPct, kDefault);
+  }
+
   // Returns the target size for a Task's buffered output. The
   // producer Drivers are blocked when the buffered size exceeds
   // this. The Drivers are resumed when the buffered size goes below
@@ -148,6 +203,27 @@ class QueryConfig {
     return get<bool>(kCodegenLazyLoading, true);
   }
 
+  bool splitPreloadEnabled() const {
+    return get<bool>(kSplitPreloadEnabled, true);
+  }
+
+  uint64_t maxSplitPreloadMemory() const {
+    static constexpr uint64_t kDefault = 64UL << 20;
+    return get<uint64_t>(kMaxSplitPreloadMemory, kDefault);
+  }
+
+  int32_t aggregationPartitionBits() const {
+    return get<int32_t>(kAggregationPartitionBits, 0);
+  }
+
+  bool parallelFinalAggregation() const {
+    return get<bool>(kParallelFinalAggregation, false);
+  }
+
+  std::string shuffleSerde() const {
+    return get<std::string>(kShuffleSerde, "");
+  }
+
   bool createEmptyFiles() const {
     return get<bool>(kCreateEmptyFiles, false);
   }
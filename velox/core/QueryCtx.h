@@ -22,6 +22,7 @@
 #include "velox/core/Context.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/vector/DecodedVector.h"
+#include "velox/vector/VectorPool.h"
 
 namespace facebook::velox::core {
 
@@ -162,7 +163,10 @@ class QueryCtx : public Context {
 class ExecCtx : public Context {
  public:
   ExecCtx(memory::MemoryPool* pool, QueryCtx* queryCtx)
-      : Context{ContextScope::QUERY}, pool_(pool), queryCtx_(queryCtx) {}
+      : Context{ContextScope::QUERY},
+        pool_(pool),
+        queryCtx_(queryCtx),
+        vectorPool_(pool) {}
 
   velox::memory::MemoryPool* pool() const {
     return pool_;
@@ -205,6 +209,28 @@ class ExecCtx : public Context {
     decodedVectorPool_.push_back(std::move(vector));
   }
 
+  /// Returns a flat vector of 'type' and 'size' from the vector pool. Makes
+  /// a new one if none is available. See VectorPool::get().
+  VectorPtr getVector(const TypePtr& type, vector_size_t size) {
+    return vectorPool_.get(type, size);
+  }
+
+  /// Moves 'vector' into the vector pool if it is no longer referenced from
+  /// elsewhere. Returns true if the vector was taken.
+  bool releaseVector(VectorPtr& vector) {
+    return vectorPool_.release(vector);
+  }
+
+  /// Calls releaseVector() on each of 'vectors'. Returns the number of
+  /// vectors taken.
+  size_t releaseVectors(std::vector<VectorPtr>& vectors) {
+    return vectorPool_.release(vectors);
+  }
+
+  const VectorPool& vectorPool() const {
+    return vectorPool_;
+  }
+
  private:
   // Pool for all Buffers for this thread
   memory::MemoryPool* pool_;
@@ -214,6 +240,8 @@ class ExecCtx : public Context {
   // A pool of preallocated SelectivityVectors for use by expressions
   // and operators.
   std::vector<std::unique_ptr<SelectivityVector>> selectivityVectorPool_;
+  // A pool of flat vectors for results of expressions and operators.
+  VectorPool vectorPool_;
 };
 
 } // namespace facebook::velox::core
@@ -93,6 +93,7 @@ class RowReaderOptions {
   bool preloadStripe;
   bool projectSelectedType;
   bool returnFlatVector_ = false;
+  bool zeroCopyStrings_ = false;
   ErrorTolerance errorTolerance_;
   std::shared_ptr<ColumnSelector> selector_;
   velox::common::ScanSpec* scanSpec_ = nullptr;
@@ -109,6 +110,7 @@ class RowReaderOptions {
     selector_ = other.selector_;
     scanSpec_ = other.scanSpec_;
     returnFlatVector_ = other.returnFlatVector_;
+    zeroCopyStrings_ = other.zeroCopyStrings_;
     flatmapNodeIdAsStruct_ = other.flatmapNodeIdAsStruct_;
   }
 
@@ -200,6 +202,21 @@ class RowReaderOptions {
     returnFlatVector_ = value;
   }
 
+  // True if string results may reference the read buffers of the file
+  // instead of copies of the strings.
+  bool getZeroCopyStrings() const {
+    return zeroCopyStrings_;
+  }
+
+  // Requests that strings which are in a read buffer that can be kept
+  // alive, e.g. a pinned cache entry, are returned without copying. The
+  // result vectors then hold the buffers. This saves copying strings that
+  // are filtered out later, at the cost of keeping the buffers in memory
+  // for the lifetime of the vectors.
+  void setZeroCopyStrings(bool value) {
+    zeroCopyStrings_ = value;
+  }
+
   /**
    * Request that the selected type be projected.
    */
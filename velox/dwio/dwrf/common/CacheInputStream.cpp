@@ -67,6 +67,28 @@ bool CacheInputStream::Next(const void** buffer, int32_t* size) {
   return true;
 }
 
+namespace {
+// Keeps a cache entry pinned for the lifetime of a BufferView over its data.
+class PinReleaser {
+ public:
+  explicit PinReleaser(const cache::CachePin& pin) : pin_(pin) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+ private:
+  const cache::CachePin pin_;
+};
+} // namespace
+
+BufferPtr CacheInputStream::pinLastBuffer() {
+  if (pin_.empty() || !run_) {
+    return nullptr;
+  }
+  return BufferView<PinReleaser>::create(run_, runSize_, PinReleaser(pin_));
+}
+
 void CacheInputStream::BackUp(int32_t count) {
   DWIO_ENSURE_GE(count, 0, "can't backup negative distances");
 
@@ -47,6 +47,7 @@ class CacheInputStream : public SeekableInputStream {
   std::string getName() const override;
   size_t loadIndices(const proto::RowIndex& rowIndex, size_t startIndex)
       override;
+  BufferPtr pinLastBuffer() override;
 
  private:
   // Ensures that the current position is covered by 'pin_'.
@@ -363,6 +363,11 @@ class DwrfCoalescedLoad : public DwrfCoalescedLoadBase {
     if (pins.empty()) {
       return pins;
     }
+    // With a natively asynchronous stream, all the coalesced reads are in
+    // flight before waiting for the first.
+    const bool async = stream.hasReadAsync();
+    std::vector<folly::SemiFuture<uint64_t>> reads;
+    std::vector<uint64_t> readSizes;
     auto stats = cache::readPins(
         pins,
         maxCoalesceDistance_,
@@ -373,8 +378,15 @@ class DwrfCoalescedLoad : public DwrfCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          stream.read(buffers, offset, dwio::common::LogType::FILE);
+          if (async) {
+            reads.push_back(
+                stream.readAsync(buffers, offset, dwio::common::LogType::FILE));
+            readSizes.push_back(cache::readSize(buffers));
+          } else {
+            stream.read(buffers, offset, dwio::common::LogType::FILE);
+          }
         });
+    cache::waitForReads(reads, readSizes);
     updateStats(stats, isPrefetch, false);
     return pins;
   }
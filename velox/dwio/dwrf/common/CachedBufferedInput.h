@@ -135,6 +135,10 @@ class CachedBufferedInput : public BufferedInput {
     return cache_;
   }
 
+  uint64_t fileNum() const {
+    return fileNum_;
+  }
+
   // Returns the CoalescedLoad that contains the correlated loads for
   // 'stream' or nullptr if none. Returns nullptr on all but first
   // call for 'stream' since the load is to be triggered by the first
@@ -82,6 +82,13 @@ enum StreamKind {
  */
 std::string streamKindToString(StreamKind kind);
 
+/**
+ * Returns true for streams that are placed in the index section of a stripe.
+ */
+inline bool isIndexStream(StreamKind kind) {
+  return kind == StreamKind_ROW_INDEX || kind == StreamKind_BLOOM_FILTER_UTF8;
+}
+
 class StreamInformation {
  public:
   virtual ~StreamInformation() = default;
@@ -168,4 +168,23 @@ Config::Entry<bool> Config::STREAM_SIZE_ABOVE_THRESHOLD_CHECK_ENABLED(
 Config::Entry<uint64_t> Config::RAW_DATA_SIZE_PER_BATCH(
     "hive.exec.orc.raw.data.size.per.batch",
     50UL * 1024 * 1024);
+
+Config::Entry<const std::vector<uint32_t>> Config::BLOOM_FILTER_COLS(
+    "orc.bloom.filter.cols",
+    {},
+    [](const std::vector<uint32_t>& val) { return folly::join(",", val); },
+    [](const std::string& val) {
+      std::vector<uint32_t> result;
+      if (!val.empty()) {
+        std::vector<folly::StringPiece> pieces;
+        folly::split(',', val, pieces, true);
+        for (auto& p : pieces) {
+          const auto& trimmedCol = folly::trimWhitespace(p);
+          if (!trimmedCol.empty()) {
+            result.push_back(folly::to<uint32_t>(trimmedCol));
+          }
+        }
+      }
+      return result;
+    });
 } // namespace facebook::velox::dwrf
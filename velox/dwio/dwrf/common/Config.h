@@ -119,6 +119,10 @@ class Config {
   // Limit the raw data size per batch to avoid being forced
   // to write oversized stripes.
   static Entry<uint64_t> RAW_DATA_SIZE_PER_BATCH;
+  // Top level columns that get a bloom filter per row group. Only integer and
+  // string columns are supported. Readers use the filters to skip row groups
+  // on equality and IN filters.
+  static Entry<const std::vector<uint32_t>> BLOOM_FILTER_COLS;
 
  private:
   std::unordered_map<std::string, std::string> configs_;
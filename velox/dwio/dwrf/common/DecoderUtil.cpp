@@ -31,6 +31,77 @@ int32_t nonNullRowsFromDense(
   nonNullRows.resize(size);
   return size;
 }
+namespace {
+// Returns the big endian value of 'bitWidth' bits starting 'bit' bits after
+// the most significant bit of 'input[0]'.
+inline uint64_t
+loadBigEndianBits(const char* input, uint64_t bit, int32_t bitWidth) {
+  auto bytes = reinterpret_cast<const uint8_t*>(input) + (bit >> 3);
+  auto shift = bit & 7;
+  auto word = __builtin_bswap64(*reinterpret_cast<const uint64_t*>(bytes))
+      << shift;
+  if (shift + bitWidth > 64) {
+    // Widths over 56 bits can spill into a ninth byte.
+    word |= bytes[8] >> (8 - shift);
+  }
+  return word >> (64 - bitWidth);
+}
+
+void unpackBigEndianAvx2(
+    const char* input,
+    int32_t bitOffset,
+    int32_t bitWidth,
+    int32_t numValues,
+    uint64_t* result) {
+  // Reverses the bytes of each 64 bit lane.
+  const auto byteSwap = _mm256_setr_epi8(
+      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  const auto rightShift = _mm_cvtsi32_si128(64 - bitWidth);
+  const auto step = _mm256_set1_epi64x(4L * bitWidth);
+  const auto byteMask = _mm256_set1_epi64x(7);
+  auto bits = _mm256_add_epi64(
+      _mm256_set1_epi64x(bitOffset),
+      _mm256_setr_epi64x(0, bitWidth, 2L * bitWidth, 3L * bitWidth));
+  int32_t i = 0;
+  for (; i + 4 <= numValues; i += 4) {
+    auto words = _mm256_i64gather_epi64(
+        reinterpret_cast<const long long*>(input),
+        _mm256_srli_epi64(bits, 3),
+        1);
+    words = _mm256_shuffle_epi8(words, byteSwap);
+    words = _mm256_sllv_epi64(words, _mm256_and_si256(bits, byteMask));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(result + i),
+        _mm256_srl_epi64(words, rightShift));
+    bits = _mm256_add_epi64(bits, step);
+  }
+  for (; i < numValues; ++i) {
+    result[i] = loadBigEndianBits(
+        input, bitOffset + static_cast<uint64_t>(i) * bitWidth, bitWidth);
+  }
+}
+} // namespace
+
+void unpackBigEndian(
+    const char* input,
+    int32_t bitOffset,
+    int32_t bitWidth,
+    int32_t numValues,
+    uint64_t* result) {
+  VELOX_DCHECK(bitWidth >= 1 && bitWidth <= 64);
+  // A value of up to 56 bits is within the 8 bytes starting at its first
+  // byte, so that one 64 bit gather per lane loads it.
+  if (bitWidth <= 56 && simd::simdLevel() >= simd::SimdLevel::kAvx2) {
+    unpackBigEndianAvx2(input, bitOffset, bitWidth, numValues, result);
+    return;
+  }
+  for (auto i = 0; i < numValues; ++i) {
+    result[i] = loadBigEndianBits(
+        input, bitOffset + static_cast<uint64_t>(i) * bitWidth, bitWidth);
+  }
+}
+
 // Returns 8 bits starting at bit 'index'.
 uint8_t load8Bits(const uint64_t* bits, int32_t index) {
   uint8_t shift = index & 7;
@@ -26,6 +26,7 @@ namespace facebook::velox {
 using RowSet = folly::Range<const int32_t*>;
 namespace common {
 class AlwaysTrue;
+class BigintRange;
 template <typename TFilter, typename T>
 static bool applyFilter(TFilter& filter, T value);
 } // namespace common
@@ -197,6 +198,11 @@ void fixedWidthScan(
   constexpr int32_t kStep = is16 ? 16 : 8;
   constexpr bool hasFilter = !std::is_same<TFilter, common::AlwaysTrue>::value;
   constexpr bool hasHook = !std::is_same<THook, NoHook>::value;
+  // Dense runs of rows with a range filter go to a kernel that uses the
+  // widest SIMD level of the CPU.
+  constexpr bool isRangeFilter =
+      std::is_same<TFilter, common::BigintRange>::value && !scatter &&
+      (std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value);
   auto rawValues = reinterpret_cast<T*>(voidValues);
   loopOverBuffers<T>(
       rows,
@@ -229,6 +235,27 @@ void fixedWidthScan(
           int32_t numRowsInBuffer,
           int32_t rowOffset,
           const T* buffer) {
+        if constexpr (isRangeFilter) {
+          if (simd::isDense(rows + rowIndex, numRowsInBuffer)) {
+            auto firstRow = rows[rowIndex];
+            // The bounds are int64_t. Narrow them to the range of T.
+            auto lower = std::max<int64_t>(
+                filter.lower(), std::numeric_limits<T>::min());
+            auto upper = std::min<int64_t>(
+                filter.upper(), std::numeric_limits<T>::max());
+            if (lower <= upper) {
+              numValues += simd::filterRange<T>(
+                  buffer + firstRow - rowOffset,
+                  numRowsInBuffer,
+                  lower,
+                  upper,
+                  firstRow,
+                  filterHits + numValues,
+                  filterOnly ? nullptr : rawValues + numValues);
+            }
+            return;
+          }
+        }
         rowLoop(
             rows,
             rowIndex,
@@ -394,6 +421,18 @@ int32_t nonNullRowsFromDense(
     int32_t numRows,
     raw_vector<int32_t>& nonNullRows);
 
+// Unpacks 'numValues' values of 'bitWidth' bits each from the big endian
+// bit packing used by RLEv2. The first value starts 'bitOffset' bits after
+// the most significant bit of 'input[0]'. 'bitWidth' is 1 to 64. Widths of
+// up to 56 bits decode 4 values at a time with AVX2. May read up to 8 bytes
+// past the last byte that holds packed bits.
+void unpackBigEndian(
+    const char* input,
+    int32_t bitOffset,
+    int32_t bitWidth,
+    int32_t numValues,
+    uint64_t* result);
+
 // Translates between row numbers in terms of positions in a nullable
 // column and row numbers in terms of actually stored non-null values.
 //
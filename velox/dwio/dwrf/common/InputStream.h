@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/buffer/Buffer.h"
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
@@ -58,6 +59,14 @@ class SeekableInputStream : public google::protobuf::io::ZeroCopyInputStream {
       const proto::RowIndex& rowIndex,
       size_t startIndex) = 0;
 
+  // Returns a Buffer over the memory returned by the last Next(). The memory
+  // stays valid and unchanged for as long as the Buffer is referenced, so
+  // that callers can reference bytes in it without copying. Returns nullptr
+  // if the memory is reused by 'this' or owned by the stripe.
+  virtual BufferPtr pinLastBuffer() {
+    return nullptr;
+  }
+
   void readFully(char* buffer, size_t bufferSize);
 };
 
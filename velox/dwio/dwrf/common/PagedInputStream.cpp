@@ -20,12 +20,47 @@
 namespace facebook::velox::dwrf {
 
 void PagedInputStream::prepareOutputBuffer(uint64_t uncompressedLength) {
-  if (!outputBuffer_ || uncompressedLength > outputBuffer_->capacity()) {
-    outputBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
+  if (!outputBuffer_ || uncompressedLength > outputBuffer_->capacity() ||
+      outputBuffer_.use_count() > 1) {
+    outputBuffer_ = std::make_shared<dwio::common::DataBuffer<char>>(
         pool_, uncompressedLength);
   }
 }
 
+namespace {
+// Keeps a decompression buffer alive for the lifetime of a BufferView over
+// it.
+class OutputBufferReleaser {
+ public:
+  explicit OutputBufferReleaser(
+      std::shared_ptr<dwio::common::DataBuffer<char>> buffer)
+      : buffer_(std::move(buffer)) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+ private:
+  const std::shared_ptr<dwio::common::DataBuffer<char>> buffer_;
+};
+} // namespace
+
+BufferPtr PagedInputStream::pinLastBuffer() {
+  if (outputBuffer_ && outputBufferPtr_ >= outputBuffer_->data() &&
+      outputBufferPtr_ <= outputBuffer_->data() + outputBuffer_->capacity()) {
+    // The last Next() returned decompressed data.
+    return BufferView<OutputBufferReleaser>::create(
+        reinterpret_cast<const uint8_t*>(outputBuffer_->data()),
+        outputBuffer_->capacity(),
+        OutputBufferReleaser(outputBuffer_));
+  }
+  if (decryptionBuffer_) {
+    return nullptr;
+  }
+  // The last Next() returned an uncompressed block in place.
+  return input_->pinLastBuffer();
+}
+
 void PagedInputStream::readBuffer(bool failOnEof) {
   int32_t length;
   if (!input_->Next(
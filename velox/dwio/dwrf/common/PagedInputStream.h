@@ -46,6 +46,7 @@ class PagedInputStream : public SeekableInputStream {
     return bytesReturned_;
   }
   void seekToRowGroup(PositionProvider& position) override;
+  BufferPtr pinLastBuffer() override;
   std::string getName() const override {
     return folly::to<std::string>(
         "PagedInputStream StreamInfo (",
@@ -107,8 +108,9 @@ class PagedInputStream : public SeekableInputStream {
   // decompression/decryption algorithm to work on contiguous block
   dwio::common::DataBuffer<char> inputBuffer_;
 
-  // uncompressed output
-  std::unique_ptr<dwio::common::DataBuffer<char>> outputBuffer_{nullptr};
+  // uncompressed output. Shared with the Buffers returned by pinLastBuffer().
+  // A new one is allocated if the current one is pinned.
+  std::shared_ptr<dwio::common::DataBuffer<char>> outputBuffer_{nullptr};
 
   // unencrypted output
   std::unique_ptr<folly::IOBuf> decryptionBuffer_{nullptr};
@@ -21,6 +21,7 @@
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/common/Adaptor.h"
+#include "velox/dwio/dwrf/common/DecoderUtil.h"
 #include "velox/dwio/dwrf/common/IntDecoder.h"
 
 #include <vector>
@@ -106,41 +107,79 @@ class RleDecoderV2 : public IntDecoder<isSigned> {
   }
 
   int64_t readLongBE(uint64_t bsz);
-  uint64_t readLongs(
-      int64_t* data,
-      uint64_t offset,
-      uint64_t len,
-      uint64_t fb,
-      const uint64_t* nulls = nullptr) {
-    uint64_t ret = 0;
+  // Reads the next 'fb' bits one byte at a time. Used at buffer ends.
+  uint64_t readBits(uint64_t fb) {
+    uint64_t result = 0;
+    uint64_t bitsLeftToRead = fb;
+    while (bitsLeftToRead > bitsLeft) {
+      result <<= bitsLeft;
+      result |= curByte & ((1 << bitsLeft) - 1);
+      bitsLeftToRead -= bitsLeft;
+      curByte = readByte();
+      bitsLeft = 8;
+    }
+
+    // handle the left over bits
+    if (bitsLeftToRead > 0) {
+      result <<= bitsLeftToRead;
+      bitsLeft -= static_cast<uint32_t>(bitsLeftToRead);
+      result |= (curByte >> bitsLeft) & ((1 << bitsLeftToRead) - 1);
+    }
+    return result;
+  }
 
-    // TODO: unroll to improve performance
-    for (uint64_t i = offset; i < (offset + len); i++) {
-      // skip null positions
-      if (nulls && bits::isBitNull(nulls, i)) {
+  // Unpacks 'numValues' consecutive values of 'fb' bits into 'result'.
+  // Values that are entirely in the current buffer are unpacked in bulk.
+  void unpackLongs(uint64_t* result, uint64_t numValues, uint64_t fb) {
+    // unpackBigEndian may read this many bytes past the packed bits.
+    constexpr int32_t kSlack = 8;
+    while (numValues > 0) {
+      // A partly consumed byte is the last byte read from the buffer.
+      auto start = IntDecoder<isSigned>::bufferStart - (bitsLeft ? 1 : 0);
+      int32_t bitOffset = bitsLeft ? 8 - bitsLeft : 0;
+      auto available = IntDecoder<isSigned>::bufferEnd - start - kSlack;
+      uint64_t numInBuffer = available > 0
+          ? std::min<uint64_t>(numValues, (available * 8 - bitOffset) / fb)
+          : 0;
+      if (numInBuffer == 0) {
+        *result++ = readBits(fb);
+        --numValues;
         continue;
       }
-      uint64_t result = 0;
-      uint64_t bitsLeftToRead = fb;
-      while (bitsLeftToRead > bitsLeft) {
-        result <<= bitsLeft;
-        result |= curByte & ((1 << bitsLeft) - 1);
-        bitsLeftToRead -= bitsLeft;
+      DCHECK(!bitsLeft || static_cast<uint8_t>(*start) == curByte);
+      unpackBigEndian(start, bitOffset, fb, numInBuffer, result);
+      auto endBit = bitOffset + numInBuffer * fb;
+      IntDecoder<isSigned>::bufferStart = start + endBit / 8;
+      bitsLeft = 0;
+      if (endBit % 8) {
         curByte = readByte();
-        bitsLeft = 8;
+        bitsLeft = 8 - endBit % 8;
       }
+      result += numInBuffer;
+      numValues -= numInBuffer;
+    }
+  }
 
-      // handle the left over bits
-      if (bitsLeftToRead > 0) {
-        result <<= bitsLeftToRead;
-        bitsLeft -= static_cast<uint32_t>(bitsLeftToRead);
-        result |= (curByte >> bitsLeft) & ((1 << bitsLeftToRead) - 1);
+  uint64_t readLongs(
+      int64_t* data,
+      uint64_t offset,
+      uint64_t len,
+      uint64_t fb,
+      const uint64_t* nulls = nullptr) {
+    uint64_t numValues =
+        nulls ? bits::countNonNulls(nulls, offset, offset + len) : len;
+    unpackLongs(reinterpret_cast<uint64_t*>(data + offset), numValues, fb);
+    if (nulls && numValues < len) {
+      // Spreads the values to the non-null positions, last to first so as
+      // not to overwrite values that are yet to be moved.
+      auto numLeft = numValues;
+      for (auto i = offset + len; numLeft > 0 && i-- > offset;) {
+        if (!bits::isBitNull(nulls, i)) {
+          data[i] = data[offset + --numLeft];
+        }
       }
-      data[i] = static_cast<int64_t>(result);
-      ++ret;
     }
-
-    return ret;
+    return numValues;
   }
 
   uint64_t nextShortRepeats(
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/RowGroupBloomFilter.h"
+
+#include <folly/lang/Bits.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace facebook::velox::dwrf {
+
+namespace {
+inline uint64_t rotateLeft(uint64_t value, int32_t bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+// Java's signed right shift.
+inline uint64_t shiftRightArithmetic(uint64_t value, int32_t bits) {
+  return static_cast<uint64_t>(static_cast<int64_t>(value) >> bits);
+}
+
+inline uint64_t fmix64(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Calls 'func' with each bit position of 'hash' in a filter of 'numBits'
+// bits. Same as ORC's BloomFilter.addHash(), which uses 32 bit Java ints.
+template <typename TFunc>
+void forEachBit(
+    uint64_t hash,
+    uint32_t numHashFunctions,
+    uint64_t numBits,
+    TFunc func) {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  for (uint32_t i = 1; i <= numHashFunctions; ++i) {
+    auto combinedHash = static_cast<int32_t>(hash1 + i * hash2);
+    if (combinedHash < 0) {
+      combinedHash = ~combinedHash;
+    }
+    func(combinedHash % numBits);
+  }
+}
+} // namespace
+
+uint64_t bloomFilterHash(int64_t value) {
+  uint64_t key = value;
+  key = ~key + (key << 21);
+  key ^= shiftRightArithmetic(key, 24);
+  key = key + (key << 3) + (key << 8);
+  key ^= shiftRightArithmetic(key, 14);
+  key = key + (key << 2) + (key << 4);
+  key ^= shiftRightArithmetic(key, 28);
+  key = key + (key << 31);
+  return key;
+}
+
+uint64_t bloomFilterHash(folly::StringPiece value) {
+  constexpr uint64_t kC1 = 0x87c37b91114253d5ULL;
+  constexpr uint64_t kC2 = 0x4cf5ad432745937fULL;
+  constexpr uint64_t kSeed = 104729;
+  auto data = reinterpret_cast<const uint8_t*>(value.data());
+  const auto length = value.size();
+  uint64_t hash = kSeed;
+  const auto numBlocks = length / 8;
+  for (uint64_t i = 0; i < numBlocks; ++i) {
+    uint64_t k;
+    memcpy(&k, data + i * 8, sizeof(k));
+    k = folly::Endian::little(k);
+    k *= kC1;
+    k = rotateLeft(k, 31);
+    k *= kC2;
+    hash ^= k;
+    hash = rotateLeft(hash, 27) * 5 + 0x52dce729;
+  }
+  const auto tail = data + numBlocks * 8;
+  const auto tailSize = length % 8;
+  if (tailSize > 0) {
+    uint64_t k = 0;
+    for (auto i = tailSize; i-- > 0;) {
+      k ^= static_cast<uint64_t>(tail[i]) << (i * 8);
+    }
+    k *= kC1;
+    k = rotateLeft(k, 31);
+    k *= kC2;
+    hash ^= k;
+  }
+  hash ^= length;
+  return fmix64(hash);
+}
+
+void RowGroupBloomFilterBuilder::toProto(proto::BloomFilter& filter) const {
+  // Sized as ORC's BloomFilter for the number of distinct values.
+  const auto numValues = std::max<size_t>(1, hashes_.size());
+  const auto optimalBits = static_cast<uint64_t>(
+      -static_cast<double>(numValues) * std::log(kRowGroupBloomFilterFpp) /
+      (std::log(2.0) * std::log(2.0)));
+  const uint64_t numBits = optimalBits + 64 - optimalBits % 64;
+  const uint32_t numHashFunctions = std::max<int64_t>(
+      1,
+      std::llround(static_cast<double>(numBits) / numValues * std::log(2.0)));
+  std::vector<uint64_t> bits(numBits / 64);
+  for (auto hash : hashes_) {
+    forEachBit(hash, numHashFunctions, numBits, [&](uint64_t bit) {
+      bits[bit / 64] |= 1ULL << (bit % 64);
+    });
+  }
+  filter.set_numhashfunctions(numHashFunctions);
+  // The stream is BLOOM_FILTER_UTF8, for which ORC readers take the bits
+  // from 'utf8bitset' as little endian words.
+  for (auto& word : bits) {
+    word = folly::Endian::little(word);
+  }
+  filter.set_utf8bitset(bits.data(), bits.size() * sizeof(uint64_t));
+}
+
+bool bloomFilterMayContain(const proto::BloomFilter& filter, uint64_t hash) {
+  const uint64_t* words;
+  uint64_t numWords;
+  std::vector<uint64_t> utf8Words;
+  if (filter.bitset_size() > 0) {
+    words = filter.bitset().data();
+    numWords = filter.bitset_size();
+  } else {
+    const auto& bytes = filter.utf8bitset();
+    if (bytes.empty() || bytes.size() % sizeof(uint64_t) != 0) {
+      return true;
+    }
+    utf8Words.resize(bytes.size() / sizeof(uint64_t));
+    memcpy(utf8Words.data(), bytes.data(), bytes.size());
+    for (auto& word : utf8Words) {
+      word = folly::Endian::little(word);
+    }
+    words = utf8Words.data();
+    numWords = utf8Words.size();
+  }
+  if (filter.numhashfunctions() == 0) {
+    return true;
+  }
+  bool mayContain = true;
+  forEachBit(hash, filter.numhashfunctions(), numWords * 64, [&](uint64_t bit) {
+    mayContain &= (words[bit / 64] & (1ULL << (bit % 64))) != 0;
+  });
+  return mayContain;
+}
+
+} // namespace facebook::velox::dwrf
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/container/F14Set.h>
+
+#include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+
+namespace facebook::velox::dwrf {
+
+// Row group bloom filters use the ORC BloomFilter format so that other ORC
+// and DWRF readers can use them: 'numHashFunctions' bit positions are
+// derived from one 64 bit hash of the value by double hashing into a bitset
+// of 64 bit words. They are written to the BLOOM_FILTER_UTF8 stream of the
+// column as a proto::BloomFilterIndex with one entry per row group. The
+// hash functions are part of the file format and must not change.
+
+// False positive probability the filters are sized for.
+constexpr double kRowGroupBloomFilterFpp = 0.05;
+
+// Integers of all widths are hashed as 64 bit values with Thomas Wang's
+// integer hash, as in ORC's BloomFilter.getLongHash().
+uint64_t bloomFilterHash(int64_t value);
+
+// Strings are hashed with the 64 bit Murmur3 variant of Hive.
+uint64_t bloomFilterHash(folly::StringPiece value);
+
+// Collects the distinct hashes of the values of one row group. The filter is
+// sized at the end of the row group so that low cardinality columns get
+// small filters.
+class RowGroupBloomFilterBuilder {
+ public:
+  void add(uint64_t hash) {
+    hashes_.insert(hash);
+  }
+
+  void reset() {
+    hashes_.clear();
+  }
+
+  // Writes the bits to 'utf8bitset' as little endian 64 bit words, which is
+  // where ORC readers look for them in a BLOOM_FILTER_UTF8 stream.
+  void toProto(proto::BloomFilter& filter) const;
+
+ private:
+  folly::F14FastSet<uint64_t> hashes_;
+};
+
+// Returns false if no value with 'hash' was added to the row group of
+// 'filter'. Accepts both the 'bitset' words and the little endian
+// 'utf8bitset' bytes. Empty or malformed filters may contain anything.
+bool bloomFilterMayContain(const proto::BloomFilter& filter, uint64_t hash);
+
+} // namespace facebook::velox::dwrf
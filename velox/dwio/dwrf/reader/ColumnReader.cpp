@@ -1024,7 +1024,8 @@ void StringDictionaryColumnReader::loadStrideDictionary() {
 
   lastStrideIndex = nextStride;
 
-  dictionaryValues_.reset();
+  // 'dictionaryValues_' has only the stripe dictionary and is kept, so that
+  // batches without stride dictionary values share their base vector.
   combinedDictionaryValues_.reset();
 }
 
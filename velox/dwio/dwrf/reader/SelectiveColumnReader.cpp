@@ -28,6 +28,8 @@
 #include "velox/dwio/dwrf/reader/SelectiveRepeatedColumnReader.h"
 #include "velox/dwio/dwrf/reader/SelectiveStructColumnReader.h"
 
+#include "velox/dwio/dwrf/common/RowGroupBloomFilter.h"
+
 namespace facebook::velox::dwrf {
 
 using dwio::common::TypeWithId;
@@ -73,8 +75,86 @@ SelectiveColumnReader::SelectiveColumnReader(
   // time pushdown.
   indexStream_ = stripe.getStream(
       encodingKey.forKind(proto::Stream_Kind_ROW_INDEX), false);
+  // Present only if the writer was configured to make bloom filters for
+  // the column.
+  bloomFilterStream_ = stripe.getStream(
+      encodingKey.forKind(proto::Stream_Kind_BLOOM_FILTER_UTF8), false);
 }
 
+namespace {
+// Filters with more values are not checked against bloom filters.
+constexpr int32_t kMaxBloomFilterValues = 1'000;
+
+// Returns the bloom filter hashes of the values that pass 'filter' if
+// 'filter' passes a small set of values of 'type'. Returns an empty vector
+// otherwise.
+std::vector<uint64_t> bloomFilterHashes(
+    const common::Filter& filter,
+    const Type& type) {
+  std::vector<uint64_t> hashes;
+  auto addInts = [&](const auto& values) {
+    if (values.size() <= kMaxBloomFilterValues) {
+      for (auto value : values) {
+        hashes.push_back(bloomFilterHash(value));
+      }
+    }
+  };
+  switch (type.kind()) {
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      switch (filter.kind()) {
+        case common::FilterKind::kBigintValuesUsingHashTable:
+          addInts(
+              static_cast<const common::BigintValuesUsingHashTable*>(&filter)
+                  ->values());
+          break;
+        case common::FilterKind::kBigintValuesUsingBitmask:
+          addInts(static_cast<const common::BigintValuesUsingBitmask*>(&filter)
+                      ->values());
+          break;
+        case common::FilterKind::kBigintRange: {
+          auto range = static_cast<const common::BigintRange*>(&filter);
+          if (range->isSingleValue()) {
+            hashes.push_back(bloomFilterHash(range->lower()));
+          }
+          break;
+        }
+        default:
+          break;
+      }
+      break;
+    case TypeKind::VARCHAR:
+      switch (filter.kind()) {
+        case common::FilterKind::kBytesValues: {
+          const auto& values =
+              static_cast<const common::BytesValues*>(&filter)->values();
+          if (values.size() <= kMaxBloomFilterValues) {
+            for (const auto& value : values) {
+              hashes.push_back(bloomFilterHash(folly::StringPiece(value)));
+            }
+          }
+          break;
+        }
+        case common::FilterKind::kBytesRange: {
+          auto range = static_cast<const common::BytesRange*>(&filter);
+          if (range->isSingleValue()) {
+            hashes.push_back(
+                bloomFilterHash(folly::StringPiece(range->lower())));
+          }
+          break;
+        }
+        default:
+          break;
+      }
+      break;
+    default:
+      break;
+  }
+  return hashes;
+}
+} // namespace
+
 std::vector<uint32_t> SelectiveColumnReader::filterRowGroups(
     uint64_t rowGroupSize,
     const StatsContext& context) const {
@@ -85,6 +165,15 @@ std::vector<uint32_t> SelectiveColumnReader::filterRowGroups(
   ensureRowGroupIndex();
   auto filter = scanSpec_->filter();
 
+  std::vector<uint64_t> bloomHashes;
+  if (bloomFilterIndex_ || bloomFilterStream_) {
+    bloomHashes = bloomFilterHashes(*filter, *type_);
+    if (!bloomHashes.empty() && bloomFilterStream_) {
+      bloomFilterIndex_ = ProtoUtils::readProto<proto::BloomFilterIndex>(
+          std::move(bloomFilterStream_));
+    }
+  }
+
   std::vector<uint32_t> stridesToSkip;
   for (auto i = 0; i < index_->entry_size(); i++) {
     const auto& entry = index_->entry(i);
@@ -93,6 +182,18 @@ std::vector<uint32_t> SelectiveColumnReader::filterRowGroups(
     if (!testFilter(filter, columnStats.get(), rowGroupSize, type_)) {
       VLOG(1) << "Drop stride " << i << " on " << scanSpec_->toString();
       stridesToSkip.push_back(i); // Skipping stride based on column stats.
+    } else if (
+        !bloomHashes.empty() && i < bloomFilterIndex_->bloomfilter_size() &&
+        !(filter->testNull() && columnStats->hasNull().value_or(true))) {
+      const auto& bloomFilter = bloomFilterIndex_->bloomfilter(i);
+      if (std::none_of(
+              bloomHashes.begin(), bloomHashes.end(), [&](uint64_t hash) {
+                return bloomFilterMayContain(bloomFilter, hash);
+              })) {
+        VLOG(1) << "Drop stride " << i << " on bloom filter of "
+                << scanSpec_->toString();
+        stridesToSkip.push_back(i);
+      }
     }
   }
   return stridesToSkip;
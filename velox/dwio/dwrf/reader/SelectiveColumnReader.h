@@ -382,6 +382,9 @@ class SelectiveColumnReader : public ColumnReader {
   TypePtr type_;
   mutable std::unique_ptr<SeekableInputStream> indexStream_;
   mutable std::unique_ptr<proto::RowIndex> index_;
+  // Bloom filters for the row groups, read on first use in filterRowGroups().
+  mutable std::unique_ptr<SeekableInputStream> bloomFilterStream_;
+  mutable std::unique_ptr<proto::BloomFilterIndex> bloomFilterIndex_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
 
@@ -48,17 +48,27 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
       dictVInts,
       INT_BYTE_SIZE);
 
-  const auto lenId = encodingKey.forKind(proto::Stream_Kind_LENGTH);
-  bool lenVInts = stripe.getUseVInts(lenId);
-  lengthDecoder_ = IntDecoder</*isSigned*/ false>::createRle(
-      stripe.getStream(lenId, false),
-      rleVersion,
-      memoryPool_,
-      lenVInts,
-      INT_BYTE_SIZE);
+  decodedCache_ = stripe.decodedCache();
+  if (decodedCache_) {
+    dictionaryKey_ = stripe.decodedCacheKey(
+        encodingKey, cache::DecodedKind::kStringDictionary);
+    cachedDictionary_ =
+        decodedCache_->find<CachedDictionary>(dictionaryKey_.value());
+  }
+  // A dictionary from the cache saves reading the dictionary streams.
+  if (!cachedDictionary_) {
+    const auto lenId = encodingKey.forKind(proto::Stream_Kind_LENGTH);
+    bool lenVInts = stripe.getUseVInts(lenId);
+    lengthDecoder_ = IntDecoder</*isSigned*/ false>::createRle(
+        stripe.getStream(lenId, false),
+        rleVersion,
+        memoryPool_,
+        lenVInts,
+        INT_BYTE_SIZE);
 
-  blobStream_ = stripe.getStream(
-      encodingKey.forKind(proto::Stream_Kind_DICTIONARY_DATA), false);
+    blobStream_ = stripe.getStream(
+        encodingKey.forKind(proto::Stream_Kind_DICTIONARY_DATA), false);
+  }
 
   // handle in dictionary stream
   std::unique_ptr<SeekableInputStream> inDictStream = stripe.getStream(
@@ -98,10 +108,10 @@ uint64_t SelectiveStringDictionaryColumnReader::skip(uint64_t numValues) {
 void SelectiveStringDictionaryColumnReader::loadDictionary(
     SeekableInputStream& data,
     IntDecoder</*isSigned*/ false>& lengthDecoder,
-    DictionaryValues& values) {
+    DictionaryValues& values,
+    memory::MemoryPool& pool) {
   // read lengths from length reader
-  detail::ensureCapacity<StringView>(
-      values.values, values.numValues, &memoryPool_);
+  detail::ensureCapacity<StringView>(values.values, values.numValues, &pool);
   // The lengths are read in the low addresses of the string views array.
   int64_t* int64Values = values.values->asMutable<int64_t>();
   lengthDecoder.next(int64Values, values.numValues, nullptr);
@@ -110,7 +120,7 @@ void SelectiveStringDictionaryColumnReader::loadDictionary(
     stringsBytes += int64Values[i];
   }
   // read bytes from underlying string
-  values.strings = AlignedBuffer::allocate<char>(stringsBytes, &memoryPool_);
+  values.strings = AlignedBuffer::allocate<char>(stringsBytes, &pool);
   data.readFully(values.strings->asMutable<char>(), stringsBytes);
   // fill the values with StringViews over the strings. 'strings' will
   // exist even if 'stringsBytes' is 0, which can happen if the only
@@ -134,6 +144,7 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
 
   // get stride dictionary size and load it if needed
   auto& positions = index_->entry(nextStride).positions();
+  const auto previousStrideDictSize = scanState_.dictionary2.numValues;
   scanState_.dictionary2.numValues = positions.Get(strideDictSizeOffset_);
   if (scanState_.dictionary2.numValues > 0) {
     // seek stride dictionary related streams
@@ -144,11 +155,19 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
     strideDictLengthDecoder_->seekToRowGroup(pp);
 
     loadDictionary(
-        *strideDictStream_, *strideDictLengthDecoder_, scanState_.dictionary2);
+        *strideDictStream_,
+        *strideDictLengthDecoder_,
+        scanState_.dictionary2,
+        memoryPool_);
     scanState_.updateRawState();
   }
   lastStrideIndex_ = nextStride;
-  dictionaryValues_ = nullptr;
+  // The base vector stays the same if neither stride has its own dictionary.
+  // This way expressions over the column can keep results computed for the
+  // stripe dictionary across batches. See Expr::evalWithMemo().
+  if (previousStrideDictSize > 0 || scanState_.dictionary2.numValues > 0) {
+    dictionaryValues_ = nullptr;
+  }
 
   scanState_.filterCache.resize(
       scanState_.dictionary.numValues + scanState_.dictionary2.numValues);
@@ -278,6 +297,30 @@ void SelectiveStringDictionaryColumnReader::getValues(
   }
 }
 
+void SelectiveStringDictionaryColumnReader::loadStripeDictionary() {
+  if (cachedDictionary_) {
+    scanState_.dictionary.values = cachedDictionary_->values();
+    scanState_.dictionary.strings = cachedDictionary_->strings();
+    return;
+  }
+  if (!decodedCache_) {
+    loadDictionary(
+        *blobStream_, *lengthDecoder_, scanState_.dictionary, memoryPool_);
+    return;
+  }
+  // The dictionary is allocated from the cache's pool since it may outlive
+  // 'this'.
+  loadDictionary(
+      *blobStream_,
+      *lengthDecoder_,
+      scanState_.dictionary,
+      decodedCache_->pool());
+  decodedCache_->insert(
+      dictionaryKey_.value(),
+      std::make_shared<CachedDictionary>(
+          scanState_.dictionary.values, scanState_.dictionary.strings));
+}
+
 void SelectiveStringDictionaryColumnReader::ensureInitialized() {
   if (LIKELY(initialized_)) {
     return;
@@ -285,7 +328,7 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
 
   Timer timer;
 
-  loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
+  loadStripeDictionary();
 
   scanState_.filterCache.resize(scanState_.dictionary.numValues);
   simd::memset(
@@ -83,12 +83,39 @@ class SelectiveStringDictionaryColumnReader : public SelectiveColumnReader {
       RowSet rows,
       ExtractValues extractValues);
 
+  // Stripe dictionary in the decoded data tier of the cache.
+  class CachedDictionary : public cache::DecodedData {
+   public:
+    CachedDictionary(BufferPtr values, BufferPtr strings)
+        : values_(std::move(values)), strings_(std::move(strings)) {}
+
+    uint64_t byteSize() const override {
+      return values_->capacity() + strings_->capacity();
+    }
+
+    const BufferPtr& values() const {
+      return values_;
+    }
+
+    const BufferPtr& strings() const {
+      return strings_;
+    }
+
+   private:
+    const BufferPtr values_;
+    const BufferPtr strings_;
+  };
+
   // Fills 'values' from 'data' and 'lengthDecoder'. The count of
-  // values is in 'values.numValues'.
+  // values is in 'values.numValues'. Allocates from 'pool'.
   void loadDictionary(
       SeekableInputStream& data,
       IntDecoder</*isSigned*/ false>& lengthDecoder,
-      DictionaryValues& values);
+      DictionaryValues& values,
+      memory::MemoryPool& pool);
+
+  // Loads the stripe dictionary, from the decoded data cache if possible.
+  void loadStripeDictionary();
   void ensureInitialized();
   std::unique_ptr<IntDecoder</*isSigned*/ false>> dictIndex_;
   std::unique_ptr<ByteRleDecoder> inDictionaryReader_;
@@ -107,6 +134,12 @@ class SelectiveStringDictionaryColumnReader : public SelectiveColumnReader {
   std::unique_ptr<IntDecoder</*isSigned*/ false>> lengthDecoder_;
   std::unique_ptr<SeekableInputStream> blobStream_;
   bool initialized_{false};
+
+  // Set if the stripe has a decoded data cache. The dictionary streams are
+  // then not read if the dictionary is found in the cache.
+  cache::DecodedDataCache* FOLLY_NULLABLE decodedCache_{nullptr};
+  std::optional<cache::DecodedCacheKey> dictionaryKey_;
+  std::shared_ptr<CachedDictionary> cachedDictionary_;
 };
 
 template <typename TVisitor>
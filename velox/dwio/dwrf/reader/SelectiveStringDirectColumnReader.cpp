@@ -28,7 +28,8 @@ SelectiveStringDirectColumnReader::SelectiveStringDirectColumnReader(
           stripe,
           scanSpec,
           nodeType->type,
-          std::move(flatMapContext)) {
+          std::move(flatMapContext)),
+      zeroCopy_(stripe.getRowReaderOptions().getZeroCopyStrings()) {
   EncodingKey encodingKey{nodeType_->id, flatMapContext_.sequence};
   RleVersion rleVersion =
       convertRleVersion(stripe.getEncoding(encodingKey).kind());
@@ -57,6 +58,28 @@ uint64_t SelectiveStringDirectColumnReader::skip(uint64_t numValues) {
   return numValues;
 }
 
+bool SelectiveStringDirectColumnReader::pinBufferOf(
+    const char* data,
+    int32_t size) {
+  auto contains = [&](const BufferPtr& buffer) {
+    auto start = buffer->as<char>();
+    return data >= start && data + size <= start + buffer->size();
+  };
+  if (!pin_ || !contains(pin_)) {
+    // 'data' is in the last buffer returned by 'blobStream_' unless it is
+    // in 'tempString_'.
+    pin_ = blobStream_->pinLastBuffer();
+    if (!pin_ || !contains(pin_)) {
+      pin_ = nullptr;
+      return false;
+    }
+  }
+  if (batchPins_.empty() || batchPins_.back() != pin_) {
+    batchPins_.push_back(pin_);
+  }
+  return true;
+}
+
 void SelectiveStringDirectColumnReader::extractCrossBuffers(
     const int32_t* lengths,
     const int32_t* starts,
@@ -74,7 +97,8 @@ void SelectiveStringDirectColumnReader::extractCrossBuffers(
       addValue(value);
     } else {
       auto index = outerNonNullRows_[rowIndex + i];
-      if (size <= StringView::kInlineSize) {
+      if (size <= StringView::kInlineSize ||
+          (zeroCopy_ && pinBufferOf(value.data(), size))) {
         reinterpret_cast<StringView*>(rawValues_)[index] =
             StringView(value.data(), size);
       } else {
@@ -180,6 +204,11 @@ inline bool SelectiveStringDirectColumnReader::try8Consecutive(
           reinterpret_cast<char*>(result + resultIndex + 1) + length) = 0;
       continue;
     }
+    if (zeroCopy_ && pinBufferOf(data, length)) {
+      *reinterpret_cast<const char**>(result + resultIndex + 2) = data;
+      data += length;
+      continue;
+    }
     if (!rawStringBuffer_ || rawUsed + length > rawStringSize_) {
       // Slow path if no space in raw strings
       return false;
@@ -413,6 +442,7 @@ void SelectiveStringDirectColumnReader::read(
     RowSet rows,
     const uint64_t* incomingNulls) {
   prepareRead<folly::StringPiece>(offset, rows, incomingNulls);
+  batchPins_.clear();
   bool isDense = rows.back() == rows.size() - 1;
 
   auto end = rows.back() + 1;
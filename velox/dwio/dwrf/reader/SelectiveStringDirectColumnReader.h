@@ -57,10 +57,31 @@ class SelectiveStringDirectColumnReader : public SelectiveColumnReader {
     rawStringBuffer_ = nullptr;
     rawStringSize_ = 0;
     rawStringUsed_ = 0;
+    for (auto& pin : batchPins_) {
+      stringBuffers_.push_back(std::move(pin));
+    }
+    batchPins_.clear();
     getFlatValues<StringView, StringView>(rows, result, type_);
   }
 
+  // Appends 'value' to the result. References 'value' in place if the
+  // buffer holding it can be pinned, else copies it.
+  void addValue(folly::StringPiece value) {
+    if (zeroCopy_ && value.size() > StringView::kInlineSize &&
+        pinBufferOf(value.data(), value.size())) {
+      reinterpret_cast<StringView*>(rawValues_)[numValues_++] =
+          StringView(value.data(), value.size());
+      return;
+    }
+    SelectiveColumnReader::addValue(value);
+  }
+
  private:
+  // Returns true if the 'size' bytes at 'data' are in a buffer of
+  // 'blobStream_' that is pinned for the lifetime of the result. Adds the
+  // pin to the buffers of the result.
+  bool pinBufferOf(const char* data, int32_t size);
+
   template <bool hasNulls>
   void skipInDecode(int32_t numValues, int32_t current, const uint64_t* nulls);
 
@@ -111,6 +132,14 @@ class SelectiveStringDirectColumnReader : public SelectiveColumnReader {
   // Storage for a string straddling a buffer boundary. Needed for calling
   // the filter.
   std::string tempString_;
+
+  // True if strings are referenced in the buffers of 'blobStream_' instead
+  // of copied. See RowReaderOptions::setZeroCopyStrings().
+  const bool zeroCopy_;
+  // Pin on the last buffer of 'blobStream_' that values were referenced in.
+  BufferPtr pin_;
+  // Pins referenced by the values of the batch being read.
+  std::vector<BufferPtr> batchPins_;
 };
 
 } // namespace facebook::velox::dwrf
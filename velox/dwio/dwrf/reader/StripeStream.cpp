@@ -19,6 +19,7 @@
 #include "folly/ScopeGuard.h"
 #include "velox/common/base/BitSet.h"
 #include "velox/dwio/common/exception/Exception.h"
+#include "velox/dwio/dwrf/common/CachedBufferedInput.h"
 #include "velox/dwio/dwrf/common/wrap/coded-stream-wrapper.h"
 
 namespace facebook::velox::dwrf {
@@ -134,6 +135,27 @@ StripeStreamsBase::getIntDictionaryInitializerForNode(
   };
 }
 
+void StripeStreamsImpl::initDecodedCache() {
+  auto cachedInput =
+      dynamic_cast<const CachedBufferedInput*>(&reader_.getStripeInput());
+  if (cachedInput && cachedInput->cache()->decodedCache()) {
+    decodedCache_ = cachedInput->cache()->decodedCache();
+    fileNum_ = cachedInput->fileNum();
+  }
+}
+
+cache::DecodedCacheKey StripeStreamsImpl::decodedCacheKey(
+    const EncodingKey& ek,
+    cache::DecodedKind kind) const {
+  VELOX_CHECK_NOT_NULL(decodedCache_);
+  return cache::DecodedCacheKey{
+      fileNum_,
+      static_cast<int32_t>(stripeIndex_),
+      static_cast<int32_t>(ek.node),
+      static_cast<int32_t>(ek.sequence),
+      kind};
+}
+
 void StripeStreamsImpl::loadStreams() {
   auto& footer = reader_.getStripeFooter();
 
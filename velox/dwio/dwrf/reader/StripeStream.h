@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/caching/DecodedDataCache.h"
 #include "velox/dwio/common/ColumnSelector.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -157,6 +158,20 @@ class StripeStreams {
 
   // Number of rows per row group. Last row group may have fewer rows.
   virtual uint32_t rowsPerRowGroup() const = 0;
+
+  // Returns the cache for decoded data, e.g. stripe dictionaries, or nullptr
+  // if the file is not read through a cache with a decoded data tier.
+  virtual cache::DecodedDataCache* FOLLY_NULLABLE decodedCache() const {
+    return nullptr;
+  }
+
+  // Returns the key of the decoded data of 'kind' for 'ek' in this
+  // stripe. Only valid if decodedCache() is not nullptr.
+  virtual cache::DecodedCacheKey decodedCacheKey(
+      const EncodingKey& /*ek*/,
+      cache::DecodedKind /*kind*/) const {
+    VELOX_UNREACHABLE();
+  }
 };
 
 class StripeStreamsBase : public StripeStreams {
@@ -197,6 +212,9 @@ class StripeStreamsImpl : public StripeStreamsBase {
   const StrideIndexProvider& provider_;
   const uint32_t stripeIndex_;
   bool readPlanLoaded_;
+  cache::DecodedDataCache* FOLLY_NULLABLE decodedCache_{nullptr};
+  // File number of the file in the cache. Set if 'decodedCache_' is set.
+  uint64_t fileNum_{0};
 
   void loadStreams();
 
@@ -227,6 +245,7 @@ class StripeStreamsImpl : public StripeStreamsBase {
         stripeIndex_{stripeIndex},
         readPlanLoaded_{false} {
     loadStreams();
+    initDecodedCache();
   }
 
   ~StripeStreamsImpl() override = default;
@@ -286,7 +305,19 @@ class StripeStreamsImpl : public StripeStreamsBase {
     return reader_.getReader().getFooter().rowindexstride();
   }
 
+  cache::DecodedDataCache* FOLLY_NULLABLE decodedCache() const override {
+    return decodedCache_;
+  }
+
+  cache::DecodedCacheKey decodedCacheKey(
+      const EncodingKey& ek,
+      cache::DecodedKind kind) const override;
+
  private:
+  // Sets 'decodedCache_' and 'fileNum_' if the stripe is read through a
+  // CachedBufferedInput whose cache has a decoded data tier.
+  void initDecodedCache();
+
   const StreamInformation& getStreamInfo(
       const StreamIdentifier& si,
       const bool throwIfNotFound = true) const {
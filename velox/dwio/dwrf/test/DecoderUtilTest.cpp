@@ -239,3 +239,47 @@ TEST_F(DecoderUtilTest, processFixedWithRun) {
     }
   }
 }
+
+TEST_F(DecoderUtilTest, unpackBigEndian) {
+  constexpr int32_t kNumValues = 100;
+  // 64 bit values plus the 8 bytes that unpackBigEndian may read past the
+  // end and a byte for the bit offset.
+  std::vector<uint8_t> input(kNumValues * 8 + 16);
+  for (auto& byte : input) {
+    byte = folly::Random::rand32(rng_);
+  }
+  // Returns 'width' bits starting 'bit' bits after the most significant bit
+  // of 'input[0]'.
+  auto expected = [&](uint64_t bit, int32_t width) {
+    uint64_t result = 0;
+    for (auto i = 0; i < width; ++i, ++bit) {
+      result = (result << 1) | ((input[bit / 8] >> (7 - bit % 8)) & 1);
+    }
+    return result;
+  };
+  std::vector<uint64_t> result(kNumValues);
+  for (auto level : {simd::SimdLevel::kScalar, simd::SimdLevel::kAvx2}) {
+    if (level > simd::detectedSimdLevel()) {
+      continue;
+    }
+    simd::setSimdLevel(level);
+    for (auto width = 1; width <= 64; ++width) {
+      for (auto bitOffset = 0; bitOffset < 8; ++bitOffset) {
+        for (auto numValues : {1, 4, 5, 99}) {
+          unpackBigEndian(
+              reinterpret_cast<const char*>(input.data()),
+              bitOffset,
+              width,
+              numValues,
+              result.data());
+          for (auto i = 0; i < numValues; ++i) {
+            ASSERT_EQ(expected(bitOffset + i * width, width), result[i])
+                << "width " << width << " offset " << bitOffset << " value "
+                << i << " level " << simd::simdLevelName(level);
+          }
+        }
+      }
+    }
+  }
+  simd::setSimdLevel(simd::detectedSimdLevel());
+}
@@ -34,6 +34,7 @@ class E2EFilterTest : public E2EFilterTestBase {
     auto config = std::make_shared<dwrf::Config>();
     config->set(dwrf::Config::COMPRESSION, dwrf::CompressionKind_NONE);
     config->set(dwrf::Config::USE_VINTS, useVInts_);
+    config->set(dwrf::Config::BLOOM_FILTER_COLS, bloomFilterColumns_);
     WriterOptions options;
     options.config = config;
     options.schema = type;
@@ -62,6 +63,8 @@ class E2EFilterTest : public E2EFilterTestBase {
   }
 
   std::unique_ptr<Writer> writer_;
+  // Top level columns that get row group bloom filters in writeToMemory().
+  std::vector<uint32_t> bloomFilterColumns_;
 };
 
 TEST_F(E2EFilterTest, integerDirect) {
@@ -163,6 +166,25 @@ TEST_F(E2EFilterTest, stringDirect) {
       true);
 }
 
+TEST_F(E2EFilterTest, stringDirectZeroCopy) {
+  flushEveryNBatches_ = 1;
+  zeroCopyStrings_ = true;
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique(Subfield("string_val"));
+        makeStringUnique(Subfield("string_val_2"));
+      },
+      false,
+      {"string_val", "string_val_2"},
+      20,
+      true);
+  // The strings are in decompressed buffers that are kept alive by the
+  // results.
+  EXPECT_LT(0, numStringBufferViews_);
+}
+
 TEST_F(E2EFilterTest, stringDictionary) {
   testWithTypes(
       "string_val:string,"
@@ -237,3 +259,69 @@ TEST_F(E2EFilterTest, lazyStruct) {
       true,
       false);
 }
+
+TEST_F(E2EFilterTest, bloomFilterRowGroupSkip) {
+  constexpr int64_t kMarker = 12345;
+  const StringView kStringMarker("bloom_marker");
+  makeRowType("long_val:bigint, string_val:string", false);
+  filterGenerator = std::make_unique<FilterGenerator>(rowType_, 1);
+
+  // The markers are within the min and max of all row groups, so that only
+  // the bloom filters tell which row groups do not have them.
+  auto testSkip = [&](bool withBloomFilters) {
+    bloomFilterColumns_.clear();
+    if (withBloomFilters) {
+      bloomFilterColumns_ = {0, 1};
+    }
+    makeDataset(
+        [&]() {
+          setRowGroupMarkers<int64_t>(batches_, 0, kMarker);
+          setRowGroupMarkers<StringView>(batches_, 1, kStringMarker);
+        },
+        true);
+
+    for (auto column = 0; column < 2; ++column) {
+      std::vector<uint32_t> hitRows;
+      for (auto i = 0; i < batches_.size(); ++i) {
+        auto child = batches_[i]->childAt(column);
+        for (auto row = 0; row < child->size(); ++row) {
+          if (child->isNullAt(row)) {
+            continue;
+          }
+          bool isHit = column == 0
+              ? child->as<FlatVector<int64_t>>()->valueAt(row) == kMarker
+              : child->as<FlatVector<StringView>>()->valueAt(row) ==
+                  kStringMarker;
+          if (isHit) {
+            hitRows.push_back(batchPosition(i, row));
+          }
+        }
+      }
+      SubfieldFilters filters;
+      if (column == 0) {
+        filters[Subfield("long_val")] =
+            std::make_unique<BigintValuesUsingHashTable>(
+                kMarker,
+                1'000'000'000'000,
+                std::vector<int64_t>{kMarker, 1'000'000'000'000},
+                false);
+      } else {
+        filters[Subfield("string_val")] = std::make_unique<BytesValues>(
+            std::vector<std::string>{std::string(kStringMarker), "other"},
+            false);
+      }
+      auto spec = filterGenerator->makeScanSpec(std::move(filters));
+      uint64_t time = 0;
+      readWithFilter(spec.get(), batches_, hitRows, time, false);
+      if (withBloomFilters) {
+        // Every third row group has no markers.
+        EXPECT_LT(0, runtimeStats_.skippedStrides);
+      } else {
+        EXPECT_EQ(0, runtimeStats_.skippedStrides);
+      }
+    }
+  };
+
+  testSkip(false);
+  testSkip(true);
+}
@@ -216,6 +216,25 @@ void E2EFilterTestBase::readWithoutFilter(
   ASSERT_EQ(rowIndex, 0);
 }
 
+namespace {
+// Returns the number of string buffers in 'vector' and its children that
+// are views over other memory.
+int32_t countStringBufferViews(const BaseVector* vector) {
+  int32_t count = 0;
+  if (auto row = dynamic_cast<const RowVector*>(vector)) {
+    for (auto& child : row->children()) {
+      count += countStringBufferViews(child->loadedVector());
+    }
+  } else if (
+      auto strings = dynamic_cast<const FlatVector<StringView>*>(vector)) {
+    for (auto& buffer : strings->stringBuffers()) {
+      count += buffer->isView();
+    }
+  }
+  return count;
+}
+} // namespace
+
 void E2EFilterTestBase::readWithFilter(
     ScanSpec* spec,
     const std::vector<RowVectorPtr>& batches,
@@ -232,6 +251,7 @@ void E2EFilterTestBase::readWithFilter(
   auto factory = std::make_unique<SelectiveColumnReaderFactory>(spec);
   // The  spec must stay live over the lifetime of the reader.
   rowReaderOpts.setScanSpec(spec);
+  rowReaderOpts.setZeroCopyStrings(zeroCopyStrings_);
   OwnershipChecker ownershipChecker;
   auto rowReader = reader->createRowReader(rowReaderOpts);
   runtimeStats_ = dwio::common::RuntimeStatistics();
@@ -286,6 +306,7 @@ void E2EFilterTestBase::readWithFilter(
     }
     // Check no overwrites after all LazyVectors are loaded.
     ownershipChecker.check(batch);
+    numStringBufferViews_ += countStringBufferViews(batch.get());
   }
   if (!skipCheck) {
     ASSERT_EQ(rowIndex, hitRows.size());
@@ -287,6 +287,11 @@ class E2EFilterTestBase : public testing::Test {
   dwio::common::MemorySink* sinkPtr_;
   std::vector<RowVectorPtr> batches_;
   bool useVInts_ = true;
+  // Sets RowReaderOptions::setZeroCopyStrings() in readWithFilter().
+  bool zeroCopyStrings_ = false;
+  // Number of string buffers in results of readWithFilter() that reference
+  // the read buffers of the file.
+  int32_t numStringBufferViews_{0};
   dwio::common::RuntimeStatistics runtimeStats_;
   // Number of calls to flush policy between starting new stripes.
   int32_t flushEveryNBatches_{10};
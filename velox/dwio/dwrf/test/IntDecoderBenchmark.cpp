@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <fmt/format.h>
 #include <immintrin.h>
 #include <limits>
 #include "folly/Benchmark.h"
@@ -24,6 +25,7 @@
 #include "folly/init/Init.h"
 #include "folly/lang/Bits.h"
 #include "velox/dwio/common/exception/Exception.h"
+#include "velox/dwio/dwrf/common/DecoderUtil.h"
 #include "velox/dwio/dwrf/common/IntCodecCommon.h"
 #include "velox/dwio/dwrf/common/IntDecoder.h"
 
@@ -873,8 +875,62 @@ BENCHMARK_RELATIVE(decodeNew_64) {
       randomInts_u64.size(), buffer_u64.data(), randomInts_u64_result.data());
 }
 
+// Bit packed input of RLEv2. Large enough for kNumPacked 64 bit values.
+constexpr int32_t kNumPacked = 10000;
+std::vector<char> packedBits;
+std::vector<uint64_t> unpackedResult;
+
+// The RLEv2 decoder before unpackBigEndian. Reads the bits of each value
+// one byte at a time.
+void unpackBytewise(const char* input, int32_t bitWidth, uint64_t* result) {
+  uint32_t bitsLeft = 0;
+  uint32_t curByte = 0;
+  for (auto i = 0; i < kNumPacked; ++i) {
+    uint64_t value = 0;
+    uint64_t bitsLeftToRead = bitWidth;
+    while (bitsLeftToRead > bitsLeft) {
+      value <<= bitsLeft;
+      value |= curByte & ((1 << bitsLeft) - 1);
+      bitsLeftToRead -= bitsLeft;
+      curByte = static_cast<unsigned char>(*input++);
+      bitsLeft = 8;
+    }
+    if (bitsLeftToRead > 0) {
+      value <<= bitsLeftToRead;
+      bitsLeft -= static_cast<uint32_t>(bitsLeftToRead);
+      value |= (curByte >> bitsLeft) & ((1 << bitsLeftToRead) - 1);
+    }
+    result[i] = value;
+  }
+}
+
+// Adds a bytewise and a bulk unpack benchmark for each bit width.
+void addUnpackBenchmarks() {
+  packedBits.resize(kNumPacked * 8 + 16);
+  for (auto& byte : packedBits) {
+    byte = folly::Random::rand32();
+  }
+  unpackedResult.resize(kNumPacked);
+  for (auto width = 1; width <= 64; ++width) {
+    folly::addBenchmark(
+        __FILE__, fmt::format("unpackBytewise_{}", width), [width]() {
+          unpackBytewise(packedBits.data(), width, unpackedResult.data());
+          folly::doNotOptimizeAway(unpackedResult[kNumPacked - 1]);
+          return kNumPacked;
+        });
+    folly::addBenchmark(
+        __FILE__, fmt::format("%unpackBigEndian_{}", width), [width]() {
+          unpackBigEndian(
+              packedBits.data(), 0, width, kNumPacked, unpackedResult.data());
+          folly::doNotOptimizeAway(unpackedResult[kNumPacked - 1]);
+          return kNumPacked;
+        });
+  }
+}
+
 int32_t main(int32_t argc, char* argv[]) {
   folly::init(&argc, &argv);
+  addUnpackBenchmarks();
 
   // Populate uint16 buffer
   buffer_u16.resize(kNumElements);
@@ -1124,6 +1124,110 @@ TEST_P(StringReaderTests, testStringDictSkipNoNulls) {
   }
 }
 
+// Consecutive batches from different strides without stride dictionary values
+// must share the base vector of the stripe dictionary. Expressions over the
+// column use the identity of the base vector to reuse results across batches.
+TEST_P(StringReaderTests, stripeDictionarySharedAcrossStrides) {
+  proto::ColumnEncoding directEncoding;
+  directEncoding.set_kind(proto::ColumnEncoding_Kind_DIRECT);
+  EXPECT_CALL(streams, getEncodingProxy(_))
+      .WillRepeatedly(Return(&directEncoding));
+  proto::ColumnEncoding dictionaryEncoding;
+  dictionaryEncoding.set_kind(proto::ColumnEncoding_Kind_DICTIONARY);
+  dictionaryEncoding.set_dictionarysize(4);
+  EXPECT_CALL(streams, getEncodingProxy(1))
+      .WillRepeatedly(Return(&dictionaryEncoding));
+
+  EXPECT_CALL(streams, getStreamProxy(_, proto::Stream_Kind_PRESENT, false))
+      .WillRepeatedly(Return(nullptr));
+  EXPECT_CALL(streams, getStreamProxy(0, proto::Stream_Kind_ROW_INDEX, false))
+      .WillRepeatedly(Return(nullptr));
+
+  // 40 rows in 4 strides, all referring to the stripe dictionary.
+  const int32_t rowIndexStride = 10;
+  const int32_t numRows = 40;
+  proto::RowIndex index;
+  for (auto i = 0; i < numRows / rowIndexStride; ++i) {
+    auto entry = index.add_entry();
+    entry->add_positions(0);
+    entry->add_positions(0);
+    entry->add_positions(0);
+    // Number of stride dictionary values.
+    entry->add_positions(0);
+  }
+
+  char data[1024];
+  data[0] = -numRows;
+  size_t len = 1;
+  for (auto i = 0; i < numRows; ++i) {
+    len = writeVuLong(data, len, i % 4);
+  }
+  const std::vector<std::string> dictVals = {"a", "bb", "ccc", "dddd"};
+  std::string dict;
+  char dictLength[16];
+  dictLength[0] = -4;
+  size_t dictLengthLen = 1;
+  for (const auto& val : dictVals) {
+    dict += val;
+    dictLengthLen = writeVuLong(dictLength, dictLengthLen, val.size());
+  }
+  EXPECT_CALL(streams, getStreamProxy(1, proto::Stream_Kind_DATA, true))
+      .WillRepeatedly(Return(new SeekableArrayInputStream(data, len)));
+  EXPECT_CALL(
+      streams, getStreamProxy(1, proto::Stream_Kind_DICTIONARY_DATA, false))
+      .WillRepeatedly(
+          Return(new SeekableArrayInputStream(dict.data(), dict.size())));
+  EXPECT_CALL(streams, getStreamProxy(1, proto::Stream_Kind_LENGTH, false))
+      .WillRepeatedly(
+          Return(new SeekableArrayInputStream(dictLength, dictLengthLen)));
+  EXPECT_CALL(
+      streams, getStreamProxy(1, proto::Stream_Kind_STRIDE_DICTIONARY, true))
+      .WillRepeatedly(Return(new SeekableArrayInputStream(data, 0)));
+  EXPECT_CALL(
+      streams,
+      getStreamProxy(1, proto::Stream_Kind_STRIDE_DICTIONARY_LENGTH, true))
+      .WillRepeatedly(Return(new SeekableArrayInputStream(data, 0)));
+  // A run of 5 bytes of 0xff, i.e. all 40 values are in the dictionary.
+  const unsigned char inDict[] = {0x02, 0xff};
+  EXPECT_CALL(
+      streams, getStreamProxy(1, proto::Stream_Kind_IN_DICTIONARY, false))
+      .WillRepeatedly(Return(
+          new SeekableArrayInputStream(inDict, VELOX_ARRAY_SIZE(inDict))));
+
+  auto indexData = index.SerializePartialAsString();
+  EXPECT_CALL(streams, getStreamProxy(1, proto::Stream_Kind_ROW_INDEX, _))
+      .WillRepeatedly(Return(
+          new SeekableArrayInputStream(indexData.data(), indexData.size())));
+  TestStrideIndexProvider provider(rowIndexStride);
+  EXPECT_CALL(streams, getStrideIndexProviderProxy())
+      .WillRepeatedly(Return(&provider));
+
+  auto rowType = HiveTypeParser().parse("struct<myString:string>");
+  auto reader = buildReader(rowType, streams, {});
+  VectorPtr batch = newBatch(rowType);
+  VectorPtr dictionaryValues;
+  int32_t rowCount = 0;
+  for (auto stride = 0; stride < numRows / rowIndexStride; ++stride) {
+    reader->next(rowIndexStride, batch);
+    ASSERT_EQ(rowIndexStride, batch->size());
+    auto stringBatch = getOnlyChild<SimpleVector<StringView>>(batch);
+    for (auto i = 0; i < rowIndexStride; ++i) {
+      EXPECT_EQ(dictVals[rowCount % 4], stringBatch->valueAt(i).str());
+      ++rowCount;
+    }
+    if (!returnFlatVector_) {
+      auto dictionary = std::dynamic_pointer_cast<DictionaryVector<StringView>>(
+          stringBatch);
+      ASSERT_TRUE(dictionary != nullptr);
+      if (stride > 0) {
+        EXPECT_EQ(dictionaryValues, dictionary->valueVector());
+      }
+      dictionaryValues = dictionary->valueVector();
+    }
+    provider.addRow(rowIndexStride);
+  }
+}
+
 TEST_P(StringReaderTests, testStringDictSkipWithNulls) {
   // set getEncoding
   proto::ColumnEncoding directEncoding;
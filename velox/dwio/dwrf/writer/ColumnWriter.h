@@ -157,6 +157,29 @@ class ColumnWriter {
     auto options = StatisticsBuilderOptions::fromConfig(context.getConfigs());
     indexStatsBuilder_ = StatisticsBuilder::create(type.type->kind(), options);
     fileStatsBuilder_ = StatisticsBuilder::create(type.type->kind(), options);
+    if (useBloomFilter()) {
+      indexStatsBuilder_->enableBloomFilter();
+      indexBuilder_->enableBloomFilter(
+          newStream(StreamKind::StreamKind_BLOOM_FILTER_UTF8));
+    }
+  }
+
+  // Returns true if row groups of 'this' get a bloom filter. Flat map value
+  // streams do not.
+  bool useBloomFilter() const {
+    switch (type_.type->kind()) {
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::VARCHAR:
+        break;
+      default:
+        return false;
+    }
+    const auto& columns = context_.getConfig(Config::BLOOM_FILTER_COLS);
+    return sequence_ == 0 &&
+        std::find(columns.begin(), columns.end(), type_.column) !=
+        columns.end();
   }
 
   virtual void recordPosition() {
@@ -47,6 +47,18 @@ class IndexBuilder : public PositionRecorder {
     writer.toProto(*stats);
     *index_.add_entry() = entry_;
     entry_.Clear();
+    if (bloomFilterOut_) {
+      auto bloomFilter = bloomFilterIndex_.add_bloomfilter();
+      if (writer.bloomFilter()) {
+        writer.bloomFilter()->toProto(*bloomFilter);
+      }
+    }
+  }
+
+  // Writes a bloom filter for each entry to 'out'. The filters come from the
+  // stats builders passed to addEntry().
+  void enableBloomFilter(std::unique_ptr<BufferedOutputStream> out) {
+    bloomFilterOut_ = std::move(out);
   }
 
   virtual size_t getEntrySize() const {
@@ -61,6 +73,11 @@ class IndexBuilder : public PositionRecorder {
     out_->flush();
     index_.Clear();
     entry_.Clear();
+    if (bloomFilterOut_) {
+      bloomFilterIndex_.SerializeToZeroCopyStream(bloomFilterOut_.get());
+      bloomFilterOut_->flush();
+      bloomFilterIndex_.Clear();
+    }
   }
 
   void capturePresentStreamOffset() {
@@ -89,6 +106,8 @@ class IndexBuilder : public PositionRecorder {
   proto::RowIndex index_;
   proto::RowIndexEntry entry_;
   std::optional<int32_t> presentStreamOffset_;
+  std::unique_ptr<BufferedOutputStream> bloomFilterOut_;
+  proto::BloomFilterIndex bloomFilterIndex_;
 
   proto::RowIndexEntry* getEntry(int32_t index) {
     if (index < 0) {
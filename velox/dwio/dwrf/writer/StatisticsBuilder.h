@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/dwio/dwrf/common/Config.h"
+#include "velox/dwio/dwrf/common/RowGroupBloomFilter.h"
 #include "velox/dwio/dwrf/common/Statistics.h"
 #include "velox/type/Type.h"
 
@@ -103,6 +104,19 @@ class StatisticsBuilder : public virtual dwio::common::ColumnStatistics {
    */
   virtual void reset() {
     init();
+    if (bloomFilter_) {
+      bloomFilter_->reset();
+    }
+  }
+
+  // Makes integer and string builders collect the hashes of added values for
+  // a row group bloom filter. Used for row index stats only.
+  void enableBloomFilter() {
+    bloomFilter_ = std::make_unique<RowGroupBloomFilterBuilder>();
+  }
+
+  const RowGroupBloomFilterBuilder* bloomFilter() const {
+    return bloomFilter_.get();
   }
 
   /*
@@ -122,6 +136,9 @@ class StatisticsBuilder : public virtual dwio::common::ColumnStatistics {
       const Type& type,
       const StatisticsBuilderOptions& options);
 
+ protected:
+  std::unique_ptr<RowGroupBloomFilterBuilder> bloomFilter_;
+
  private:
   void init() {
     valueCount_ = 0;
@@ -184,6 +201,9 @@ class IntegerStatisticsBuilder : public StatisticsBuilder,
       max_ = value;
     }
     addWithOverflowCheck(sum_, value, count);
+    if (bloomFilter_) {
+      bloomFilter_->add(bloomFilterHash(value));
+    }
   }
 
   void merge(const dwio::common::ColumnStatistics& other) override;
@@ -295,6 +315,9 @@ class StringStatisticsBuilder : public StatisticsBuilder,
     }
 
     addWithOverflowCheck<uint64_t>(length_, value.size(), count);
+    if (bloomFilter_) {
+      bloomFilter_->add(bloomFilterHash(value));
+    }
   }
 
   void merge(const dwio::common::ColumnStatistics& other) override;
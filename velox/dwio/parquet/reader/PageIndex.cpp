@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::parquet {
+
+using duckdb_parquet::format::ColumnChunk;
+using duckdb_parquet::format::ColumnIndex;
+using duckdb_parquet::format::ConvertedType;
+using duckdb_parquet::format::OffsetIndex;
+using duckdb_parquet::format::SchemaElement;
+using duckdb_parquet::format::Type;
+
+namespace {
+
+template <typename T>
+T readThrift(char* data, int32_t length) {
+  auto transport =
+      std::make_shared<duckdb_apache::thrift::transport::TMemoryBuffer>(
+          reinterpret_cast<uint8_t*>(data), length);
+  duckdb_apache::thrift::protocol::TCompactProtocolT<
+      duckdb_apache::thrift::transport::TMemoryBuffer>
+      protocol(transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+
+// Decodes a plain encoded min or max value of a page. Returns std::nullopt
+// if 'value' does not have the size of 'T'.
+template <typename T>
+std::optional<T> decodeValue(const std::string& value) {
+  if (value.size() != sizeof(T)) {
+    return std::nullopt;
+  }
+  T result;
+  memcpy(&result, value.data(), sizeof(T));
+  return result;
+}
+
+IntegerOrder integerOrder(const SchemaElement& schema) {
+  if (schema.__isset.logicalType) {
+    const auto& logicalType = schema.logicalType;
+    if (logicalType.__isset.INTEGER) {
+      return logicalType.INTEGER.isSigned ? IntegerOrder::kSigned
+                                          : IntegerOrder::kUnsigned;
+    }
+    return logicalType.__isset.DATE ? IntegerOrder::kSigned
+                                    : IntegerOrder::kNone;
+  }
+  if (!schema.__isset.converted_type) {
+    return IntegerOrder::kSigned;
+  }
+  switch (schema.converted_type) {
+    case ConvertedType::INT_8:
+    case ConvertedType::INT_16:
+    case ConvertedType::INT_32:
+    case ConvertedType::INT_64:
+    case ConvertedType::DATE:
+      return IntegerOrder::kSigned;
+    case ConvertedType::UINT_8:
+    case ConvertedType::UINT_16:
+    case ConvertedType::UINT_32:
+    case ConvertedType::UINT_64:
+      return IntegerOrder::kUnsigned;
+    default:
+      return IntegerOrder::kNone;
+  }
+}
+
+std::optional<int64_t>
+decodeInt(const std::string& value, Type::type type, IntegerOrder order) {
+  switch (type) {
+    case Type::INT32:
+      if (order == IntegerOrder::kUnsigned) {
+        auto result = decodeValue<uint32_t>(value);
+        return result.has_value() ? std::optional<int64_t>(result.value())
+                                  : std::nullopt;
+      }
+      return decodeValue<int32_t>(value);
+    case Type::INT64:
+      if (order == IntegerOrder::kUnsigned) {
+        // Values over the int64_t range are negative as signed values.
+        auto result = decodeValue<uint64_t>(value);
+        return result.has_value() &&
+                result.value() <= std::numeric_limits<int64_t>::max()
+            ? std::optional<int64_t>(result.value())
+            : std::nullopt;
+      }
+      return decodeValue<int64_t>(value);
+    default:
+      return std::nullopt;
+  }
+}
+
+// Returns the min and max of the integer values of a page, or std::nullopt
+// for both if they do not bound the values as Velox compares them.
+std::pair<std::optional<int64_t>, std::optional<int64_t>> decodeIntRange(
+    const std::string& min,
+    const std::string& max,
+    Type::type type,
+    IntegerOrder order) {
+  if (order == IntegerOrder::kNone) {
+    return {std::nullopt, std::nullopt};
+  }
+  auto minValue = decodeInt(min, type, order);
+  auto maxValue = decodeInt(max, type, order);
+  if (order == IntegerOrder::kUnsigned && !maxValue.has_value()) {
+    // Values over the int64_t range make the page also hold negative values.
+    return {std::nullopt, std::nullopt};
+  }
+  return {minValue, maxValue};
+}
+
+std::optional<double> decodeDouble(const std::string& value, Type::type type) {
+  std::optional<double> result;
+  switch (type) {
+    case Type::FLOAT:
+      result = decodeValue<float>(value);
+      break;
+    case Type::DOUBLE:
+      result = decodeValue<double>(value);
+      break;
+    default:
+      break;
+  }
+  if (result.has_value() && std::isnan(result.value())) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+} // namespace
+
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right) {
+  std::vector<RowRange> result;
+  auto l = left.begin();
+  auto r = right.begin();
+  while (l != left.end() && r != right.end()) {
+    auto begin = std::max(l->begin, r->begin);
+    auto end = std::min(l->end, r->end);
+    if (begin < end) {
+      result.push_back({begin, end});
+    }
+    if (l->end < r->end) {
+      ++l;
+    } else {
+      ++r;
+    }
+  }
+  return result;
+}
+
+PageIndex::PageIndex(
+    ColumnIndex columnIndex,
+    OffsetIndex offsetIndex,
+    const SchemaElement& schema,
+    int64_t numRows)
+    : columnIndex_(std::move(columnIndex)),
+      offsetIndex_(std::move(offsetIndex)),
+      physicalType_(schema.type),
+      integerOrder_(integerOrder(schema)),
+      numRows_(numRows) {
+  auto numPages = offsetIndex_.page_locations.size();
+  VELOX_CHECK_EQ(columnIndex_.null_pages.size(), numPages);
+  VELOX_CHECK_EQ(columnIndex_.min_values.size(), numPages);
+  VELOX_CHECK_EQ(columnIndex_.max_values.size(), numPages);
+  VELOX_CHECK(
+      !columnIndex_.__isset.null_counts ||
+      columnIndex_.null_counts.size() == numPages);
+}
+
+// static
+std::vector<std::unique_ptr<PageIndex>> PageIndex::read(
+    const std::vector<PageIndexChunk>& chunks,
+    ::duckdb::FileHandle& file,
+    int32_t maxCoalesceDistance) {
+  // The byte ranges of the column and offset indexes, each with the chunk it
+  // belongs to.
+  struct IndexRange {
+    int64_t offset;
+    int32_t length;
+    int32_t chunk;
+    bool isOffsetIndex;
+  };
+  std::vector<IndexRange> ranges;
+  for (auto i = 0; i < chunks.size(); ++i) {
+    const auto& chunk = *chunks[i].chunk;
+    if (!chunk.__isset.column_index_offset ||
+        !chunk.__isset.offset_index_offset ||
+        chunk.column_index_length <= 0 || chunk.offset_index_length <= 0) {
+      continue;
+    }
+    ranges.push_back(
+        {chunk.column_index_offset, chunk.column_index_length, i, false});
+    ranges.push_back(
+        {chunk.offset_index_offset, chunk.offset_index_length, i, true});
+  }
+  std::sort(ranges.begin(), ranges.end(), [](const auto& a, const auto& b) {
+    return a.offset < b.offset;
+  });
+
+  std::vector<ColumnIndex> columnIndexes(chunks.size());
+  std::vector<OffsetIndex> offsetIndexes(chunks.size());
+  std::string buffer;
+  for (auto first = 0; first < ranges.size();) {
+    // Reads the ranges that are less than 'maxCoalesceDistance' apart in one
+    // read.
+    const auto start = ranges[first].offset;
+    auto end = start + ranges[first].length;
+    auto last = first + 1;
+    for (; last < ranges.size(); ++last) {
+      if (ranges[last].offset - end >= maxCoalesceDistance) {
+        break;
+      }
+      end = std::max(end, ranges[last].offset + ranges[last].length);
+    }
+    buffer.resize(end - start);
+    file.Read(buffer.data(), buffer.size(), start);
+    for (auto i = first; i < last; ++i) {
+      auto data = buffer.data() + ranges[i].offset - start;
+      if (ranges[i].isOffsetIndex) {
+        offsetIndexes[ranges[i].chunk] =
+            readThrift<OffsetIndex>(data, ranges[i].length);
+      } else {
+        columnIndexes[ranges[i].chunk] =
+            readThrift<ColumnIndex>(data, ranges[i].length);
+      }
+    }
+    first = last;
+  }
+
+  std::vector<std::unique_ptr<PageIndex>> result(chunks.size());
+  for (const auto& range : ranges) {
+    if (range.isOffsetIndex) {
+      result[range.chunk] = std::make_unique<PageIndex>(
+          std::move(columnIndexes[range.chunk]),
+          std::move(offsetIndexes[range.chunk]),
+          *chunks[range.chunk].schema,
+          chunks[range.chunk].numRows);
+    }
+  }
+  return result;
+}
+
+int64_t PageIndex::pageNumRows(int32_t page) const {
+  const auto& locations = offsetIndex_.page_locations;
+  auto end = page + 1 < locations.size() ? locations[page + 1].first_row_index
+                                         : numRows_;
+  return end - locations[page].first_row_index;
+}
+
+std::unique_ptr<dwio::common::ColumnStatistics> PageIndex::pageStatistics(
+    int32_t page,
+    const TypePtr& type) const {
+  auto numRows = pageNumRows(page);
+  if (columnIndex_.null_pages[page]) {
+    return std::make_unique<dwio::common::ColumnStatistics>(
+        0, true, std::nullopt, std::nullopt);
+  }
+  std::optional<uint64_t> numValues;
+  std::optional<bool> hasNull;
+  if (columnIndex_.__isset.null_counts) {
+    auto numNulls = columnIndex_.null_counts[page];
+    numValues = numRows - numNulls;
+    hasNull = numNulls > 0;
+  }
+  const auto& min = columnIndex_.min_values[page];
+  const auto& max = columnIndex_.max_values[page];
+  switch (type->kind()) {
+    case TypeKind::BIGINT:
+    case TypeKind::INTEGER:
+    case TypeKind::SMALLINT:
+    case TypeKind::TINYINT: {
+      auto [minValue, maxValue] =
+          decodeIntRange(min, max, physicalType_, integerOrder_);
+      return std::make_unique<dwio::common::IntegerColumnStatistics>(
+          numValues,
+          hasNull,
+          std::nullopt,
+          std::nullopt,
+          minValue,
+          maxValue,
+          std::nullopt);
+    }
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return std::make_unique<dwio::common::DoubleColumnStatistics>(
+          numValues,
+          hasNull,
+          std::nullopt,
+          std::nullopt,
+          decodeDouble(min, physicalType_),
+          decodeDouble(max, physicalType_),
+          std::nullopt);
+    case TypeKind::VARCHAR:
+      if (physicalType_ == Type::BYTE_ARRAY) {
+        return std::make_unique<dwio::common::StringColumnStatistics>(
+            numValues,
+            hasNull,
+            std::nullopt,
+            std::nullopt,
+            min,
+            max,
+            std::nullopt);
+      }
+      break;
+    default:
+      break;
+  }
+  return std::make_unique<dwio::common::ColumnStatistics>(
+      numValues, hasNull, std::nullopt, std::nullopt);
+}
+
+std::vector<RowRange> PageIndex::filterPages(
+    common::Filter& filter,
+    const TypePtr& type) const {
+  std::vector<RowRange> ranges;
+  for (auto page = 0; page < numPages(); ++page) {
+    auto stats = pageStatistics(page, type);
+    auto numRows = pageNumRows(page);
+    if (!common::testFilter(&filter, stats.get(), numRows, type)) {
+      continue;
+    }
+    auto begin = offsetIndex_.page_locations[page].first_row_index;
+    if (!ranges.empty() && ranges.back().end == begin) {
+      ranges.back().end = begin + numRows;
+    } else {
+      ranges.push_back({begin, begin + numRows});
+    }
+  }
+  return ranges;
+}
+
+} // namespace facebook::velox::parquet
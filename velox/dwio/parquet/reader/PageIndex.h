@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/Macros.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/common/Statistics.h"
+VELOX_SUPPRESS_DEPRECATION_WARNING
+#include "velox/external/duckdb/parquet-amalgamation.hpp"
+VELOX_UNSUPPRESS_DEPRECATION_WARNING
+
+namespace facebook::velox::parquet {
+
+// Half open range of row numbers in a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+
+  bool operator==(const RowRange& other) const {
+    return begin == other.begin && end == other.end;
+  }
+};
+
+// Returns the rows that are in both 'left' and 'right'. The ranges in both
+// are sorted and do not overlap.
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right);
+
+// How the min and max values of an integer column are ordered, which
+// follows from its logical type.
+enum class IntegerOrder {
+  kSigned,
+  // Unsigned logical types, whose values Velox holds as signed integers.
+  kUnsigned,
+  // Logical types whose values are not plain integers, e.g. decimals.
+  kNone,
+};
+
+// A column chunk whose page index to read.
+struct PageIndexChunk {
+  const duckdb_parquet::format::ColumnChunk* chunk;
+  // The schema element of the column of 'chunk'. Gives the logical type.
+  const duckdb_parquet::format::SchemaElement* schema;
+  // Number of rows in the row group of 'chunk'.
+  int64_t numRows;
+};
+
+// Min and max values and row ranges of the pages of a column chunk. These
+// come from the ColumnIndex and OffsetIndex structures that Parquet writers
+// place after the row groups.
+class PageIndex {
+ public:
+  PageIndex(
+      duckdb_parquet::format::ColumnIndex columnIndex,
+      duckdb_parquet::format::OffsetIndex offsetIndex,
+      const duckdb_parquet::format::SchemaElement& schema,
+      int64_t numRows);
+
+  // Reads the page indexes of 'chunks' from 'file'. The page indexes of all
+  // row groups are together after the row groups, so indexes less than
+  // 'maxCoalesceDistance' bytes apart are read in one read. Returns nullptr
+  // for the chunks for which the writer did not make a page index.
+  static std::vector<std::unique_ptr<PageIndex>> read(
+      const std::vector<PageIndexChunk>& chunks,
+      ::duckdb::FileHandle& file,
+      int32_t maxCoalesceDistance);
+
+  int32_t numPages() const {
+    return offsetIndex_.page_locations.size();
+  }
+
+  // Returns the rows of the pages whose min, max and null count do not rule
+  // out values that pass 'filter'. 'type' is the Velox type of the column.
+  std::vector<RowRange> filterPages(
+      common::Filter& filter,
+      const TypePtr& type) const;
+
+ private:
+  // Returns the statistics of 'page' in the form used for filtering row
+  // groups.
+  std::unique_ptr<dwio::common::ColumnStatistics> pageStatistics(
+      int32_t page,
+      const TypePtr& type) const;
+
+  int64_t pageNumRows(int32_t page) const;
+
+  const duckdb_parquet::format::ColumnIndex columnIndex_;
+  const duckdb_parquet::format::OffsetIndex offsetIndex_;
+  const duckdb_parquet::format::Type::type physicalType_;
+  const IntegerOrder integerOrder_;
+  const int64_t numRows_;
+};
+
+} // namespace facebook::velox::parquet
@@ -17,6 +17,7 @@
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/duckdb/conversion/DuckConversion.h"
 #include "velox/duckdb/conversion/DuckWrapper.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/Statistics.h"
 
 namespace facebook::velox::parquet {
@@ -221,6 +222,7 @@ ParquetRowReader::ParquetRowReader(
 
   std::vector<::duckdb::column_t> columnIds;
   columnIds.reserve(rowType_->size());
+  std::vector<ColumnFilter> columnFilters;
   for (uint64_t i = 0; i < projection.size(); i++) {
     uint64_t columnId = projection[i].column;
     VELOX_CHECK_LT(
@@ -239,6 +241,8 @@ ParquetRowReader::ParquetRowReader(
       auto veloxFilter = findFilter(projection[i].name, options.getScanSpec());
       if (veloxFilter) {
         toDuckDbFilter(i, duckDbType, veloxFilter.value(), filters_);
+        columnFilters.push_back(
+            {columnId, veloxFilter.value(), rowType_->childAt(i)});
       }
     }
   }
@@ -251,11 +255,73 @@ ParquetRowReader::ParquetRowReader(
       groups.push_back(i);
     }
   }
+  if (!columnFilters.empty()) {
+    pruneRowGroups(columnFilters, groups);
+  }
 
   reader_->InitializeScan(
       state_, std::move(columnIds), std::move(groups), &filters_);
 }
 
+void ParquetRowReader::pruneRowGroups(
+    const std::vector<ColumnFilter>& columnFilters,
+    std::vector<::duckdb::idx_t>& groups) {
+  auto metadata = reader_->GetFileMetadata();
+  // The column chunks and the leaf schema elements match the columns only if
+  // there are no nested columns.
+  auto isFlat = [&](const auto& rowGroup) {
+    return rowGroup.columns.size() == reader_->names.size() &&
+        metadata->schema.size() == reader_->names.size() + 1;
+  };
+  // The page indexes of the filtered columns of all row groups are read
+  // together.
+  std::vector<PageIndexChunk> chunks;
+  for (auto group : groups) {
+    const auto& rowGroup = metadata->row_groups[group];
+    if (!isFlat(rowGroup)) {
+      continue;
+    }
+    for (const auto& columnFilter : columnFilters) {
+      chunks.push_back(
+          {&rowGroup.columns[columnFilter.columnId],
+           &metadata->schema[columnFilter.columnId + 1],
+           rowGroup.num_rows});
+    }
+  }
+  auto pageIndexes = PageIndex::read(
+      chunks,
+      *reader_->file_handle,
+      dwio::common::ReaderOptions::kDefaultCoalesceDistance);
+
+  std::vector<::duckdb::idx_t> result;
+  result.reserve(groups.size());
+  int32_t chunkIndex = 0;
+  for (auto group : groups) {
+    const auto& rowGroup = metadata->row_groups[group];
+    if (!isFlat(rowGroup)) {
+      result.push_back(group);
+      continue;
+    }
+    std::vector<RowRange> rows{{0, rowGroup.num_rows}};
+    for (auto i = 0; i < columnFilters.size() && !rows.empty(); ++i) {
+      const auto& pageIndex = pageIndexes[chunkIndex + i];
+      if (pageIndex) {
+        rows = intersectRowRanges(
+            rows,
+            pageIndex->filterPages(
+                *columnFilters[i].filter, columnFilters[i].type));
+      }
+    }
+    chunkIndex += columnFilters.size();
+    if (rows.empty()) {
+      ++skippedRowGroups_;
+    } else {
+      result.push_back(group);
+    }
+  }
+  groups = std::move(result);
+}
+
 uint64_t ParquetRowReader::next(uint64_t /*size*/, velox::VectorPtr& result) {
   ::duckdb::DataChunk output;
   output.Initialize(duckdbRowType_);
@@ -292,7 +358,9 @@ uint64_t ParquetRowReader::next(uint64_t /*size*/, velox::VectorPtr& result) {
 }
 
 void ParquetRowReader::updateRuntimeStats(
-    dwio::common::RuntimeStatistics& /*stats*/) const {}
+    dwio::common::RuntimeStatistics& stats) const {
+  stats.skippedStrides += skippedRowGroups_;
+}
 
 void ParquetRowReader::resetFilterCaches() {
   // No filter caches to reset.
@@ -45,6 +45,21 @@ class ParquetRowReader : public dwio::common::RowReader {
   std::optional<size_t> estimatedRowSize() const override;
 
  private:
+  // A filter on a projected column.
+  struct ColumnFilter {
+    uint64_t columnId;
+    common::Filter* filter;
+    TypePtr type;
+  };
+
+  // Removes the row groups from 'groups' where the page index of a column in
+  // 'columnFilters' shows that no page has rows that pass the filter. Row
+  // group statistics cannot show this if the values that pass fall between
+  // the pages.
+  void pruneRowGroups(
+      const std::vector<ColumnFilter>& columnFilters,
+      std::vector<::duckdb::idx_t>& groups);
+
   ::duckdb::TableFilterSet filters_;
   std::shared_ptr<::duckdb::ParquetReader> reader_;
   ::duckdb::ParquetReaderScanState state_;
@@ -52,6 +67,8 @@ class ParquetRowReader : public dwio::common::RowReader {
   RowTypePtr rowType_;
   std::vector<::duckdb::LogicalType> duckdbRowType_;
   velox::common::ScanSpec* scanSpec_;
+  // Number of row groups dropped by pruneRowGroups().
+  int64_t skippedRowGroups_{0};
 };
 
 class ParquetReader : public dwio::common::Reader {
@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+#include "velox/dwio/common/MemoryInputStream.h"
+#include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/dwio/parquet/reader/duckdb/InputStreamFileSystem.h"
+#include "velox/type/tests/FilterBuilder.h"
+#include "velox/vector/ComplexVector.h"
+
+#include <gtest/gtest.h>
+#include <numeric>
+
+using namespace facebook::velox;
+using namespace facebook::velox::common::test;
+using namespace facebook::velox::parquet;
+
+using duckdb_parquet::format::ColumnChunk;
+using duckdb_parquet::format::ColumnIndex;
+using duckdb_parquet::format::ColumnMetaData;
+using duckdb_parquet::format::CompressionCodec;
+using duckdb_parquet::format::ConvertedType;
+using duckdb_parquet::format::DataPageHeader;
+using duckdb_parquet::format::Encoding;
+using duckdb_parquet::format::FieldRepetitionType;
+using duckdb_parquet::format::FileMetaData;
+using duckdb_parquet::format::OffsetIndex;
+using duckdb_parquet::format::PageHeader;
+using duckdb_parquet::format::PageLocation;
+using duckdb_parquet::format::PageType;
+using duckdb_parquet::format::RowGroup;
+using duckdb_parquet::format::SchemaElement;
+using ParquetType = duckdb_parquet::format::Type;
+
+namespace {
+
+template <typename T>
+std::string serialize(const T& thrift) {
+  auto transport =
+      std::make_shared<duckdb_apache::thrift::transport::TMemoryBuffer>();
+  duckdb_apache::thrift::protocol::TCompactProtocolT<
+      duckdb_apache::thrift::transport::TMemoryBuffer>
+      protocol(transport);
+  thrift.write(&protocol);
+  return transport->getBufferAsString();
+}
+
+template <typename T>
+std::string encode(T value) {
+  return std::string(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Returns a Parquet file with a required BIGINT column 'c0'. Each element of
+// 'rowGroups' has the pages of a row group and each page its values. The
+// column chunks have a page index but no statistics, so that only the page
+// index can prune row groups.
+std::string makeParquetFile(
+    const std::vector<std::vector<std::vector<int64_t>>>& rowGroups) {
+  std::string file = "PAR1";
+  FileMetaData metadata;
+  SchemaElement root;
+  root.__set_name("schema");
+  root.__set_num_children(1);
+  SchemaElement column;
+  column.__set_type(ParquetType::INT64);
+  column.__set_repetition_type(FieldRepetitionType::REQUIRED);
+  column.__set_name("c0");
+  metadata.__set_schema({root, column});
+
+  std::vector<ColumnIndex> columnIndexes;
+  std::vector<OffsetIndex> offsetIndexes;
+  int64_t numRows = 0;
+  for (const auto& pages : rowGroups) {
+    const int64_t chunkOffset = file.size();
+    ColumnIndex columnIndex;
+    OffsetIndex offsetIndex;
+    int64_t groupRows = 0;
+    for (const auto& values : pages) {
+      std::string data(
+          reinterpret_cast<const char*>(values.data()),
+          values.size() * sizeof(int64_t));
+      DataPageHeader dataPageHeader;
+      dataPageHeader.__set_num_values(values.size());
+      dataPageHeader.__set_encoding(Encoding::PLAIN);
+      dataPageHeader.__set_definition_level_encoding(Encoding::RLE);
+      dataPageHeader.__set_repetition_level_encoding(Encoding::RLE);
+      PageHeader header;
+      header.__set_type(PageType::DATA_PAGE);
+      header.__set_uncompressed_page_size(data.size());
+      header.__set_compressed_page_size(data.size());
+      header.__set_data_page_header(dataPageHeader);
+
+      PageLocation location;
+      location.__set_offset(file.size());
+      file += serialize(header) + data;
+      location.__set_compressed_page_size(file.size() - location.offset);
+      location.__set_first_row_index(groupRows);
+      offsetIndex.page_locations.push_back(location);
+      columnIndex.null_pages.push_back(false);
+      columnIndex.min_values.push_back(
+          encode(*std::min_element(values.begin(), values.end())));
+      columnIndex.max_values.push_back(
+          encode(*std::max_element(values.begin(), values.end())));
+      groupRows += values.size();
+    }
+    const int64_t chunkSize = file.size() - chunkOffset;
+    ColumnMetaData columnMetadata;
+    columnMetadata.__set_type(ParquetType::INT64);
+    columnMetadata.__set_encodings({Encoding::PLAIN});
+    columnMetadata.__set_path_in_schema({"c0"});
+    columnMetadata.__set_codec(CompressionCodec::UNCOMPRESSED);
+    columnMetadata.__set_num_values(groupRows);
+    columnMetadata.__set_total_uncompressed_size(chunkSize);
+    columnMetadata.__set_total_compressed_size(chunkSize);
+    columnMetadata.__set_data_page_offset(chunkOffset);
+    ColumnChunk chunk;
+    chunk.__set_file_offset(chunkOffset);
+    chunk.__set_meta_data(columnMetadata);
+    RowGroup rowGroup;
+    rowGroup.__set_columns({chunk});
+    rowGroup.__set_total_byte_size(chunkSize);
+    rowGroup.__set_num_rows(groupRows);
+    rowGroup.__set_file_offset(chunkOffset);
+    metadata.row_groups.push_back(rowGroup);
+    columnIndexes.push_back(columnIndex);
+    offsetIndexes.push_back(offsetIndex);
+    numRows += groupRows;
+  }
+
+  // Like writers, puts the column indexes and then the offset indexes of all
+  // row groups after the row groups.
+  for (auto i = 0; i < rowGroups.size(); ++i) {
+    auto& chunk = metadata.row_groups[i].columns[0];
+    auto serialized = serialize(columnIndexes[i]);
+    chunk.__set_column_index_offset(file.size());
+    chunk.__set_column_index_length(serialized.size());
+    file += serialized;
+  }
+  for (auto i = 0; i < rowGroups.size(); ++i) {
+    auto& chunk = metadata.row_groups[i].columns[0];
+    auto serialized = serialize(offsetIndexes[i]);
+    chunk.__set_offset_index_offset(file.size());
+    chunk.__set_offset_index_length(serialized.size());
+    file += serialized;
+  }
+
+  metadata.__set_version(1);
+  metadata.__set_num_rows(numRows);
+  auto footer = serialize(metadata);
+  file += footer + encode<uint32_t>(footer.size()) + "PAR1";
+  return file;
+}
+
+std::vector<int64_t> iota(int64_t begin, int64_t end) {
+  std::vector<int64_t> values(end - begin);
+  std::iota(values.begin(), values.end(), begin);
+  return values;
+}
+
+} // namespace
+
+class PageIndexTest : public testing::Test {
+ protected:
+  static constexpr int64_t kRowsPerPage = 100;
+
+  // Writes a ColumnIndex with 'minValues', 'maxValues' and 'nullCounts' and
+  // an OffsetIndex with pages of kRowsPerPage rows to 'file_' and reads them
+  // back. 'convertedType' is the logical type of the column if set.
+  std::unique_ptr<PageIndex> makePageIndex(
+      ParquetType::type physicalType,
+      const std::vector<std::string>& minValues,
+      const std::vector<std::string>& maxValues,
+      const std::vector<int64_t>& nullCounts,
+      std::optional<ConvertedType::type> convertedType = std::nullopt) {
+    ColumnIndex columnIndex;
+    OffsetIndex offsetIndex;
+    for (auto i = 0; i < minValues.size(); ++i) {
+      columnIndex.null_pages.push_back(nullCounts[i] == kRowsPerPage);
+      PageLocation location;
+      location.__set_offset(i * 1000);
+      location.__set_compressed_page_size(1000);
+      location.__set_first_row_index(i * kRowsPerPage);
+      offsetIndex.page_locations.push_back(location);
+    }
+    columnIndex.__set_min_values(minValues);
+    columnIndex.__set_max_values(maxValues);
+    columnIndex.__set_null_counts(nullCounts);
+
+    file_ = serialize(columnIndex);
+    ColumnChunk chunk;
+    chunk.meta_data.__set_type(physicalType);
+    chunk.__set_column_index_offset(0);
+    chunk.__set_column_index_length(file_.size());
+    auto serializedOffsetIndex = serialize(offsetIndex);
+    chunk.__set_offset_index_offset(file_.size());
+    chunk.__set_offset_index_length(serializedOffsetIndex.size());
+    file_ += serializedOffsetIndex;
+
+    SchemaElement schema;
+    schema.__set_type(physicalType);
+    if (convertedType.has_value()) {
+      schema.__set_converted_type(convertedType.value());
+    }
+    facebook::velox::duckdb::InputStreamFileSystem fileSystem(
+        std::make_unique<dwio::common::MemoryInputStream>(
+            file_.data(), file_.size()));
+    auto pageIndexes = PageIndex::read(
+        {{&chunk,
+          &schema,
+          kRowsPerPage * static_cast<int64_t>(minValues.size())}},
+        *fileSystem.OpenFile(),
+        dwio::common::ReaderOptions::kDefaultCoalesceDistance);
+    return std::move(pageIndexes[0]);
+  }
+
+  std::string file_;
+};
+
+TEST_F(PageIndexTest, intersectRowRanges) {
+  std::vector<RowRange> left{{0, 100}, {200, 300}, {400, 500}};
+  std::vector<RowRange> right{{50, 250}, {290, 410}};
+  std::vector<RowRange> expected{{50, 100}, {200, 250}, {290, 300}, {400, 410}};
+  EXPECT_EQ(expected, intersectRowRanges(left, right));
+  EXPECT_EQ(expected, intersectRowRanges(right, left));
+  EXPECT_TRUE(intersectRowRanges(left, {{100, 200}}).empty());
+  EXPECT_TRUE(intersectRowRanges(left, {}).empty());
+}
+
+TEST_F(PageIndexTest, bigint) {
+  // The values of the 4 pages are [0, 99], [100, 199], [300, 399] and [400,
+  // 499]. The last page has nulls.
+  auto pageIndex = makePageIndex(
+      ParquetType::INT64,
+      {encode<int64_t>(0),
+       encode<int64_t>(100),
+       encode<int64_t>(300),
+       encode<int64_t>(400)},
+      {encode<int64_t>(99),
+       encode<int64_t>(199),
+       encode<int64_t>(399),
+       encode<int64_t>(499)},
+      {0, 0, 0, 10});
+  ASSERT_TRUE(pageIndex != nullptr);
+  EXPECT_EQ(4, pageIndex->numPages());
+
+  // Adjacent pages make one range.
+  std::vector<RowRange> expected{{100, 300}};
+  EXPECT_EQ(expected, pageIndex->filterPages(*between(150, 350), BIGINT()));
+
+  // The values are between the pages.
+  EXPECT_TRUE(pageIndex->filterPages(*between(250, 260), BIGINT()).empty());
+
+  expected = {{0, 100}, {300, 400}};
+  EXPECT_EQ(expected, pageIndex->filterPages(*in({50, 450}), BIGINT()));
+
+  expected = {{300, 400}};
+  EXPECT_EQ(expected, pageIndex->filterPages(*isNull(), BIGINT()));
+}
+
+TEST_F(PageIndexTest, int32AndNullPages) {
+  auto pageIndex = makePageIndex(
+      ParquetType::INT32,
+      {encode<int32_t>(-10), "", encode<int32_t>(10)},
+      {encode<int32_t>(0), "", encode<int32_t>(20)},
+      {5, kRowsPerPage, 0});
+  ASSERT_TRUE(pageIndex != nullptr);
+
+  std::vector<RowRange> expected{{200, 300}};
+  EXPECT_EQ(expected, pageIndex->filterPages(*equal(15), INTEGER()));
+
+  expected = {{0, 200}};
+  EXPECT_EQ(expected, pageIndex->filterPages(*isNull(), INTEGER()));
+
+  // Nulls pass, so the pages with nulls pass.
+  expected = {{0, 300}};
+  EXPECT_EQ(
+      expected, pageIndex->filterPages(*between(15, 30, true), INTEGER()));
+}
+
+TEST_F(PageIndexTest, varchar) {
+  auto pageIndex = makePageIndex(
+      ParquetType::BYTE_ARRAY, {"apple", "melon"}, {"kiwi", "pear"}, {0, 0});
+  ASSERT_TRUE(pageIndex != nullptr);
+
+  std::vector<RowRange> expected{{100, 200}};
+  EXPECT_EQ(expected, pageIndex->filterPages(*equal("orange"), VARCHAR()));
+  EXPECT_TRUE(pageIndex->filterPages(*equal("lemon"), VARCHAR()).empty());
+
+  expected = {{0, 100}};
+  EXPECT_EQ(
+      expected, pageIndex->filterPages(*in({"fig", "plum"}), VARCHAR()));
+}
+
+TEST_F(PageIndexTest, unsignedTypes) {
+  // UINT_64 values are ordered as unsigned. A page with values over the
+  // int64_t range also holds negative values as Velox sees them.
+  auto pageIndex = makePageIndex(
+      ParquetType::INT64,
+      {encode<uint64_t>(10), encode<uint64_t>(10)},
+      {encode<uint64_t>(20), encode<uint64_t>(1ULL << 63)},
+      {0, 0},
+      ConvertedType::UINT_64);
+  ASSERT_TRUE(pageIndex != nullptr);
+  std::vector<RowRange> expected{{100, 200}};
+  EXPECT_EQ(expected, pageIndex->filterPages(*lessThan(0), BIGINT()));
+  expected = {{0, 200}};
+  EXPECT_EQ(expected, pageIndex->filterPages(*equal(15), BIGINT()));
+
+  // UINT_32 values over the int32_t range are decoded as positive.
+  pageIndex = makePageIndex(
+      ParquetType::INT32,
+      {encode<uint32_t>(1U << 31)},
+      {encode<uint32_t>(3U << 30)},
+      {0},
+      ConvertedType::UINT_32);
+  ASSERT_TRUE(pageIndex != nullptr);
+  EXPECT_TRUE(pageIndex->filterPages(*lessThan(0), BIGINT()).empty());
+  expected = {{0, 100}};
+  EXPECT_EQ(
+      expected, pageIndex->filterPages(*equal(int64_t{1} << 31), BIGINT()));
+
+  // Decimals are not compared as integers.
+  pageIndex = makePageIndex(
+      ParquetType::INT64,
+      {encode<int64_t>(10)},
+      {encode<int64_t>(20)},
+      {0},
+      ConvertedType::DECIMAL);
+  ASSERT_TRUE(pageIndex != nullptr);
+  EXPECT_EQ(expected, pageIndex->filterPages(*equal(100), BIGINT()));
+}
+
+TEST_F(PageIndexTest, noPageIndex) {
+  ColumnChunk chunk;
+  SchemaElement schema;
+  facebook::velox::duckdb::InputStreamFileSystem fileSystem(
+      std::make_unique<dwio::common::MemoryInputStream>(nullptr, 0));
+  auto pageIndexes = PageIndex::read(
+      {{&chunk, &schema, 100}},
+      *fileSystem.OpenFile(),
+      dwio::common::ReaderOptions::kDefaultCoalesceDistance);
+  ASSERT_EQ(1, pageIndexes.size());
+  EXPECT_EQ(nullptr, pageIndexes[0]);
+}
+
+TEST_F(PageIndexTest, pruneRowGroups) {
+  // Row group 0 has pages with [0, 99] and [200, 299] and row group 1 pages
+  // with [100, 149] and [150, 199]. The min and max of row group 0 cover the
+  // filter but none of its pages do.
+  auto file = makeParquetFile(
+      {{iota(0, 100), iota(200, 300)}, {iota(100, 150), iota(150, 200)}});
+  ParquetReader reader(
+      std::make_unique<dwio::common::MemoryInputStream>(
+          file.data(), file.size()),
+      dwio::common::ReaderOptions());
+  EXPECT_EQ(reader.numberOfRows(), 400ULL);
+
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  common::ScanSpec scanSpec("");
+  auto columnSpec = scanSpec.getOrCreateChild(common::Subfield("c0"));
+  columnSpec->setProjectOut(true);
+  columnSpec->setChannel(0);
+  columnSpec->setFilter(between(140, 160));
+  dwio::common::RowReaderOptions rowReaderOpts;
+  rowReaderOpts.select(std::make_shared<dwio::common::ColumnSelector>(
+      rowType, rowType->names()));
+  rowReaderOpts.setScanSpec(&scanSpec);
+  auto rowReader = reader.createRowReader(rowReaderOpts);
+
+  std::vector<int64_t> values;
+  VectorPtr result;
+  while (rowReader->next(1'000, result) > 0) {
+    auto column =
+        result->as<RowVector>()->childAt(0)->as<SimpleVector<int64_t>>();
+    for (auto i = 0; i < result->size(); ++i) {
+      values.push_back(column->valueAt(i));
+    }
+  }
+  EXPECT_EQ(iota(140, 161), values);
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_EQ(1, stats.skippedStrides);
+}
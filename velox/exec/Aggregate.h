@@ -65,7 +65,17 @@ class Aggregate {
     return true;
   }
 
-  void setAllocator(HashStringAllocator* allocator) {
+  // Returns true if addIntermediateResults() of an instance created for raw
+  // input accepts the results of extractAccumulators() of such an instance,
+  // e.g. because the accumulator does not depend on the raw input types. A
+  // partial aggregation can then be compacted by adding its groups back, see
+  // QueryConfig::kPartialAggregationCompactionPct. Aggregates with a single
+  // input of their intermediate type do not need to override this.
+  virtual bool acceptsOwnIntermediateResults() const {
+    return false;
+  }
+
+  virtual void setAllocator(HashStringAllocator* allocator) {
     allocator_ = allocator;
   }
 
@@ -77,7 +87,7 @@ class Aggregate {
   // the row. Only applies to accumulators that store variable size data out of
   // line. Fixed length accumulators do not use this. 0 if the row does not have
   // a size field.
-  void setOffsets(
+  virtual void setOffsets(
       int32_t offset,
       int32_t nullByte,
       uint8_t nullMask,
@@ -206,6 +216,16 @@ class Aggregate {
       const std::vector<TypePtr>& argTypes,
       const TypePtr& resultType);
 
+  // Same as create() but the aggregate only sees the distinct values of its
+  // single argument within each group, e.g. count(distinct x). The distinct
+  // values are kept per group next to the accumulator, so this supports only
+  // the kSingle step.
+  static std::unique_ptr<Aggregate> createDistinct(
+      const std::string& name,
+      core::AggregationNode::Step step,
+      const std::vector<TypePtr>& argTypes,
+      const TypePtr& resultType);
+
  protected:
   // Shorthand for maintaining accumulator variable length size in
   // accumulator update methods. Use like: { auto tracker =
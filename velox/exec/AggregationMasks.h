@@ -36,6 +36,10 @@ class AggregationMasks {
   const SelectivityVector* FOLLY_NULLABLE
   activeRows(int32_t aggregationIndex) const;
 
+  const std::vector<std::optional<ChannelIndex>>& maskChannels() const {
+    return maskChannels_;
+  }
+
  private:
   std::vector<std::optional<ChannelIndex>> maskChannels_;
   std::unordered_map<ChannelIndex, SelectivityVector> maskedRows_;
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unordered_set>
+
+#include "velox/common/memory/HashStringAllocator.h"
+#include "velox/exec/Aggregate.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+// Distinct values of the argument of a DISTINCT aggregate seen so far in a
+// group. The set and the out of line parts of its strings are allocated from
+// the HashStringAllocator of the group rows.
+template <typename T>
+struct DistinctAccumulator {
+  using Set = std::unordered_set<
+      T,
+      folly::hasher<T>,
+      std::equal_to<T>,
+      StlAllocator<T>>;
+
+  explicit DistinctAccumulator(HashStringAllocator* allocator)
+      : values(
+            0,
+            folly::hasher<T>(),
+            std::equal_to<T>(),
+            StlAllocator<T>(allocator)) {}
+
+  Set values;
+  bool hasNull{false};
+};
+
+// Wraps an aggregate so that it sees the first occurrence of each distinct
+// argument value in a group, e.g. count(distinct x). The accumulator of the
+// wrapped aggregate follows the DistinctAccumulator on the group row and
+// shares its null flag.
+template <typename T>
+class DistinctAggregate : public Aggregate {
+ public:
+  explicit DistinctAggregate(std::unique_ptr<Aggregate> aggregate)
+      : Aggregate(aggregate->resultType()), aggregate_(std::move(aggregate)) {}
+
+  int32_t accumulatorFixedWidthSize() const override {
+    return kDistinctSize + aggregate_->accumulatorFixedWidthSize();
+  }
+
+  // The set of distinct values is allocated outside of the group row.
+  bool accumulatorUsesExternalMemory() const override {
+    return true;
+  }
+
+  bool isFixedSize() const override {
+    return false;
+  }
+
+  void setAllocator(HashStringAllocator* allocator) override {
+    Aggregate::setAllocator(allocator);
+    aggregate_->setAllocator(allocator);
+  }
+
+  void setOffsets(
+      int32_t offset,
+      int32_t nullByte,
+      uint8_t nullMask,
+      int32_t rowSizeOffset) override {
+    Aggregate::setOffsets(offset, nullByte, nullMask, rowSizeOffset);
+    aggregate_->setOffsets(
+        offset + kDistinctSize, nullByte, nullMask, rowSizeOffset);
+  }
+
+  void initializeNewGroups(
+      char** groups,
+      folly::Range<const vector_size_t*> indices) override {
+    for (auto index : indices) {
+      new (groups[index] + offset_) DistinctAccumulator<T>(allocator_);
+    }
+    aggregate_->initializeNewGroups(groups, indices);
+  }
+
+  void addRawInput(
+      char** groups,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*mayPushdown*/) override {
+    decodedArg_.decode(*args[0], rows);
+    distinctRows_.resize(rows.size());
+    distinctRows_.clearAll();
+    rows.applyToSelected([&](vector_size_t row) {
+      if (addValue(groups[row], row)) {
+        distinctRows_.setValid(row, true);
+      }
+    });
+    distinctRows_.updateBounds();
+    if (distinctRows_.hasSelections()) {
+      aggregate_->addRawInput(groups, distinctRows_, args, false);
+    }
+  }
+
+  void addSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*mayPushdown*/) override {
+    decodedArg_.decode(*args[0], rows);
+    distinctRows_.resize(rows.size());
+    distinctRows_.clearAll();
+    rows.applyToSelected([&](vector_size_t row) {
+      if (addValue(group, row)) {
+        distinctRows_.setValid(row, true);
+      }
+    });
+    distinctRows_.updateBounds();
+    if (distinctRows_.hasSelections()) {
+      aggregate_->addSingleGroupRawInput(group, distinctRows_, args, false);
+    }
+  }
+
+  void addIntermediateResults(
+      char** /*groups*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/,
+      bool /*mayPushdown*/) override {
+    VELOX_UNSUPPORTED("DISTINCT aggregates do not take intermediate results");
+  }
+
+  void addSingleGroupIntermediateResults(
+      char* /*group*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/,
+      bool /*mayPushdown*/) override {
+    VELOX_UNSUPPORTED("DISTINCT aggregates do not take intermediate results");
+  }
+
+  void finalize(char** groups, int32_t numGroups) override {
+    aggregate_->finalize(groups, numGroups);
+  }
+
+  void extractValues(char** groups, int32_t numGroups, VectorPtr* result)
+      override {
+    aggregate_->extractValues(groups, numGroups, result);
+  }
+
+  void extractAccumulators(
+      char** /*groups*/,
+      int32_t /*numGroups*/,
+      VectorPtr* /*result*/) override {
+    VELOX_UNSUPPORTED(
+        "DISTINCT aggregates do not produce intermediate results");
+  }
+
+  void destroy(folly::Range<char**> groups) override {
+    for (auto group : groups) {
+      auto accumulator = value<DistinctAccumulator<T>>(group);
+      if constexpr (std::is_same_v<T, StringView>) {
+        for (const auto& string : accumulator->values) {
+          if (!string.isInline()) {
+            allocator_->free(HashStringAllocator::headerOf(string.data()));
+          }
+        }
+      }
+      accumulator->~DistinctAccumulator<T>();
+    }
+    aggregate_->destroy(groups);
+  }
+
+ private:
+  static constexpr int32_t kDistinctSize = sizeof(DistinctAccumulator<T>);
+  static_assert(kDistinctSize % sizeof(void*) == 0);
+
+  // Adds the value of 'decodedArg_' at 'row' to the distinct values of
+  // 'group'. Returns true if the value was not seen before.
+  bool addValue(char* group, vector_size_t row) {
+    auto accumulator = value<DistinctAccumulator<T>>(group);
+    if (decodedArg_.isNullAt(row)) {
+      if (accumulator->hasNull) {
+        return false;
+      }
+      accumulator->hasNull = true;
+      return true;
+    }
+    auto tracker = trackRowSize(group);
+    auto value = decodedArg_.valueAt<T>(row);
+    if constexpr (std::is_same_v<T, StringView>) {
+      if (value.isInline()) {
+        return accumulator->values.insert(value).second;
+      }
+      if (accumulator->values.count(value)) {
+        return false;
+      }
+      auto header = allocator_->allocate(value.size());
+      memcpy(header->begin(), value.data(), value.size());
+      accumulator->values.insert(StringView(header->begin(), value.size()));
+      return true;
+    } else {
+      return accumulator->values.insert(value).second;
+    }
+  }
+
+  const std::unique_ptr<Aggregate> aggregate_;
+  DecodedVector decodedArg_;
+  // Rows of the current input that bring a new value to their group.
+  SelectivityVector distinctRows_;
+};
+
+template <typename T>
+std::unique_ptr<Aggregate> makeDistinct(std::unique_ptr<Aggregate> aggregate) {
+  return std::make_unique<DistinctAggregate<T>>(std::move(aggregate));
+}
+
+} // namespace
+
+std::unique_ptr<Aggregate> Aggregate::createDistinct(
+    const std::string& name,
+    core::AggregationNode::Step step,
+    const std::vector<TypePtr>& argTypes,
+    const TypePtr& resultType) {
+  VELOX_USER_CHECK(
+      step == core::AggregationNode::Step::kSingle,
+      "DISTINCT aggregate {} requires a single aggregation step, got {}",
+      name,
+      core::AggregationNode::stepName(step));
+  VELOX_USER_CHECK_EQ(
+      argTypes.size(),
+      1,
+      "DISTINCT aggregate {} must have exactly one argument",
+      name);
+  auto aggregate = create(name, step, argTypes, resultType);
+  switch (argTypes[0]->kind()) {
+    case TypeKind::BOOLEAN:
+      return makeDistinct<bool>(std::move(aggregate));
+    case TypeKind::TINYINT:
+      return makeDistinct<int8_t>(std::move(aggregate));
+    case TypeKind::SMALLINT:
+      return makeDistinct<int16_t>(std::move(aggregate));
+    case TypeKind::INTEGER:
+      return makeDistinct<int32_t>(std::move(aggregate));
+    case TypeKind::BIGINT:
+      return makeDistinct<int64_t>(std::move(aggregate));
+    case TypeKind::REAL:
+      return makeDistinct<float>(std::move(aggregate));
+    case TypeKind::DOUBLE:
+      return makeDistinct<double>(std::move(aggregate));
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return makeDistinct<StringView>(std::move(aggregate));
+    case TypeKind::TIMESTAMP:
+      return makeDistinct<Timestamp>(std::move(aggregate));
+    case TypeKind::DATE:
+      return makeDistinct<Date>(std::move(aggregate));
+    default:
+      VELOX_USER_FAIL(
+          "Unsupported argument type for DISTINCT aggregate {}: {}",
+          name,
+          argTypes[0]->toString());
+  }
+}
+
+} // namespace facebook::velox::exec
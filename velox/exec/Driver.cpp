@@ -449,6 +449,7 @@ void Driver::initializeOperatorStats(std::vector<OperatorStats>& stats) {
 
 void Driver::addStatsToTask() {
   for (auto& op : operators_) {
+    op->recordVectorPoolStats();
     auto& stats = op->stats();
     stats.memoryStats.update(op->pool()->getMemoryUsageTracker());
     stats.numDrivers = 1;
@@ -604,6 +605,8 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kWaitForJoinBuild";
     case BlockingReason::kWaitForMemory:
       return "kWaitForMemory";
+    case BlockingReason::kWaitForPeers:
+      return "kWaitForPeers";
   }
   VELOX_UNREACHABLE();
   return "";
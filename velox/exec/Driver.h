@@ -124,7 +124,8 @@ enum class BlockingReason {
   kWaitForSplit,
   kWaitForExchange,
   kWaitForJoinBuild,
-  kWaitForMemory
+  kWaitForMemory,
+  kWaitForPeers
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -317,7 +317,7 @@ RowVectorPtr Exchange::getOutput() {
   }
 
   VectorStreamGroup::read(
-      inputStream_.get(), operatorCtx_->pool(), outputType_, &result_);
+      inputStream_.get(), operatorCtx_->pool(), outputType_, &result_, serde_);
 
   stats_.inputPositions += result_->size();
   stats_.inputBytes += result_->retainedSize();
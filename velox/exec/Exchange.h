@@ -312,7 +312,8 @@ class Exchange : public SourceOperator {
             exchangeNode->id(),
             "Exchange"),
         planNodeId_(exchangeNode->id()),
-        exchangeClient_(std::move(exchangeClient)) {}
+        exchangeClient_(std::move(exchangeClient)),
+        serde_(getNamedVectorSerde(ctx->queryConfig().shuffleSerde())) {}
 
   ~Exchange() override {
     close();
@@ -349,6 +350,9 @@ class Exchange : public SourceOperator {
 
   RowVectorPtr result_;
   std::shared_ptr<ExchangeClient> exchangeClient_;
+  // Serde the producing PartitionedOutput wrote the pages with. nullptr for
+  // the default serde.
+  VectorSerde* const serde_;
   std::unique_ptr<SerializedPage> currentPage_;
   std::unique_ptr<ByteStream> inputStream_;
   bool atEnd_{false};
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/GroupId.h"
+
+namespace facebook::velox::exec {
+
+GroupId::GroupId(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::GroupIdNode>& groupIdNode)
+    : Operator(
+          driverCtx,
+          groupIdNode->outputType(),
+          operatorId,
+          groupIdNode->id(),
+          "GroupId") {
+  const auto& inputType = groupIdNode->sources()[0]->outputType();
+
+  std::unordered_map<std::string, ChannelIndex> keyChannels;
+  for (const auto& info : groupIdNode->groupingKeyInfos()) {
+    keyChannels[info.output] = exprToChannel(info.input.get(), inputType);
+  }
+
+  const auto numGroupingKeys = groupIdNode->groupingKeyInfos().size();
+  groupingKeyMappings_.reserve(groupIdNode->groupingSets().size());
+  for (const auto& groupingSet : groupIdNode->groupingSets()) {
+    std::vector<ChannelIndex> mappings(numGroupingKeys, kConstantChannel);
+    for (const auto& key : groupingSet) {
+      mappings[outputType_->getChildIdx(key)] = keyChannels.at(key);
+    }
+    groupingKeyMappings_.push_back(std::move(mappings));
+  }
+
+  for (const auto& input : groupIdNode->aggregationInputs()) {
+    aggregationInputs_.push_back(exprToChannel(input.get(), inputType));
+  }
+}
+
+void GroupId::addInput(RowVectorPtr input) {
+  // The output batches for all grouping sets share the input columns. Load
+  // lazy vectors here so that consumers see loaded vectors for all rows.
+  for (auto& child : input->children()) {
+    child->loadedVector();
+  }
+  input_ = std::move(input);
+  groupingSetIndex_ = 0;
+}
+
+RowVectorPtr GroupId::getOutput() {
+  if (!input_) {
+    return nullptr;
+  }
+
+  auto numInput = input_->size();
+  const auto& mappings = groupingKeyMappings_[groupingSetIndex_];
+
+  std::vector<VectorPtr> outputColumns(outputType_->size());
+  for (auto i = 0; i < mappings.size(); ++i) {
+    if (mappings[i] == kConstantChannel) {
+      outputColumns[i] = BaseVector::createNullConstant(
+          outputType_->childAt(i), numInput, pool());
+    } else {
+      outputColumns[i] = input_->childAt(mappings[i]);
+    }
+  }
+
+  for (auto i = 0; i < aggregationInputs_.size(); ++i) {
+    outputColumns[mappings.size() + i] =
+        input_->childAt(aggregationInputs_[i]);
+  }
+
+  outputColumns.back() = BaseVector::createConstant(
+      static_cast<int64_t>(groupingSetIndex_), numInput, pool());
+
+  ++groupingSetIndex_;
+  if (groupingSetIndex_ == groupingKeyMappings_.size()) {
+    input_ = nullptr;
+  }
+
+  return std::make_shared<RowVector>(
+      pool(),
+      outputType_,
+      BufferPtr(nullptr),
+      numInput,
+      std::move(outputColumns));
+}
+
+} // namespace facebook::velox::exec
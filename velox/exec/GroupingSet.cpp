@@ -46,7 +46,8 @@ GroupingSet::GroupingSet(
     std::vector<std::vector<VectorPtr>>&& constantLists,
     bool ignoreNullKeys,
     bool isRawInput,
-    OperatorCtx* operatorCtx)
+    OperatorCtx* operatorCtx,
+    uint8_t numPartitionBits)
     : preGroupedKeyChannels_(std::move(preGroupedKeys)),
       hashers_(std::move(hashers)),
       isGlobal_(hashers_.empty()),
@@ -61,10 +62,42 @@ GroupingSet::GroupingSet(
       rows_(mappedMemory_),
       isAdaptive_(
           operatorCtx->task()->queryCtx()->config().hashAdaptivityEnabled()),
-      execCtx_(*operatorCtx->execCtx()) {
+      execCtx_(*operatorCtx->execCtx()),
+      numPartitionBits_(numPartitionBits),
+      partitionBits_(64 - numPartitionBits, 64) {
   for (auto& hasher : hashers_) {
     keyChannels_.push_back(hasher->channel());
   }
+  if (isPartitioned()) {
+    VELOX_CHECK(!isGlobal_, "Global aggregation cannot be partitioned");
+    VELOX_CHECK(
+        preGroupedKeyChannels_.empty(),
+        "Aggregation with pre-grouped keys cannot be partitioned");
+    for (auto& hasher : hashers_) {
+      partitionHashers_.push_back(
+          VectorHasher::create(hasher->type(), hasher->channel()));
+    }
+    partitionRows_.resize(partitionBits_.numPartitions());
+    // The buffered input keeps only the columns that aggregating reads.
+    std::vector<ChannelIndex> channels = keyChannels_;
+    for (const auto& argList : channelLists_) {
+      channels.insert(channels.end(), argList.begin(), argList.end());
+    }
+    for (const auto& mask : masks_.maskChannels()) {
+      if (mask.has_value()) {
+        channels.push_back(mask.value());
+      }
+    }
+    for (auto channel : channels) {
+      if (channel == kConstantChannel) {
+        continue;
+      }
+      if (channel >= partitionedInputChannels_.size()) {
+        partitionedInputChannels_.resize(channel + 1, false);
+      }
+      partitionedInputChannels_[channel] = true;
+    }
+  }
   std::unordered_map<ChannelIndex, int> channelUseCount;
   for (const std::vector<ChannelIndex>& argList : channelLists_) {
     for (ChannelIndex channel : argList) {
@@ -122,9 +155,98 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   activeRows_.resize(numRows);
   activeRows_.setAll();
 
+  if (isPartitioned()) {
+    addPartitionedInput(input);
+    return;
+  }
   addInputForActiveRows(input, mayPushdown);
 }
 
+void GroupingSet::addPartitionedInput(const RowVectorPtr& input) {
+  if (ignoreNullKeys_) {
+    deselectRowsWithNulls(*input, keyChannels_, activeRows_, execCtx_);
+  }
+  if (!activeRows_.hasSelections()) {
+    return;
+  }
+  // The input is aggregated after the producer has moved on. Lazy vectors
+  // may not be loadable by then. The columns that are not read are replaced
+  // by null constants, so that the channels stay the same and the buffered
+  // input does not retain them.
+  std::vector<VectorPtr> children(input->childrenSize());
+  for (auto i = 0; i < children.size(); ++i) {
+    if (i < partitionedInputChannels_.size() && partitionedInputChannels_[i]) {
+      children[i] = input->loadedChildAt(i);
+    } else {
+      children[i] = BaseVector::createNullConstant(
+          input->type()->childAt(i), input->size(), execCtx_.pool());
+    }
+  }
+  auto buffered = std::make_shared<RowVector>(
+      execCtx_.pool(),
+      input->type(),
+      BufferPtr(nullptr),
+      input->size(),
+      std::move(children));
+  partitionHashes_.resize(input->size());
+  for (auto i = 0; i < partitionHashers_.size(); ++i) {
+    auto& key = buffered->childAt(partitionHashers_[i]->channel());
+    partitionHashers_[i]->hash(*key, activeRows_, i > 0, partitionHashes_);
+  }
+  uint64_t inputIndex = partitionedInput_.size();
+  auto numPartitions = partitionBits_.numPartitions();
+  activeRows_.applyToSelected([&](auto row) {
+    auto partition =
+        partitionBits_.partition(partitionHashes_[row], numPartitions);
+    partitionRows_[partition].push_back((inputIndex << 32) | row);
+  });
+  partitionedInputBytes_ += buffered->retainedSize();
+  partitionedInput_.push_back(std::move(buffered));
+  partitionRowsBytes_ = 0;
+  for (const auto& rows : partitionRows_) {
+    partitionRowsBytes_ += rows.capacity() * sizeof(uint64_t);
+  }
+}
+
+bool GroupingSet::aggregateNextPartition() {
+  if (!isPartitioned()) {
+    return false;
+  }
+  for (; nextPartition_ < partitionRows_.size(); ++nextPartition_) {
+    if (!partitionRows_[nextPartition_].empty()) {
+      break;
+    }
+  }
+  if (nextPartition_ == partitionRows_.size()) {
+    partitionedInput_.clear();
+    partitionedInputBytes_ = 0;
+    return false;
+  }
+  if (table_) {
+    table_->clear();
+  }
+  auto& rows = partitionRows_[nextPartition_];
+  int32_t begin = 0;
+  while (begin < rows.size()) {
+    auto inputIndex = rows[begin] >> 32;
+    auto& input = partitionedInput_[inputIndex];
+    activeRows_.resize(input->size());
+    activeRows_.clearAll();
+    int32_t end = begin;
+    for (; end < rows.size() && rows[end] >> 32 == inputIndex; ++end) {
+      activeRows_.setValid(static_cast<uint32_t>(rows[end]), true);
+    }
+    activeRows_.updateBounds();
+    addInputForActiveRows(input, false);
+    begin = end;
+  }
+  // Frees the row numbers of the partition.
+  partitionRowsBytes_ -= rows.capacity() * sizeof(uint64_t);
+  std::vector<uint64_t>().swap(rows);
+  ++nextPartition_;
+  return true;
+}
+
 void GroupingSet::noMoreInput() {
   noMoreInput_ = true;
 
@@ -140,6 +262,39 @@ bool GroupingSet::hasOutput() {
 void GroupingSet::addInputForActiveRows(
     const RowVectorPtr& input,
     bool mayPushdown) {
+  if (ignoreNullKeys_) {
+    // A null in any of the keys disables the row.
+    deselectRowsWithNulls(*input, keyChannels_, activeRows_, execCtx_);
+  }
+  std::vector<VectorPtr> keys;
+  keys.reserve(keyChannels_.size());
+  for (auto channel : keyChannels_) {
+    keys.push_back(input->loadedChildAt(channel));
+  }
+  probeGroups(keys, input->size());
+  masks_.addInput(input, activeRows_);
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    const auto& rows = getSelectivityVector(i);
+    populateTempVectors(i, input);
+    // TODO(spershin): We disable the pushdown at the moment if selectivity
+    // vector has changed after groups generation, we might want to revisit
+    // this.
+    const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
+        mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
+    if (isRawInput_) {
+      aggregates_[i]->addRawInput(
+          lookup_->hits.data(), rows, tempVectors_, canPushdown);
+    } else {
+      aggregates_[i]->addIntermediateResults(
+          lookup_->hits.data(), rows, tempVectors_, canPushdown);
+    }
+  }
+  tempVectors_.clear();
+}
+
+void GroupingSet::probeGroups(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t numRows) {
   bool rehash = false;
   if (!table_) {
     rehash = true;
@@ -148,29 +303,14 @@ void GroupingSet::addInputForActiveRows(
   auto& hashers = lookup_->hashers;
   lookup_->reset(activeRows_.end());
   auto mode = table_->hashMode();
-  if (ignoreNullKeys_) {
-    // A null in any of the keys disables the row.
-    deselectRowsWithNulls(*input, keyChannels_, activeRows_, execCtx_);
-    for (int32_t i = 0; i < hashers.size(); ++i) {
-      auto key = input->loadedChildAt(hashers[i]->channel());
-      if (mode != BaseHashTable::HashMode::kHash) {
-        if (!hashers[i]->computeValueIds(*key, activeRows_, lookup_->hashes)) {
-          rehash = true;
-        }
-      } else {
-        hashers[i]->hash(*key, activeRows_, i > 0, lookup_->hashes);
-      }
-    }
-  } else {
-    for (int32_t i = 0; i < hashers.size(); ++i) {
-      auto key = input->loadedChildAt(hashers[i]->channel());
-      if (mode != BaseHashTable::HashMode::kHash) {
-        if (!hashers[i]->computeValueIds(*key, activeRows_, lookup_->hashes)) {
-          rehash = true;
-        }
-      } else {
-        hashers[i]->hash(*key, activeRows_, i > 0, lookup_->hashes);
+  for (int32_t i = 0; i < hashers.size(); ++i) {
+    if (mode != BaseHashTable::HashMode::kHash) {
+      if (!hashers[i]->computeValueIds(
+              *keys[i], activeRows_, lookup_->hashes)) {
+        rehash = true;
       }
+    } else {
+      hashers[i]->hash(*keys[i], activeRows_, i > 0, lookup_->hashes);
     }
   }
 
@@ -186,30 +326,12 @@ void GroupingSet::addInputForActiveRows(
 
   if (rehash) {
     if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
-      table_->decideHashMode(input->size());
+      table_->decideHashMode(numRows);
     }
-    addInputForActiveRows(input, mayPushdown);
+    probeGroups(keys, numRows);
     return;
   }
   table_->groupProbe(*lookup_);
-  masks_.addInput(input, activeRows_);
-  for (auto i = 0; i < aggregates_.size(); ++i) {
-    const auto& rows = getSelectivityVector(i);
-    populateTempVectors(i, input);
-    // TODO(spershin): We disable the pushdown at the moment if selectivity
-    // vector has changed after groups generation, we might want to revisit
-    // this.
-    const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
-        mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
-    if (isRawInput_) {
-      aggregates_[i]->addRawInput(
-          lookup_->hits.data(), rows, tempVectors_, canPushdown);
-    } else {
-      aggregates_[i]->addIntermediateResults(
-          lookup_->hits.data(), rows, tempVectors_, canPushdown);
-    }
-  }
-  tempVectors_.clear();
 }
 
 void GroupingSet::addRemainingInput() {
@@ -367,6 +489,10 @@ bool GroupingSet::getOutput(
   char* groups[batchSize];
   int32_t numGroups =
       table_ ? table_->rows()->listRows(iterator, batchSize, groups) : 0;
+  while (!numGroups && noMoreInput_ && aggregateNextPartition()) {
+    iterator->reset();
+    numGroups = table_->rows()->listRows(iterator, batchSize, groups);
+  }
   if (!numGroups) {
     if (table_) {
       table_->clear();
@@ -402,12 +528,70 @@ void GroupingSet::resetPartial() {
 
 uint64_t GroupingSet::allocatedBytes() const {
   if (table_) {
-    return table_->allocatedBytes();
+    return table_->allocatedBytes() + partitionedInputBytes_ +
+        partitionRowsBytes_;
+  }
+  if (isPartitioned()) {
+    return partitionedInputBytes_ + partitionRowsBytes_;
   }
 
   return stringAllocator_.retainedSize() + rows_.allocatedBytes();
 }
 
+uint64_t GroupingSet::reclaimableBytes() const {
+  if (!table_) {
+    return 0;
+  }
+  return table_->rows()->stringAllocator().freeBytes();
+}
+
+void GroupingSet::compact(const RowTypePtr& intermediateType) {
+  VELOX_CHECK(!isGlobal_, "Global aggregation cannot be compacted");
+  VELOX_CHECK(
+      preGroupedKeyChannels_.empty(),
+      "Aggregation with pre-grouped keys cannot be compacted");
+  VELOX_CHECK(!isPartitioned(), "Partitioned aggregation cannot be compacted");
+  if (!table_ || table_->rows()->numRows() == 0) {
+    return;
+  }
+
+  // Copies the keys and accumulators out of the table. After the last batch,
+  // getOutput() clears the table, which frees its rows and variable length
+  // data.
+  constexpr int32_t kBatchSize = 1024;
+  std::vector<RowVectorPtr> groups;
+  RowContainerIterator iterator;
+  for (;;) {
+    auto batch = std::static_pointer_cast<RowVector>(
+        BaseVector::create(intermediateType, kBatchSize, execCtx_.pool()));
+    if (!getOutput(kBatchSize, true, &iterator, batch)) {
+      break;
+    }
+    groups.push_back(std::move(batch));
+  }
+
+  // Adds the groups back. The accumulators are recreated from their
+  // intermediate results in new, contiguous memory.
+  auto numKeys = keyChannels_.size();
+  std::vector<VectorPtr> keys(numKeys);
+  for (auto& batch : groups) {
+    activeRows_.resize(batch->size());
+    activeRows_.setAll();
+    for (auto i = 0; i < numKeys; ++i) {
+      keys[i] = batch->childAt(i);
+    }
+    probeGroups(keys, batch->size());
+    for (auto i = 0; i < aggregates_.size(); ++i) {
+      aggregates_[i]->addIntermediateResults(
+          lookup_->hits.data(),
+          activeRows_,
+          {batch->childAt(numKeys + i)},
+          false);
+    }
+    batch.reset();
+  }
+}
+
 const HashLookup& GroupingSet::hashLookup() const {
   return *lookup_;
 }
@@ -17,6 +17,7 @@
 
 #include "velox/exec/AggregationMasks.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/Spiller.h"
 #include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::exec {
@@ -25,6 +26,12 @@ class Aggregate;
 
 class GroupingSet {
  public:
+  /// If 'numPartitionBits' is not 0, the input is not aggregated as it
+  /// arrives but is buffered in 2^numPartitionBits partitions by the hash of
+  /// the grouping keys. After noMoreInput(), getOutput() aggregates and
+  /// returns one partition at a time, so that the hash table only holds the
+  /// groups of one partition. Only supported without pre-grouped keys and for
+  /// aggregations that produce output after all input.
   GroupingSet(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       std::vector<ChannelIndex>&& preGroupedKeys,
@@ -34,7 +41,8 @@ class GroupingSet {
       std::vector<std::vector<VectorPtr>>&& constantLists,
       bool ignoreNullKeys,
       bool isRawInput,
-      OperatorCtx* driverCtx);
+      OperatorCtx* driverCtx,
+      uint8_t numPartitionBits = 0);
 
   void addInput(const RowVectorPtr& input, bool mayPushdown);
 
@@ -58,6 +66,19 @@ class GroupingSet {
 
   uint64_t allocatedBytes() const;
 
+  /// Returns the part of allocatedBytes() that compact() gives back. This is
+  /// the variable length memory freed by accumulators, e.g. when a variable
+  /// width accumulator outgrows its allocation.
+  uint64_t reclaimableBytes() const;
+
+  /// Moves the groups to new memory without the space that is no longer
+  /// live. The keys and accumulators are extracted as intermediate results of
+  /// type 'intermediateType', the table is cleared and the groups are added
+  /// back with Aggregate::addIntermediateResults(). Needs memory for a copy of
+  /// the live data while running. Not supported for global, pre-grouped or
+  /// partitioned aggregations.
+  void compact(const RowTypePtr& intermediateType);
+
   void resetPartial();
 
   const HashLookup& hashLookup() const;
@@ -65,6 +86,11 @@ class GroupingSet {
  private:
   void addInputForActiveRows(const RowVectorPtr& input, bool mayPushdown);
 
+  // Computes hashes or value ids for the 'activeRows_' of 'keys' and looks up
+  // or creates the groups in the hash table. 'keys' has one vector per
+  // grouping key. Sets 'lookup_->hits' to the groups.
+  void probeGroups(const std::vector<VectorPtr>& keys, vector_size_t numRows);
+
   void addRemainingInput();
 
   void initializeGlobalAggregation();
@@ -79,6 +105,17 @@ class GroupingSet {
 
   void createHashTable();
 
+  bool isPartitioned() const {
+    return numPartitionBits_ > 0;
+  }
+
+  // Adds the rows of 'input' to the partitions of their grouping keys.
+  void addPartitionedInput(const RowVectorPtr& input);
+
+  // Clears the hash table and aggregates the next non-empty partition into
+  // it. Returns false if there are no more partitions.
+  bool aggregateNextPartition();
+
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
   // If the given aggregation has mask, the method returns reference to the
@@ -138,6 +175,40 @@ class GroupingSet {
   /// The value of mayPushdown flag specified in addInput() for the
   /// 'remainingInput_'.
   bool remainingMayPushdown_;
+
+  const uint8_t numPartitionBits_;
+
+  /// Selects the partition of a row from the high bits of the hash of its
+  /// keys. The hash table indexes with the low bits.
+  const HashBitRange partitionBits_;
+
+  /// Compute the hashes for partitioning. Separate from the hashers of the
+  /// hash table, which may make value ids instead of hashes.
+  std::vector<std::unique_ptr<VectorHasher>> partitionHashers_;
+
+  raw_vector<uint64_t> partitionHashes_;
+
+  /// True for the input channels that are grouping keys, aggregate
+  /// arguments or masks. The other columns of the input are not buffered.
+  std::vector<bool> partitionedInputChannels_;
+
+  /// Input added in partitioned mode. Kept until all partitions are
+  /// aggregated.
+  std::vector<RowVectorPtr> partitionedInput_;
+
+  /// For each partition, the rows of 'partitionedInput_' in the partition.
+  /// The high 32 bits are the index in 'partitionedInput_' and the low 32 bits
+  /// are the row number. Rows are in input order.
+  std::vector<std::vector<uint64_t>> partitionRows_;
+
+  /// Retained size of 'partitionedInput_'.
+  uint64_t partitionedInputBytes_{0};
+
+  /// Capacity of 'partitionRows_' in bytes, 8 per buffered row.
+  uint64_t partitionRowsBytes_{0};
+
+  /// The partition aggregateNextPartition() aggregates next.
+  int32_t nextPartition_{0};
 };
 
 } // namespace facebook::velox::exec
@@ -38,7 +38,8 @@ HashAggregation::HashAggregation(
       isDistinct_(aggregationNode->aggregates().empty()),
       isGlobal_(aggregationNode->groupingKeys().empty()),
       hasPreGroupedKeys_(!aggregationNode->preGroupedKeys().empty()) {
-  auto inputType = aggregationNode->sources()[0]->outputType();
+  inputType_ = aggregationNode->sources()[0]->outputType();
+  const auto& inputType = inputType_;
 
   auto numHashers = aggregationNode->groupingKeys().size();
   std::vector<std::unique_ptr<VectorHasher>> hashers;
@@ -95,8 +96,13 @@ HashAggregation::HashAggregation(
     }
 
     const auto& resultType = outputType_->childAt(numHashers + i);
-    aggregates.push_back(Aggregate::create(
-        aggregate->name(), aggregationNode->step(), argTypes, resultType));
+    if (aggregationNode->isDistinctAggregate(i)) {
+      aggregates.push_back(Aggregate::createDistinct(
+          aggregate->name(), aggregationNode->step(), argTypes, resultType));
+    } else {
+      aggregates.push_back(Aggregate::create(
+          aggregate->name(), aggregationNode->step(), argTypes, resultType));
+    }
     args.push_back(channels);
     constantLists.push_back(constants);
   }
@@ -119,6 +125,71 @@ HashAggregation::HashAggregation(
     }
   }
 
+  numDrivers_ = driverCtx->task->numPipelineDrivers(driverCtx->pipelineId);
+  // The merge is between the drivers of one split group. 'driverId' counts
+  // across split groups in grouped execution.
+  partitionId_ = driverCtx->partitionId;
+  mergeDrivers_ =
+      aggregationNode->step() == core::AggregationNode::Step::kFinal &&
+      numDrivers_ > 1 && !hasPreGroupedKeys_ &&
+      driverCtx->queryConfig().parallelFinalAggregation();
+  if (mergeDrivers_) {
+    for (auto& hasher : hashers) {
+      mergeChannels_.push_back(hasher->channel());
+    }
+    numMergeKeys_ = hashers.size();
+    for (auto& channels : args) {
+      VELOX_CHECK_EQ(channels.size(), 1);
+      mergeChannels_.push_back(channels[0]);
+    }
+    std::unordered_set<ChannelIndex> uniqueChannels(
+        mergeChannels_.begin(), mergeChannels_.end());
+    VELOX_USER_CHECK_EQ(
+        uniqueChannels.size(),
+        mergeChannels_.size(),
+        "{} requires distinct input columns for keys and aggregates",
+        core::QueryConfig::kParallelFinalAggregation);
+  }
+
+  // Partitioning defers all output to the end of input, so it only applies
+  // to aggregations that produce their output there anyway.
+  auto numPartitionBits = driverCtx->queryConfig().aggregationPartitionBits();
+  VELOX_USER_CHECK(
+      numPartitionBits >= 0 && numPartitionBits <= 16,
+      "{} must be between 0 and 16: {}",
+      core::QueryConfig::kAggregationPartitionBits,
+      numPartitionBits);
+  if (isPartialOutput_ || isDistinct_ || isGlobal_ || hasPreGroupedKeys_ ||
+      mergeDrivers_) {
+    numPartitionBits = 0;
+  }
+
+  // Compaction recreates the accumulators by adding their intermediate
+  // results back to the partial aggregates. This is only correct if each
+  // aggregate takes its intermediate type as its raw input, e.g. sum(bigint)
+  // but not sum(integer), which reads a bigint intermediate as integer, or if
+  // the aggregate accepts its own intermediate results, e.g. array_agg.
+  bool canCompact =
+      isPartialOutput_ && !isDistinct_ && !isGlobal_ && !hasPreGroupedKeys_;
+  for (auto i = 0; i < numAggregates && canCompact; ++i) {
+    const auto& inputs = aggregationNode->aggregates()[i]->inputs();
+    canCompact = !aggregationNode->isDistinctAggregate(i) &&
+        (aggregates[i]->acceptsOwnIntermediateResults() ||
+         (inputs.size() == 1 &&
+          inputs[0]->type()->kindEquals(
+              outputType_->childAt(numHashers + i))));
+  }
+  if (canCompact) {
+    partialAggregationCompactionPct_ =
+        driverCtx->queryConfig().partialAggregationCompactionPct();
+    VELOX_USER_CHECK(
+        partialAggregationCompactionPct_ >= 0 &&
+            partialAggregationCompactionPct_ <= 100,
+        "{} must be between 0 and 100: {}",
+        core::QueryConfig::kPartialAggregationCompactionPct,
+        partialAggregationCompactionPct_);
+  }
+
   groupingSet_ = std::make_unique<GroupingSet>(
       std::move(hashers),
       std::move(preGroupedChannels),
@@ -128,7 +199,8 @@ HashAggregation::HashAggregation(
       std::move(constantLists),
       aggregationNode->ignoreNullKeys(),
       isRawInput(aggregationNode->step()),
-      operatorCtx_.get());
+      operatorCtx_.get(),
+      numPartitionBits);
 }
 
 void HashAggregation::addInput(RowVectorPtr input) {
@@ -140,9 +212,220 @@ void HashAggregation::addInput(RowVectorPtr input) {
   groupingSet_->addInput(input_, mayPushdown_);
   if (isPartialOutput_ &&
       groupingSet_->allocatedBytes() > maxPartialAggregationMemoryUsage_) {
-    partialFull_ = true;
+    partialFull_ = !compactPartial();
+  }
+  newDistincts_ = isDistinct_ && !mergeDrivers_ &&
+      !groupingSet_->hashLookup().newGroups.empty();
+}
+
+void HashAggregation::noMoreInput() {
+  if (noMoreInput_) {
+    return;
+  }
+  groupingSet_->noMoreInput();
+  Operator::noMoreInput();
+  if (mergeDrivers_) {
+    startMerge();
   }
-  newDistincts_ = isDistinct_ && !groupingSet_->hashLookup().newGroups.empty();
+}
+
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (!future_.valid()) {
+    return BlockingReason::kNotBlocked;
+  }
+  *future = std::move(future_);
+  return BlockingReason::kWaitForPeers;
+}
+
+void HashAggregation::startMerge() {
+  toMerge_.resize(numDrivers_);
+  mergeStride_ = 1;
+  publishForMerge();
+  mergeBarrier();
+}
+
+bool HashAggregation::continueMerge() {
+  if (!isGlobal_) {
+    for (auto& input : mergeState_->partitions[partitionId_]) {
+      groupingSet_->addInput(input, false);
+    }
+    mergeState_.reset();
+    return true;
+  }
+  // Round 'i' of the tree adds the accumulators of driver d + 2^i to driver
+  // d for d divisible by 2^(i+1). Driver 0 ends up with the result.
+  for (;;) {
+    if (partitionId_ % (2 * mergeStride_) == 0 &&
+        partitionId_ + mergeStride_ < numDrivers_) {
+      auto& other = mergeState_->partitions[partitionId_ + mergeStride_];
+      for (auto& input : other) {
+        groupingSet_->addInput(input, false);
+      }
+      other.clear();
+    }
+    mergeStride_ *= 2;
+    if (mergeStride_ >= numDrivers_) {
+      mergeState_.reset();
+      return true;
+    }
+    publishForMerge();
+    if (!mergeBarrier()) {
+      return false;
+    }
+  }
+}
+
+void HashAggregation::publishForMerge() {
+  if (isGlobal_) {
+    if (partitionId_ % (2 * mergeStride_) == mergeStride_) {
+      auto& partition = mergeState_ ? mergeState_->partitions[partitionId_]
+                                    : toMerge_[partitionId_];
+      partition = extractForMerge();
+    }
+    return;
+  }
+
+  // Sends each group to driver hash % numDrivers_.
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  for (auto i = 0; i < numMergeKeys_; ++i) {
+    hashers.push_back(VectorHasher::create(
+        inputType_->childAt(mergeChannels_[i]), mergeChannels_[i]));
+  }
+  raw_vector<uint64_t> hashes;
+  std::vector<std::vector<vector_size_t>> partitionRows(numDrivers_);
+  for (auto& input : extractForMerge()) {
+    const SelectivityVector rows(input->size());
+    hashes.resize(input->size());
+    for (auto i = 0; i < numMergeKeys_; ++i) {
+      hashers[i]->hash(
+          *input->childAt(hashers[i]->channel()), rows, i > 0, hashes);
+    }
+    for (auto& partition : partitionRows) {
+      partition.clear();
+    }
+    for (auto row = 0; row < input->size(); ++row) {
+      partitionRows[hashes[row] % numDrivers_].push_back(row);
+    }
+    for (auto partition = 0; partition < numDrivers_; ++partition) {
+      auto& rowNumbers = partitionRows[partition];
+      if (rowNumbers.empty()) {
+        continue;
+      }
+      if (rowNumbers.size() == input->size()) {
+        toMerge_[partition].push_back(input);
+        continue;
+      }
+      auto size = rowNumbers.size();
+      auto indices = allocateIndices(size, pool());
+      std::copy(
+          rowNumbers.begin(),
+          rowNumbers.end(),
+          indices->asMutable<vector_size_t>());
+      std::vector<VectorPtr> children;
+      for (auto& child : input->children()) {
+        children.push_back(
+            BaseVector::wrapInDictionary(nullptr, indices, size, child));
+      }
+      toMerge_[partition].push_back(std::make_shared<RowVector>(
+          pool(), inputType_, nullptr, size, std::move(children)));
+    }
+  }
+}
+
+std::vector<RowVectorPtr> HashAggregation::extractForMerge() {
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto channel : mergeChannels_) {
+    names.push_back(inputType_->nameOf(channel));
+    types.push_back(inputType_->childAt(channel));
+  }
+  auto mergeType = ROW(std::move(names), std::move(types));
+  auto batchSize = isGlobal_ ? 1 : outputBatchSize_;
+  std::vector<RowVectorPtr> result;
+  RowContainerIterator iterator;
+  for (;;) {
+    auto batch = std::static_pointer_cast<RowVector>(
+        BaseVector::create(mergeType, batchSize, pool()));
+    // Extracts accumulators. After the last batch, the groups are cleared.
+    if (!groupingSet_->getOutput(batchSize, true, &iterator, batch)) {
+      break;
+    }
+    std::vector<VectorPtr> children(inputType_->size());
+    for (auto i = 0; i < inputType_->size(); ++i) {
+      children[i] = BaseVector::createNullConstant(
+          inputType_->childAt(i), batch->size(), pool());
+    }
+    for (auto i = 0; i < mergeChannels_.size(); ++i) {
+      children[mergeChannels_[i]] = batch->childAt(i);
+    }
+    result.push_back(std::make_shared<RowVector>(
+        pool(), inputType_, nullptr, batch->size(), std::move(children)));
+  }
+  return result;
+}
+
+bool HashAggregation::compactPartial() {
+  if (partialAggregationCompactionPct_ == 0) {
+    return false;
+  }
+  auto allocatedBytes = groupingSet_->allocatedBytes();
+  auto reclaimableBytes = groupingSet_->reclaimableBytes();
+  if (allocatedBytes - reclaimableBytes > maxPartialAggregationMemoryUsage_ ||
+      reclaimableBytes * 100 <
+          allocatedBytes * partialAggregationCompactionPct_) {
+    return false;
+  }
+  groupingSet_->compact(outputType_);
+  auto compactedBytes = groupingSet_->allocatedBytes();
+  auto freedBytes =
+      allocatedBytes > compactedBytes ? allocatedBytes - compactedBytes : 0;
+  stats_.addRuntimeStat("partialAggregationCompactions", RuntimeCounter(1));
+  stats_.addRuntimeStat(
+      "partialAggregationCompactionFreedBytes",
+      RuntimeCounter(freedBytes, RuntimeCounter::Unit::kBytes));
+  // Free space that compaction does not give back, e.g. the unused part of
+  // the last slab, would make every following batch compact again. Stops
+  // compacting if this round did not free the expected share of memory.
+  if (freedBytes * 100 < allocatedBytes * partialAggregationCompactionPct_) {
+    partialAggregationCompactionPct_ = 0;
+  }
+  return compactedBytes <= maxPartialAggregationMemoryUsage_;
+}
+
+bool HashAggregation::mergeBarrier() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return false;
+  }
+  if (!mergeState_) {
+    // The other drivers wait on the barrier, so their 'toMerge_' can be
+    // moved here.
+    auto state = std::make_shared<MergeState>();
+    state->partitions.resize(numDrivers_);
+    auto gather = [&](HashAggregation* op) {
+      for (auto i = 0; i < numDrivers_; ++i) {
+        auto& partition = state->partitions[i];
+        partition.insert(
+            partition.end(), op->toMerge_[i].begin(), op->toMerge_[i].end());
+      }
+      op->toMerge_.clear();
+      op->mergeState_ = state;
+    };
+    gather(this);
+    for (auto& peer : peers) {
+      auto op =
+          dynamic_cast<HashAggregation*>(peer->findOperator(planNodeId()));
+      VELOX_CHECK_NOT_NULL(op);
+      gather(op);
+    }
+  }
+  peers.clear();
+  for (auto& promise : promises) {
+    promise.setValue(true);
+  }
+  return true;
 }
 
 RowVectorPtr HashAggregation::getOutput() {
@@ -162,7 +445,19 @@ RowVectorPtr HashAggregation::getOutput() {
     return nullptr;
   }
 
-  if (isDistinct_) {
+  if (mergeDrivers_ && !mergeFinished_) {
+    if (!continueMerge()) {
+      return nullptr;
+    }
+    mergeFinished_ = true;
+    if (isGlobal_ && partitionId_ != 0) {
+      // Driver 0 produces the result.
+      finished_ = true;
+      return nullptr;
+    }
+  }
+
+  if (isDistinct_ && !mergeDrivers_) {
     if (!newDistincts_) {
       if (noMoreInput_) {
         finished_ = true;
@@ -35,28 +35,65 @@ class HashAggregation : public Operator {
     return !noMoreInput_ && !partialFull_;
   }
 
-  void noMoreInput() override {
-    groupingSet_->noMoreInput();
-    Operator::noMoreInput();
-  }
+  void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
   void close() override {
     Operator::close();
     groupingSet_.reset();
+    mergeState_.reset();
   }
 
  private:
+  // Intermediate results shared by the drivers of a final aggregation with
+  // 'mergeDrivers_'.
+  struct MergeState {
+    // For grouped aggregations, the groups of all drivers for each hash
+    // partition, indexed by the driver id that merges them. For global
+    // aggregations, the accumulators of a driver, indexed by its driver id.
+    std::vector<std::vector<RowVectorPtr>> partitions;
+  };
+
+  // Publishes the groups of this driver for merging and waits for the other
+  // drivers to do the same.
+  void startMerge();
+
+  // Merges groups from other drivers after a barrier. Returns false if
+  // blocked on the next barrier.
+  bool continueMerge();
+
+  // Makes intermediate results of the groups of this driver available to the
+  // driver that merges them.
+  void publishForMerge();
+
+  // Extracts the current groups as intermediate results in the layout of the
+  // input.
+  std::vector<RowVectorPtr> extractForMerge();
+
+  // Called when a partial aggregation exceeds its memory limit. Compacts the
+  // groups if at least 'partialAggregationCompactionPct_' percent of the
+  // memory is reclaimable. Returns true if the groups fit in the limit after
+  // compacting, false if the aggregation must flush.
+  bool compactPartial();
+
+  // Synchronizes the drivers of the pipeline. The first barrier creates
+  // 'mergeState_' from the 'toMerge_' of all drivers. Returns false and sets
+  // 'future_' if other drivers have not yet arrived.
+  bool mergeBarrier();
+
+  RowTypePtr inputType_;
   /// Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
 
   const int64_t maxPartialAggregationMemoryUsage_;
 
+  // See QueryConfig::kPartialAggregationCompactionPct. 0 if the aggregation
+  // cannot be compacted or if compacting did not free enough memory.
+  int32_t partialAggregationCompactionPct_ = 0;
+
   const bool isPartialOutput_;
   const bool isDistinct_;
   const bool isGlobal_;
@@ -64,6 +101,32 @@ class HashAggregation : public Operator {
 
   std::unique_ptr<GroupingSet> groupingSet_;
 
+  // True if the groups of the drivers of a final aggregation are merged
+  // after all input is received. See QueryConfig::kParallelFinalAggregation.
+  bool mergeDrivers_ = false;
+  int32_t numDrivers_;
+  // The index of this driver among the 'numDrivers_' drivers of its split
+  // group.
+  int32_t partitionId_;
+
+  // Intermediate results of this driver by partition before the first merge
+  // barrier.
+  std::vector<std::vector<RowVectorPtr>> toMerge_;
+  std::shared_ptr<MergeState> mergeState_;
+
+  // The channels of the input that get the keys and accumulators extracted
+  // for merging.
+  std::vector<ChannelIndex> mergeChannels_;
+  // The number of grouping keys at the start of 'mergeChannels_'.
+  int32_t numMergeKeys_ = 0;
+
+  // For global aggregations, the distance between drivers merged in the
+  // current round of the merge tree. 0 if merging has not started.
+  int32_t mergeStride_ = 0;
+  bool mergeFinished_ = false;
+
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+
   bool partialFull_ = false;
   bool newDistincts_ = false;
   bool finished_ = false;
@@ -286,19 +286,20 @@ void HashProbe::addInput(RowVectorPtr input) {
 
 namespace {
 // Copy values from 'rows' of 'table' according to 'projections' in
-// 'result'. Reuses 'result' children where possible.
+// 'result'. Reuses 'result' children where possible. Takes new children from
+// the vector pool of 'execCtx'.
 void extractColumns(
     BaseHashTable* table,
     folly::Range<char**> rows,
     folly::Range<const IdentityProjection*> projections,
-    memory::MemoryPool* pool,
+    core::ExecCtx* execCtx,
     const RowVectorPtr& result) {
   for (auto projection : projections) {
     auto& child = result->childAt(projection.outputChannel);
     // TODO: Consider reuse of complex types.
     if (!child || !BaseVector::isReusableFlatVector(child)) {
-      child = BaseVector::create(
-          result->type()->childAt(projection.outputChannel), rows.size(), pool);
+      child = execCtx->getVector(
+          result->type()->childAt(projection.outputChannel), rows.size());
     }
     child->resize(rows.size());
     table->rows()->extractColumn(
@@ -350,7 +351,7 @@ void HashProbe::fillOutput(vector_size_t size) {
       table_.get(),
       folly::Range<char**>(outputRows_.data(), size),
       tableResultProjections_,
-      pool(),
+      operatorCtx_->execCtx(),
       output_);
 }
 
@@ -381,7 +382,7 @@ RowVectorPtr HashProbe::getNonMatchingOutputForRightJoin() {
       table_.get(),
       folly::Range<char**>(outputRows_.data(), numOut),
       tableResultProjections_,
-      pool(),
+      operatorCtx_->execCtx(),
       output_);
   return output_;
 }
@@ -507,7 +508,7 @@ void HashProbe::fillFilterInput(vector_size_t size) {
       table_.get(),
       folly::Range<char**>(outputRows_.data(), size),
       filterBuildInputs_,
-      pool(),
+      operatorCtx_->execCtx(),
       filterInput_);
 }
 
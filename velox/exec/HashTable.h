@@ -42,6 +42,10 @@ struct HashLookup {
   raw_vector<uint64_t> hashes;
   // If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   raw_vector<uint64_t> normalizedKeys;
+  // If the join table compares packed keys, the keys of each probe row
+  // laid out as in the table's rows, HashTable::packedKeySize() bytes per
+  // row. 1:1 with 'hashes'.
+  raw_vector<char> packedKeys;
   // Hit for each row of input. nullptr if no hit. Points to the
   // corresponding group row.
   raw_vector<char*> hits;
@@ -329,7 +333,19 @@ class HashTable : public BaseHashTable {
 
   std::string toString() override;
 
+  // Size of a packed probe key, 0 if joinProbe() compares keys column by
+  // column.
+  int32_t packedKeySize() const {
+    return packedKeySize_;
+  }
+
  private:
+  // A byte range of the keys in a row.
+  struct KeyRange {
+    int32_t offset;
+    int32_t size;
+  };
+
   char*& nextRow(char* row) {
     return *reinterpret_cast<char**>(row + nextOffset_);
   }
@@ -398,6 +414,19 @@ class HashTable : public BaseHashTable {
 
   bool compareKeys(const char* group, const char* inserted);
 
+  // Decides whether joinProbe() in kHash mode compares packed keys. This is
+  // the case for join tables with 2 or more keys that are all integers,
+  // booleans, timestamps or strings.
+  void initializePackedKeys();
+
+  // Copies the keys of the probe rows into 'lookup.packedKeys', laid out as
+  // the keys of the rows in the table.
+  void packKeys(HashLookup& lookup);
+
+  // Returns true if the keys of 'group' are equal to 'packed', which is a
+  // probe key made by packKeys().
+  bool comparePackedKeys(const char* group, const char* packed) const;
+
   template <bool isJoin>
   void fullProbe(HashLookup& lookup, ProbeState& state, bool extraCheck);
 
@@ -440,6 +469,15 @@ class HashTable : public BaseHashTable {
   int64_t sizeMask_ = 0;
   int64_t numDistinct_ = 0;
   HashMode hashMode_ = HashMode::kArray;
+  // Byte ranges of the keys in a row that are compared with memcmp when
+  // probing with packed keys. Adjacent keys share a range. A string key
+  // contributes its size and prefix.
+  std::vector<KeyRange> packedKeyRanges_;
+  // Offsets of the string keys. The rest of a string is compared only after
+  // all of 'packedKeyRanges_' match.
+  std::vector<int32_t> packedStringOffsets_;
+  // Size of the keys in a row, 0 if keys are not compared packed.
+  int32_t packedKeySize_ = 0;
   // Owns the memory of multiple build side hash join tables that are
   // combined into a single probe hash table.
   std::vector<std::unique_ptr<HashTable<ignoreNullKeys>>> otherTables_;
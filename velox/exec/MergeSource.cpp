@@ -148,7 +148,8 @@ class MergeExchangeSource : public MergeSource {
           inputStream_.get(),
           mergeExchange_->pool(),
           mergeExchange_->outputType(),
-          &data);
+          &data,
+          mergeExchange_->serde());
 
       mergeExchange_->stats().inputPositions += data->size();
       mergeExchange_->stats().inputBytes += data->retainedSize();
@@ -207,6 +207,21 @@ void Operator::recordBlockingTime(uint64_t start) {
   stats_.blockedWallNanos += (now - start) * 1000;
 }
 
+void Operator::recordVectorPoolStats() {
+  auto execCtx = operatorCtx_->execCtxIfCreated();
+  if (!execCtx) {
+    return;
+  }
+  const auto& vectorPool = execCtx->vectorPool();
+  if (vectorPool.numHits() + vectorPool.numMisses() == 0) {
+    return;
+  }
+  stats_.addRuntimeStat(
+      "vectorPoolHits", RuntimeCounter(vectorPool.numHits()));
+  stats_.addRuntimeStat(
+      "vectorPoolMisses", RuntimeCounter(vectorPool.numMisses()));
+}
+
 std::string Operator::toString() const {
   std::stringstream out;
   if (auto task = operatorCtx_->task()) {
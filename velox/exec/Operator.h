@@ -166,6 +166,11 @@ class OperatorCtx {
 
   core::ExecCtx* execCtx() const;
 
+  // Returns the ExecCtx if execCtx() has been called, else nullptr.
+  const core::ExecCtx* FOLLY_NULLABLE execCtxIfCreated() const {
+    return execCtx_.get();
+  }
+
   // Makes an extract of QueryCtx for use in a connector. 'planNodeId'
   // is the id of the calling TableScan. This and the task id identify
   // the scan for column access tracking.
@@ -337,6 +342,10 @@ class Operator {
 
   void recordBlockingTime(uint64_t start);
 
+  // Adds the hit and miss counts of the vector pool of the operator to the
+  // runtime stats. Called once when the Driver reports stats to the Task.
+  void recordVectorPoolStats();
+
   virtual std::string toString() const;
 
   velox::memory::MemoryPool* pool() {
@@ -65,7 +65,7 @@ void Destination::serialize(
     for (vector_size_t i = begin; i < end; i++) {
       numRows += rows_[i].size;
     }
-    current_->createStreamTree(rowType, numRows);
+    current_->createStreamTree(rowType, numRows, serde_);
   }
   current_->append(output, folly::Range(&rows_[begin], end - begin));
 }
@@ -120,7 +120,7 @@ void PartitionedOutput::initializeDestinations() {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(
-          std::make_unique<Destination>(taskId, i, mappedMemory_));
+          std::make_unique<Destination>(taskId, i, mappedMemory_, serde_));
     }
   }
 }
@@ -149,7 +149,8 @@ void PartitionedOutput::estimateRowSizes() {
     VectorStreamGroup::estimateSerializedSize(
         output_->childAt(i),
         folly::Range(topLevelRanges_.data(), numInput),
-        sizePointers_.data());
+        sizePointers_.data(),
+        serde_);
   }
 }
 
@@ -27,8 +27,12 @@ class Destination {
   Destination(
       const std::string& taskId,
       int destination,
-      memory::MappedMemory* FOLLY_NONNULL memory)
-      : taskId_(taskId), destination_(destination), memory_(memory) {}
+      memory::MappedMemory* FOLLY_NONNULL memory,
+      VectorSerde* FOLLY_NULLABLE serde = nullptr)
+      : taskId_(taskId),
+        destination_(destination),
+        memory_(memory),
+        serde_(serde) {}
 
   // Resets the destination before starting a new batch.
   void beginBatch() {
@@ -75,6 +79,8 @@ class Destination {
   const std::string taskId_;
   const int destination_;
   memory::MappedMemory* FOLLY_NONNULL const memory_;
+  // Serde for the pages of this destination. nullptr means the default serde.
+  VectorSerde* FOLLY_NULLABLE const serde_;
   uint64_t bytesInCurrent_{0};
   std::vector<IndexRange> rows_;
 
@@ -117,7 +123,8 @@ class PartitionedOutput : public Operator {
             planNode->outputType())),
         future_(false),
         bufferManager_(PartitionedOutputBufferManager::getInstance()),
-        mappedMemory_{operatorCtx_->mappedMemory()} {
+        mappedMemory_{operatorCtx_->mappedMemory()},
+        serde_{getNamedVectorSerde(ctx->queryConfig().shuffleSerde())} {
     if (numDestinations_ == 1 || planNode->isBroadcast()) {
       VELOX_CHECK(keyChannels_.empty());
       VELOX_CHECK_NULL(partitionFunction_);
@@ -186,6 +193,8 @@ class PartitionedOutput : public Operator {
   bool replicatedAny_{false};
   std::weak_ptr<exec::PartitionedOutputBufferManager> bufferManager_;
   memory::MappedMemory* FOLLY_NONNULL mappedMemory_;
+  // Serde selected by QueryConfig::shuffleSerde(). nullptr for the default.
+  VectorSerde* FOLLY_NULLABLE const serde_;
   RowVectorPtr output_;
 
   // Reusable memory.
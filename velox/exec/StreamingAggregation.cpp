@@ -78,8 +78,19 @@ StreamingAggregation::StreamingAggregation(
     }
 
     const auto& aggResultType = outputType_->childAt(numKeys + i);
-    aggregates_.push_back(Aggregate::create(
-        aggregate->name(), aggregationNode->step(), argTypes, aggResultType));
+    if (aggregationNode->isDistinctAggregate(i)) {
+      aggregates_.push_back(Aggregate::createDistinct(
+          aggregate->name(),
+          aggregationNode->step(),
+          argTypes,
+          aggResultType));
+    } else {
+      aggregates_.push_back(Aggregate::create(
+          aggregate->name(),
+          aggregationNode->step(),
+          argTypes,
+          aggResultType));
+    }
     args_.push_back(channels);
     constantArgs_.push_back(constants);
   }
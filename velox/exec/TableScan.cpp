@@ -33,7 +33,10 @@ TableScan::TableScan(
       tableHandle_(tableScanNode->tableHandle()),
       columnHandles_(tableScanNode->assignments()),
       driverCtx_(driverCtx),
-      blockingFuture_(false) {}
+      blockingFuture_(false),
+      splitPreloadEnabled_(driverCtx->queryConfig().splitPreloadEnabled()),
+      maxSplitPreloadMemory_(
+          driverCtx->queryConfig().maxSplitPreloadMemory()) {}
 
 RowVectorPtr TableScan::getOutput() {
   if (noMoreSplits_) {
@@ -43,10 +46,15 @@ RowVectorPtr TableScan::getOutput() {
   for (;;) {
     if (needNewSplit_) {
       exec::Split split;
-      auto reason = driverCtx_->task->getSplitOrFuture(
-          driverCtx_->splitGroupId, planNodeId(), split, blockingFuture_);
-      if (reason != BlockingReason::kNotBlocked) {
-        return nullptr;
+      if (preloadedSplit_.has_value()) {
+        split = std::move(preloadedSplit_.value());
+        preloadedSplit_.reset();
+      } else {
+        auto reason = driverCtx_->task->getSplitOrFuture(
+            driverCtx_->splitGroupId, planNodeId(), split, blockingFuture_);
+        if (reason != BlockingReason::kNotBlocked) {
+          return nullptr;
+        }
       }
 
       if (!split.hasConnectorSplit()) {
@@ -92,6 +100,7 @@ RowVectorPtr TableScan::getOutput() {
       dataSource_->addSplit(connectorSplit);
       ++stats_.numSplits;
       setBatchSize();
+      preloadSplit();
     }
 
     const auto ioTimeStartMicros = getCurrentTimeMicro();
@@ -121,6 +130,21 @@ bool TableScan::isFinished() {
   return noMoreSplits_;
 }
 
+void TableScan::close() {
+  // Splits that are not read to the end, e.g. after an error or a limit,
+  // still count as running splits of the Task. These are the current split
+  // and the preloaded split.
+  if (!needNewSplit_) {
+    needNewSplit_ = true;
+    driverCtx_->task->splitFinished();
+  }
+  if (preloadedSplit_.has_value() && preloadedSplit_->hasConnectorSplit()) {
+    driverCtx_->task->splitFinished();
+  }
+  preloadedSplit_.reset();
+  SourceOperator::close();
+}
+
 void TableScan::setBatchSize() {
   constexpr int64_t kMB = 1 << 20;
   auto estimate = dataSource_->estimatedRowSize();
@@ -135,6 +159,27 @@ void TableScan::setBatchSize() {
   readBatchSize_ = std::min<int64_t>(100, 10 * kMB / estimate);
 }
 
+void TableScan::preloadSplit() {
+  if (!splitPreloadEnabled_ || preloadedSplit_.has_value() ||
+      !dataSource_->supportsSplitPreload() ||
+      pool()->getCurrentBytes() >= maxSplitPreloadMemory_) {
+    return;
+  }
+  exec::Split split;
+  if (!driverCtx_->task->getSplitIfAvailable(
+          driverCtx_->splitGroupId, planNodeId(), split)) {
+    return;
+  }
+  // A split without a connector split is kept for getOutput() to handle.
+  if (split.hasConnectorSplit()) {
+    VELOX_CHECK(
+        connector_->connectorId() == split.connectorSplit->connectorId,
+        "Got splits with different connector IDs");
+    dataSource_->preloadSplit(split.connectorSplit);
+  }
+  preloadedSplit_ = std::move(split);
+}
+
 void TableScan::addDynamicFilter(
     ChannelIndex outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
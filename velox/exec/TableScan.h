@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <optional>
+
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
 
@@ -39,6 +41,8 @@ class TableScan : public SourceOperator {
 
   bool isFinished() override;
 
+  void close() override;
+
   bool canAddDynamicFilter() const override {
     // TODO Consult with the connector. Return true only if connector can accept
     // dynamic filters.
@@ -55,6 +59,11 @@ class TableScan : public SourceOperator {
   // Adjust batch size according to split information.
   void setBatchSize();
 
+  // Takes the next queued split from the Task, if any, and hands it to the
+  // data source to prepare in the background while the current split is
+  // read.
+  void preloadSplit();
+
   const std::shared_ptr<connector::ConnectorTableHandle> tableHandle_;
   const std::
       unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
@@ -70,5 +79,9 @@ class TableScan : public SourceOperator {
   std::unordered_map<ChannelIndex, std::shared_ptr<common::Filter>>
       pendingDynamicFilters_;
   int32_t readBatchSize_{kDefaultBatchSize};
+  const bool splitPreloadEnabled_;
+  const uint64_t maxSplitPreloadMemory_;
+  // The split taken by preloadSplit(), to be added after the current split.
+  std::optional<exec::Split> preloadedSplit_;
 };
 } // namespace facebook::velox::exec
@@ -761,6 +761,28 @@ BlockingReason Task::getSplitOrFutureLocked(
     return BlockingReason::kWaitForSplit;
   }
 
+  takeSplitLocked(splitsStore, split);
+  return BlockingReason::kNotBlocked;
+}
+
+bool Task::getSplitIfAvailable(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId,
+    exec::Split& split) {
+  std::lock_guard<std::mutex> l(mutex_);
+
+  auto& splitsState = splitsStates_[planNodeId];
+  auto& splitsStore = isUngroupedExecution()
+      ? splitsState.groupSplitsStores[0]
+      : splitsState.groupSplitsStores[splitGroupId];
+  if (splitsStore.splits.empty()) {
+    return false;
+  }
+  takeSplitLocked(splitsStore, split);
+  return true;
+}
+
+void Task::takeSplitLocked(SplitsStore& splitsStore, exec::Split& split) {
   split = std::move(splitsStore.splits.front());
   splitsStore.splits.pop_front();
 
@@ -770,8 +792,6 @@ BlockingReason Task::getSplitOrFutureLocked(
   if (taskStats_.firstSplitStartTimeMs == 0) {
     taskStats_.firstSplitStartTimeMs = taskStats_.lastSplitStartTimeMs;
   }
-
-  return BlockingReason::kNotBlocked;
 }
 
 void Task::splitFinished() {
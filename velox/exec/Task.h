@@ -214,6 +214,11 @@ class Task : public std::enable_shared_from_this<Task> {
     return numDrivers(getOutputPipelineId());
   }
 
+  /// Returns the number of drivers of the pipeline 'pipelineId'.
+  uint32_t numPipelineDrivers(int pipelineId) const {
+    return numDrivers(pipelineId);
+  }
+
   /// Returns the number of running drivers.
   uint32_t numRunningDrivers() const {
     std::lock_guard<std::mutex> taskLock(mutex_);
@@ -269,6 +274,15 @@ class Task : public std::enable_shared_from_this<Task> {
       exec::Split& split,
       ContinueFuture& future);
 
+  // Sets 'split' to the next queued split for the source operator
+  // corresponding to plan node with specified ID and returns true. Returns
+  // false without waiting if no split is queued. Used for taking splits ahead
+  // of time to preload them.
+  bool getSplitIfAvailable(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId,
+      exec::Split& split);
+
   void splitFinished();
 
   void multipleSplitsFinished(int32_t numSplits);
@@ -470,6 +484,9 @@ class Task : public std::enable_shared_from_this<Task> {
       exec::Split& split,
       ContinueFuture& future);
 
+  /// Moves the first split of non-empty 'splitsStore' into 'split'.
+  void takeSplitLocked(SplitsStore& splitsStore, exec::Split& split);
+
   /// Creates for the given split group and fills up the 'SplitGroupState'
   /// structure, which stores inter-operator state (local exchange, bridges).
   void createSplitGroupStateLocked(
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+// Measures a single step group by on one BIGINT key with sum() for 1M to 64M
+// groups, with the input aggregated as it arrives and with the input
+// partitioned by the high bits of the key hash, so that the hash table of
+// each partition is smaller. Each group has 2 rows in random order.
+class HashAggregationBenchmark : public OperatorTestBase {
+ public:
+  static constexpr vector_size_t kBatchSize = 10'000;
+
+  explicit HashAggregationBenchmark(int64_t numGroups) {
+    OperatorTestBase::SetUp();
+    folly::Random::DefaultGenerator rng;
+    rng.seed(1);
+    auto numRows = 2 * numGroups;
+    for (int64_t start = 0; start < numRows; start += kBatchSize) {
+      auto size = std::min<int64_t>(kBatchSize, numRows - start);
+      batches_.push_back(makeRowVector(
+          {makeFlatVector<int64_t>(
+               size,
+               [&](auto /*row*/) {
+                 return folly::Random::rand64(rng) % numGroups;
+               }),
+           makeFlatVector<int64_t>(size, [](auto row) { return row; })}));
+    }
+  }
+
+  ~HashAggregationBenchmark() override {
+    OperatorTestBase::TearDown();
+  }
+
+  void TestBody() override {}
+
+  // Runs the aggregation with 'numPartitionBits' and returns the number of
+  // groups.
+  int64_t run(int32_t numPartitionBits) {
+    CursorParameters params;
+    params.queryCtx = core::QueryCtx::createForTest();
+    params.queryCtx->setConfigOverridesUnsafe({
+        {core::QueryConfig::kAggregationPartitionBits,
+         std::to_string(numPartitionBits)},
+    });
+    params.planNode = PlanBuilder()
+                          .values(batches_)
+                          .singleAggregation({"c0"}, {"sum(c1)"})
+                          .planNode();
+    auto result = readCursor(params, [](auto /*task*/) {});
+    int64_t numGroups = 0;
+    for (auto& vector : result.second) {
+      numGroups += vector->size();
+    }
+    return numGroups;
+  }
+
+ private:
+  std::vector<RowVectorPtr> batches_;
+};
+
+void aggregate(uint32_t iterations, int64_t numGroups, int32_t partitionBits) {
+  folly::BenchmarkSuspender suspender;
+  HashAggregationBenchmark benchmark(numGroups);
+  suspender.dismiss();
+  for (auto i = 0; i < iterations; ++i) {
+    folly::doNotOptimizeAway(benchmark.run(partitionBits));
+  }
+}
+
+// 1B groups would need about 100GB of memory for the input and the hash
+// table. The largest size here is 64M groups, which is already many times the
+// size of a last level cache.
+BENCHMARK_NAMED_PARAM(aggregate, 1M, 1'000'000, 0);
+BENCHMARK_RELATIVE_NAMED_PARAM(aggregate, 1M_radix, 1'000'000, 6);
+BENCHMARK_NAMED_PARAM(aggregate, 4M, 4'000'000, 0);
+BENCHMARK_RELATIVE_NAMED_PARAM(aggregate, 4M_radix, 4'000'000, 8);
+BENCHMARK_NAMED_PARAM(aggregate, 16M, 16'000'000, 0);
+BENCHMARK_RELATIVE_NAMED_PARAM(aggregate, 16M_radix, 16'000'000, 10);
+BENCHMARK_NAMED_PARAM(aggregate, 64M, 64'000'000, 0);
+BENCHMARK_RELATIVE_NAMED_PARAM(aggregate, 64M_radix, 64'000'000, 12);
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
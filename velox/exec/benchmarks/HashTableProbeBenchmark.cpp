@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <map>
+#include <numeric>
+
+#include "velox/exec/HashTable.h"
+#include "velox/vector/tests/VectorMaker.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+// Measures HashTable::groupProbe() and HashTable::joinProbe() for tables
+// from L2 cache resident to about 10x the size of a last level cache. The
+// keys are 2 random BIGINTs, so that the table does not use kArray mode and
+// the probes go through the tags. All probes hit.
+//
+// With 'stringKeys', the table ignores null keys like a join build and has 4
+// keys, VARCHAR, BIGINT, VARCHAR, BIGINT, so that joinProbe() compares
+// packed multi-column keys. Half the strings are too long to be inlined and
+// share their first 14 bytes.
+class HashTableProbeBenchmark {
+ public:
+  static constexpr vector_size_t kBatchSize = 1'024;
+  static constexpr int32_t kNumProbeBatches = 100;
+
+  HashTableProbeBenchmark(int64_t numKeys, bool stringKeys)
+      : stringKeys_(stringKeys) {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    if (stringKeys_) {
+      hashers.push_back(std::make_unique<VectorHasher>(VARCHAR(), 0));
+      hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 1));
+      hashers.push_back(std::make_unique<VectorHasher>(VARCHAR(), 2));
+      hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 3));
+    } else {
+      hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+      hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 1));
+    }
+    std::vector<std::unique_ptr<Aggregate>> noAggregates;
+    if (stringKeys_) {
+      table_ = HashTable<true>::createForAggregation(
+          std::move(hashers),
+          noAggregates,
+          memory::MappedMemory::getInstance());
+    } else {
+      table_ = HashTable<false>::createForAggregation(
+          std::move(hashers),
+          noAggregates,
+          memory::MappedMemory::getInstance());
+    }
+    lookup_ = std::make_unique<HashLookup>(table_->hashers());
+
+    folly::Random::DefaultGenerator rng;
+    rng.seed(1);
+    std::vector<int64_t> keys(numKeys);
+    for (auto& key : keys) {
+      key = folly::Random::rand64(rng);
+    }
+    for (int64_t start = 0; start < numKeys; start += kBatchSize) {
+      auto size = std::min<int64_t>(kBatchSize, numKeys - start);
+      groupProbe(makeBatch(size, [&](auto row) { return keys[start + row]; }));
+    }
+    VELOX_CHECK_EQ(numKeys, table_->numDistinct());
+
+    for (auto i = 0; i < kNumProbeBatches; ++i) {
+      probeBatches_.push_back(makeBatch(kBatchSize, [&](auto /*row*/) {
+        return keys[folly::Random::rand64(rng) % numKeys];
+      }));
+    }
+  }
+
+  // Probes all probe batches with groupProbe(). Returns the number of hits.
+  int64_t runGroupProbe() {
+    int64_t numHits = 0;
+    for (auto& batch : probeBatches_) {
+      groupProbe(batch);
+      numHits += lookup_->rows.size() - lookup_->newGroups.size();
+    }
+    return numHits;
+  }
+
+  // Probes all probe batches with joinProbe(). Returns the number of hits.
+  int64_t runJoinProbe() {
+    int64_t numHits = 0;
+    for (auto& batch : probeBatches_) {
+      hash(*batch);
+      table_->joinProbe(*lookup_);
+      for (auto row : lookup_->rows) {
+        numHits += lookup_->hits[row] != nullptr;
+      }
+    }
+    return numHits;
+  }
+
+ private:
+  RowVectorPtr makeBatch(
+      vector_size_t size,
+      std::function<int64_t(vector_size_t)> keyAt) {
+    auto first = vectorMaker_.flatVector<int64_t>(size, keyAt);
+    auto second = vectorMaker_.flatVector<int64_t>(
+        size, [&](auto row) { return first->valueAt(row) / 3; });
+    if (!stringKeys_) {
+      return vectorMaker_.rowVector({first, second});
+    }
+    std::vector<std::string> strings(size);
+    for (auto row = 0; row < size; ++row) {
+      auto key = first->valueAt(row);
+      strings[row] = key % 2 ? fmt::format("{}", key % 1'000'000)
+                             : fmt::format("common.prefix.{}", key);
+    }
+    auto string = vectorMaker_.flatVector(strings);
+    return vectorMaker_.rowVector({string, first, string, second});
+  }
+
+  // Computes the hashes of 'batch' into 'lookup_', switching the table to
+  // kHash mode if the keys do not fit the current mode.
+  void hash(const RowVector& batch) {
+    const SelectivityVector rows(batch.size());
+    lookup_->reset(batch.size());
+    std::iota(lookup_->rows.begin(), lookup_->rows.end(), 0);
+    auto& hashers = table_->hashers();
+    bool rehash = false;
+    for (auto i = 0; i < hashers.size(); ++i) {
+      auto& key = batch.childAt(i);
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        rehash |= !hashers[i]->computeValueIds(*key, rows, lookup_->hashes);
+      } else {
+        hashers[i]->hash(*key, rows, i > 0, lookup_->hashes);
+      }
+    }
+    if (rehash) {
+      table_->decideHashMode(batch.size());
+      hash(batch);
+    }
+  }
+
+  void groupProbe(const RowVectorPtr& batch) {
+    hash(*batch);
+    table_->groupProbe(*lookup_);
+  }
+
+  std::unique_ptr<memory::MemoryPool> pool_{
+      memory::getDefaultScopedMemoryPool()};
+  VectorMaker vectorMaker_{pool_.get()};
+  const bool stringKeys_;
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+  std::vector<RowVectorPtr> probeBatches_;
+};
+
+// Returns the benchmark for 'numKeys'. Tables are built once per size since
+// building the large ones takes longer than probing them.
+HashTableProbeBenchmark& benchmark(int64_t numKeys, bool stringKeys = false) {
+  static std::map<
+      std::pair<int64_t, bool>,
+      std::unique_ptr<HashTableProbeBenchmark>>
+      benchmarks;
+  auto& benchmark = benchmarks[{numKeys, stringKeys}];
+  if (!benchmark) {
+    benchmark = std::make_unique<HashTableProbeBenchmark>(numKeys, stringKeys);
+  }
+  return *benchmark;
+}
+
+void groupProbe(uint32_t iterations, int64_t numKeys) {
+  folly::BenchmarkSuspender suspender;
+  auto& probeBenchmark = benchmark(numKeys);
+  suspender.dismiss();
+  for (auto i = 0; i < iterations; ++i) {
+    folly::doNotOptimizeAway(probeBenchmark.runGroupProbe());
+  }
+}
+
+void joinProbe(uint32_t iterations, int64_t numKeys) {
+  folly::BenchmarkSuspender suspender;
+  auto& probeBenchmark = benchmark(numKeys);
+  suspender.dismiss();
+  for (auto i = 0; i < iterations; ++i) {
+    folly::doNotOptimizeAway(probeBenchmark.runJoinProbe());
+  }
+}
+
+void joinProbeStrings(uint32_t iterations, int64_t numKeys) {
+  folly::BenchmarkSuspender suspender;
+  auto& probeBenchmark = benchmark(numKeys, true);
+  suspender.dismiss();
+  for (auto i = 0; i < iterations; ++i) {
+    folly::doNotOptimizeAway(probeBenchmark.runJoinProbe());
+  }
+}
+} // namespace
+
+// About 9 bytes per slot in the tags and pointers plus about 40 bytes per
+// row in the RowContainer: 10K keys fit in L2, 100K in the LLC and 8M are
+// about 10x a 32MB LLC.
+BENCHMARK_NAMED_PARAM(groupProbe, 10K, 10'000);
+BENCHMARK_NAMED_PARAM(groupProbe, 100K, 100'000);
+BENCHMARK_NAMED_PARAM(groupProbe, 1M, 1'000'000);
+BENCHMARK_NAMED_PARAM(groupProbe, 8M, 8'000'000);
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(joinProbe, 10K, 10'000);
+BENCHMARK_NAMED_PARAM(joinProbe, 100K, 100'000);
+BENCHMARK_NAMED_PARAM(joinProbe, 1M, 1'000'000);
+BENCHMARK_NAMED_PARAM(joinProbe, 8M, 8'000'000);
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(joinProbeStrings, 10K, 10'000);
+BENCHMARK_NAMED_PARAM(joinProbeStrings, 100K, 100'000);
+BENCHMARK_NAMED_PARAM(joinProbeStrings, 1M, 1'000'000);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
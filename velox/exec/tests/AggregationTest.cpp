@@ -15,7 +15,7 @@
  */
 #include "velox/dwio/dwrf/test/utils/BatchMaker.h"
 #include "velox/exec/Aggregate.h"
-#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/expression/FunctionSignature.h"
 
@@ -186,8 +186,10 @@ bool registerSumNonPODAggregate(const std::string& name) {
 static bool FB_ANONYMOUS_VARIABLE(g_AggregateFunction) =
     registerSumNonPODAggregate("sumnonpod");
 
-class AggregationTest : public OperatorTestBase {
+class AggregationTest : public HiveConnectorTestBase {
  protected:
+  using OperatorTestBase::assertQuery;
+
   std::vector<RowVectorPtr>
   makeVectors(const RowTypePtr& rowType, vector_size_t size, int numVectors) {
     std::vector<RowVectorPtr> vectors;
@@ -613,5 +615,295 @@ TEST_F(AggregationTest, partialAggregationMemoryLimit) {
   assertQuery(params, "SELECT c0, count(1) FROM tmp GROUP BY 1");
 }
 
+TEST_F(AggregationTest, partialAggregationCompaction) {
+  // Each batch has a larger and longer max(c1) for every group. The
+  // accumulators free their previous values when growing, which leaves most
+  // of the memory of the partial aggregation free but not reusable.
+  constexpr int32_t kNumBatches = 20;
+  // The vectors reference these strings, which must outlive them.
+  std::vector<std::string> values;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    for (auto j = 0; j < 7; ++j) {
+      values.push_back(std::string(20 + i * 20 + j, 'a' + i));
+    }
+  }
+  std::vector<std::string> keys;
+  for (auto i = 0; i < 10; ++i) {
+    keys.push_back(fmt::format("long group key {}", i));
+  }
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(500, [](auto row) { return row % 100; }),
+        makeFlatVector<StringView>(
+            500,
+            [&](auto row) { return StringView(values[i * 7 + row % 7]); },
+            nullEvery(11)),
+        makeFlatVector<StringView>(
+            500, [&](auto row) { return StringView(keys[row % 10]); }),
+        makeFlatVector<int64_t>(500, [i](auto row) { return row * i; }),
+        makeFlatVector<int32_t>(
+            500, [i](auto row) { return row % 13 - i; }, nullEvery(5)),
+        makeFlatVector<float>(500, [i](auto row) { return row % 17 + i; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto getNumCompactions = [](const std::shared_ptr<Task>& task) {
+    auto stats = task->taskStats().pipelineStats.front().operatorStats;
+    return stats[1].runtimeStats["partialAggregationCompactions"].count;
+  };
+
+  auto makeParams = [&](const std::vector<std::string>& aggregates,
+                        const std::string& compactionPct) {
+    CursorParameters params;
+    params.planNode = PlanBuilder()
+                          .values(vectors)
+                          .partialAggregation({"c0", "c2"}, aggregates)
+                          .finalAggregation()
+                          .planNode();
+    params.queryCtx = core::QueryCtx::createForTest();
+    params.queryCtx->setConfigOverridesUnsafe({
+        {core::QueryConfig::kMaxPartialAggregationMemory, "131072"},
+        {core::QueryConfig::kPartialAggregationCompactionPct, compactionPct},
+    });
+    return params;
+  };
+
+  // The live data stays well below the limit. Compacting avoids flushing.
+  auto task = assertQuery(
+      makeParams({"max(c1)", "sum(c3)"}, "25"),
+      "SELECT c0, c2, max(c1), sum(c3) FROM tmp GROUP BY 1, 2");
+  EXPECT_LT(0, getNumCompactions(task));
+
+  task = assertQuery(
+      makeParams({"max(c1)", "sum(c3)"}, "0"),
+      "SELECT c0, c2, max(c1), sum(c3) FROM tmp GROUP BY 1, 2");
+  EXPECT_EQ(0, getNumCompactions(task));
+
+  // sum(integer), sum(real) and avg() have intermediate types that differ
+  // from their input types. The partial aggregation flushes instead of
+  // compacting.
+  task = assertQuery(
+      makeParams({"max(c1)", "sum(c4)", "sum(c5)", "avg(c4)"}, "25"),
+      "SELECT c0, c2, max(c1), sum(c4), sum(c5), avg(c4) "
+      "FROM tmp GROUP BY 1, 2");
+  EXPECT_EQ(0, getNumCompactions(task));
+
+  // array_agg() accepts its own intermediate results. The arrays are sorted
+  // to compare with an uncompacted run.
+  auto makeArrayAggParams = [&](const std::string& compactionPct) {
+    auto params = makeParams({"max(c1)", "array_agg(c3)"}, compactionPct);
+    params.planNode =
+        PlanBuilder()
+            .values(vectors)
+            .partialAggregation({"c0", "c2"}, {"max(c1)", "array_agg(c3)"})
+            .finalAggregation()
+            .project({"c0", "c2", "a0", "array_sort(a1)"})
+            .planNode();
+    return params;
+  };
+  auto [cursor, expected] = readCursor(makeArrayAggParams("0"), [](Task*) {});
+  task = test::assertQuery(makeArrayAggParams("25"), expected);
+  EXPECT_LT(0, getNumCompactions(task));
+}
+
+TEST_F(AggregationTest, parallelFinalAggregation) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+
+  CursorParameters params;
+  params.queryCtx = core::QueryCtx::createForTest();
+  params.queryCtx->setConfigOverridesUnsafe({
+      {core::QueryConfig::kParallelFinalAggregation, "true"},
+  });
+
+  // Partial aggregations in 3 pipelines feed final aggregations that get
+  // their input round robin, so that every final driver sees most groups.
+  auto makePlan = [&](const std::vector<std::string>& keys,
+                      const std::vector<std::string>& aggregates) {
+    auto planNodeIdGenerator = std::make_shared<PlanNodeIdGenerator>();
+    std::vector<std::shared_ptr<const core::PlanNode>> sources;
+    for (auto i = 0; i < 3; ++i) {
+      sources.push_back(PlanBuilder(planNodeIdGenerator)
+                            .values(vectors)
+                            .partialAggregation(keys, aggregates)
+                            .planNode());
+    }
+    return PlanBuilder(planNodeIdGenerator)
+        .localPartitionRoundRobin(sources)
+        .finalAggregation()
+        .planNode();
+  };
+
+  for (auto numDrivers : {1, 4, 5}) {
+    SCOPED_TRACE(fmt::format("numDrivers: {}", numDrivers));
+    params.maxDrivers = numDrivers;
+
+    params.planNode = makePlan({"c0", "c6"}, {"count(1)", "sum(c1)"});
+    assertQuery(
+        params,
+        "SELECT c0, c6, 3 * count(1), 3 * sum(c1) FROM tmp GROUP BY 1, 2");
+
+    params.planNode = makePlan({"c0"}, {});
+    assertQuery(params, "SELECT distinct c0 FROM tmp");
+
+    // Global aggregations combine the accumulators of the drivers in a tree.
+    params.planNode = makePlan({}, {"count(1)", "min(c1)", "max(c2)"});
+    assertQuery(params, "SELECT 3 * count(1), min(c1), max(c2) FROM tmp");
+  }
+
+  // In grouped execution, the drivers of each split group merge among
+  // themselves. Each of the 2 split groups reads the data 3 times.
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  auto assertGrouped = [&](const std::vector<std::string>& keys,
+                           const std::vector<std::string>& aggregates,
+                           const std::string& duckDbSql) {
+    core::PlanNodeId scanId;
+    CursorParameters groupedParams;
+    groupedParams.queryCtx = params.queryCtx;
+    groupedParams.planNode = PlanBuilder()
+                                 .tableScan(rowType_)
+                                 .capturePlanNodeId(scanId)
+                                 .partialAggregation(keys, aggregates)
+                                 .finalAggregation()
+                                 .planNode();
+    groupedParams.maxDrivers = 3;
+    groupedParams.executionStrategy = core::ExecutionStrategy::kGrouped;
+    groupedParams.numSplitGroups = 2;
+    groupedParams.numConcurrentSplitGroups = 2;
+    bool noMoreSplits = false;
+    auto addSplits = [&](Task* task) {
+      if (noMoreSplits) {
+        return;
+      }
+      for (auto group = 0; group < 2; ++group) {
+        for (auto i = 0; i < 3; ++i) {
+          task->addSplit(scanId, makeHiveSplitWithGroup(filePath->path, group));
+        }
+        task->noMoreSplitsForGroup(scanId, group);
+      }
+      task->noMoreSplits(scanId);
+      noMoreSplits = true;
+    };
+    test::assertQuery(groupedParams, addSplits, duckDbSql, duckDbQueryRunner_);
+  };
+
+  // Each split group produces its own result.
+  assertGrouped(
+      {"c0", "c6"},
+      {"count(1)", "sum(c1)"},
+      "SELECT c0, c6, 3 * count(1), 3 * sum(c1) FROM tmp GROUP BY 1, 2 "
+      "UNION ALL "
+      "SELECT c0, c6, 3 * count(1), 3 * sum(c1) FROM tmp GROUP BY 1, 2");
+  assertGrouped(
+      {},
+      {"count(1)", "min(c1)", "max(c2)"},
+      "SELECT 3 * count(1), min(c1), max(c2) FROM tmp "
+      "UNION ALL "
+      "SELECT 3 * count(1), min(c1), max(c2) FROM tmp");
+}
+
+TEST_F(AggregationTest, partitioned) {
+  rng_.seed(1);
+  auto rowType =
+      ROW({"c0", "c1", "c2", "c3", "c4", "c5"},
+          {BIGINT(), SMALLINT(), TINYINT(), VARCHAR(), VARCHAR(), VARCHAR()});
+
+  std::vector<RowVectorPtr> batches;
+  makeModeTestKeys(rowType, 20000, 2, 2, 2, 4, 4, 4, batches);
+  makeModeTestKeys(rowType, 100000, 1000000, 2, 2, 4, 4, 1000000, batches);
+  createDuckDbTable(batches);
+
+  CursorParameters params;
+  params.queryCtx = core::QueryCtx::createForTest();
+  params.queryCtx->setConfigOverridesUnsafe({
+      {core::QueryConfig::kAggregationPartitionBits, "4"},
+  });
+
+  params.planNode = PlanBuilder()
+                        .values(batches)
+                        .singleAggregation(
+                            {"c0", "c1", "c2", "c3", "c4", "c5"},
+                            {"sum(1)", "max(c3)", "min(c5)"})
+                        .planNode();
+  assertQuery(
+      params,
+      "SELECT c0, c1, c2, c3, c4, c5, sum(1), max(c3), min(c5) FROM tmp "
+      " GROUP BY c0, c1, c2, c3, c4, c5");
+
+  params.planNode = PlanBuilder()
+                        .values(batches)
+                        .partialAggregation({"c0", "c5"}, {"count(1)"})
+                        .finalAggregation()
+                        .planNode();
+  assertQuery(params, "SELECT c0, c5, count(1) FROM tmp GROUP BY 1, 2");
+
+  // Only the keys and arguments are buffered. The other columns are
+  // replaced with nulls.
+  params.planNode = PlanBuilder()
+                        .values(batches)
+                        .singleAggregation({"c2"}, {"min(c1)", "max(c4)"})
+                        .planNode();
+  assertQuery(params, "SELECT c2, min(c1), max(c4) FROM tmp GROUP BY 1");
+
+  // Partitioning does not apply to distinct and global aggregations.
+  params.planNode = PlanBuilder()
+                        .values(batches)
+                        .singleAggregation({"c0"}, {})
+                        .planNode();
+  assertQuery(params, "SELECT distinct c0 FROM tmp");
+
+  params.planNode = PlanBuilder()
+                        .values(batches)
+                        .singleAggregation({}, {"sum(1)"})
+                        .planNode();
+  assertQuery(params, "SELECT sum(1) FROM tmp");
+}
+
+TEST_F(AggregationTest, distinctAggregates) {
+  // The vectors reference these strings, which must outlive them.
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 37; ++i) {
+    strings.push_back(fmt::format("{} long enough to be out of line", i));
+  }
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 17; }),
+        makeFlatVector<int64_t>(
+            1'000, [i](auto row) { return (row + i) % 101; }, nullEvery(11)),
+        makeFlatVector<StringView>(
+            1'000,
+            [&](auto row) { return StringView(strings[row % 37]); },
+            nullEvery(13)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto op = PlanBuilder()
+                .values(vectors)
+                .singleAggregation(
+                    {"c0"},
+                    {"count(c1)", "sum(c1)", "count(c2)", "max(c2)", "sum(c1)"},
+                    {true, true, true, true, false})
+                .planNode();
+  assertQuery(
+      op,
+      "SELECT c0, count(distinct c1), sum(distinct c1), count(distinct c2), "
+      "max(distinct c2), sum(c1) FROM tmp GROUP BY 1");
+
+  op = PlanBuilder()
+           .values(vectors)
+           .singleAggregation(
+               {}, {"count(c1)", "count(c2)", "sum(c0)"}, {true, true, true})
+           .planNode();
+  assertQuery(
+      op,
+      "SELECT count(distinct c1), count(distinct c2), sum(distinct c0) "
+      "FROM tmp");
+}
+
 } // namespace
 } // namespace facebook::velox::exec::test
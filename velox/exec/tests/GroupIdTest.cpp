@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+class GroupIdTest : public OperatorTestBase {
+ protected:
+  std::vector<RowVectorPtr> makeVectors() {
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < 5; ++i) {
+      vectors.push_back(makeRowVector({
+          makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+          makeFlatVector<StringView>(
+              1'000,
+              [](auto row) {
+                return StringView(fmt::format("key {}", row % 11));
+              }),
+          makeFlatVector<int32_t>(1'000, [i](auto row) { return row + i; }),
+      }));
+    }
+    return vectors;
+  }
+};
+
+TEST_F(GroupIdTest, basic) {
+  auto vectors = makeVectors();
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .groupId({{"c0", "c1"}, {"c0"}, {}}, {"c2"})
+                  .planNode();
+  assertQuery(
+      plan,
+      "SELECT c0, c1, c2, 0::BIGINT FROM tmp "
+      "UNION ALL SELECT c0, null, c2, 1::BIGINT FROM tmp "
+      "UNION ALL SELECT null, null, c2, 2::BIGINT FROM tmp");
+}
+
+TEST_F(GroupIdTest, rollup) {
+  auto vectors = makeVectors();
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .groupId({{"c0", "c1"}, {"c0"}, {}}, {"c2"})
+                  .singleAggregation(
+                      {"c0", "c1", "group_id"},
+                      {"sum(c2) AS sum_c2", "count(1) AS cnt"})
+                  .project({"c0", "c1", "sum_c2", "cnt"})
+                  .planNode();
+  assertQuery(
+      plan,
+      "SELECT c0, c1, sum(c2), count(1) FROM tmp GROUP BY ROLLUP(c0, c1)");
+}
+
+TEST_F(GroupIdTest, cube) {
+  auto vectors = makeVectors();
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .groupId({{"c0", "c1"}, {"c0"}, {"c1"}, {}}, {"c2"})
+                  .partialAggregation(
+                      {"c0", "c1", "group_id"},
+                      {"max(c2) AS max_c2", "count(1) AS cnt"})
+                  .finalAggregation()
+                  .project({"c0", "c1", "max_c2", "cnt"})
+                  .planNode();
+  assertQuery(
+      plan, "SELECT c0, c1, max(c2), count(1) FROM tmp GROUP BY CUBE(c0, c1)");
+}
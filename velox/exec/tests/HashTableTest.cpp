@@ -493,6 +493,17 @@ TEST_F(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 1000000, 2, type, 6);
 }
 
+TEST_F(HashTableTest, mixed4StringsPacked) {
+  // Strings between BIGINTs make several ranges of packed keys. Half the
+  // probes miss, so that near matches with equal string prefixes occur.
+  auto type =
+      ROW({"k1", "k2", "k3", "k4"}, {VARCHAR(), BIGINT(), VARCHAR(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  testCycle(BaseHashTable::HashMode::kHash, 500000, 2, type, 4);
+  EXPECT_LT(0, topTable_->packedKeySize());
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_F(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
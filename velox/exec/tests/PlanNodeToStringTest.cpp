@@ -169,6 +169,17 @@ TEST_F(PlanNodeToStringTest, aggregation) {
   ASSERT_EQ(
       "-> Aggregation[SINGLE [c0] a := sum(ROW[\"c1\"]), b := avg(ROW[\"c2\"])]\n",
       plan->toString(true, false));
+
+  // Distinct aggregates.
+  plan = PlanBuilder()
+             .values({data_})
+             .singleAggregation(
+                 {"c0"}, {"count(c1) AS a", "sum(c2) AS b"}, {true, false})
+             .planNode();
+
+  ASSERT_EQ(
+      "-> Aggregation[SINGLE [c0] a := DISTINCT count(ROW[\"c1\"]), b := sum(ROW[\"c2\"])]\n",
+      plan->toString(true, false));
 }
 
 TEST_F(PlanNodeToStringTest, hashJoin) {
@@ -334,6 +345,16 @@ TEST_F(PlanNodeToStringTest, assignUniqueId) {
   ASSERT_EQ("-> AssignUniqueId[]\n", plan->toString(true, false));
 }
 
+TEST_F(PlanNodeToStringTest, groupId) {
+  auto plan = PlanBuilder()
+                  .values({data_})
+                  .groupId({{"c0", "c1"}, {"c0"}, {}}, {"c2"})
+                  .planNode();
+
+  ASSERT_EQ("-> GroupId\n", plan->toString());
+  ASSERT_EQ("-> GroupId[[c0, c1], [c0], []]\n", plan->toString(true, false));
+}
+
 TEST_F(PlanNodeToStringTest, unnest) {
   auto plan = PlanBuilder()
                   .values({data_})
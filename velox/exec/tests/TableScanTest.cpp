@@ -15,6 +15,7 @@
  */
 #include "velox/common/base/tests/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/DecodedDataCache.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/dwio/dwrf/test/utils/DataFiles.h"
@@ -726,6 +727,158 @@ TEST_P(TableScanTest, statsBasedSkippingDouble) {
   EXPECT_EQ(3, getSkippedStridesStat(task));
 }
 
+TEST_P(TableScanTest, statsBasedSkippingWithCachedFooter) {
+  auto filePaths = makeFilePaths(1);
+  auto size = 31'234;
+  auto rowVector = makeRowVector(
+      {makeFlatVector<int64_t>(size, [](auto row) { return row; })});
+
+  writeToFile(filePaths[0]->path, rowVector);
+  createDuckDbTable({rowVector});
+
+  auto assertQuery = [&](const std::string& filter) {
+    return TableScanTest::assertQuery(
+        PlanBuilder().tableScan(ROW({"c0"}, {BIGINT()}), {filter}).planNode(),
+        filePaths,
+        "SELECT c0 FROM tmp WHERE " + filter);
+  };
+
+  // The first query reads the footer and skips the split based on stats.
+  auto task = assertQuery("c0 < 0");
+  EXPECT_EQ(0, getTableScanStats(task).rawInputRows);
+  EXPECT_EQ(1, getSkippedSplitsStat(task));
+  EXPECT_EQ(0, getTableScanRuntimeStats(task)["skippedSplitsWithoutRead"].sum);
+
+  // Later queries on the same file skip the split from the cached footer
+  // without opening a reader.
+  task = assertQuery("c0 > 100000");
+  EXPECT_EQ(0, getTableScanStats(task).rawInputRows);
+  EXPECT_EQ(1, getSkippedSplitsStat(task));
+  EXPECT_EQ(1, getTableScanRuntimeStats(task)["skippedSplitsWithoutRead"].sum);
+
+  // Splits that pass the filters are read as usual.
+  task = assertQuery("c0 < 100");
+  EXPECT_EQ(0, getSkippedSplitsStat(task));
+  EXPECT_EQ(0, getTableScanRuntimeStats(task)["skippedSplitsWithoutRead"].sum);
+}
+
+TEST_P(TableScanTest, splitPreload) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePaths = makeFilePaths(10);
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto runQuery = [&](bool splitPreload) {
+    CursorParameters params;
+    params.planNode = tableScanNode();
+    params.queryCtx = core::QueryCtx::createForTest();
+    params.queryCtx->setConfigOverridesUnsafe({
+        {core::QueryConfig::kSplitPreloadEnabled,
+         splitPreload ? "true" : "false"},
+    });
+    bool noMoreSplits = false;
+    return test::assertQuery(
+        params,
+        [&](Task* task) {
+          if (noMoreSplits) {
+            return;
+          }
+          for (auto& split : makeHiveSplits(filePaths)) {
+            task->addSplit("0", exec::Split(std::move(split)));
+          }
+          task->noMoreSplits("0");
+          noMoreSplits = true;
+        },
+        "SELECT * FROM tmp",
+        duckDbQueryRunner_);
+  };
+
+  // Splits are preloaded only if the connector has an executor, which is the
+  // case with AsyncDataCache.
+  auto task = runQuery(true);
+  EXPECT_EQ(10, getTableScanStats(task).numSplits);
+  if (useAsyncCache_) {
+    EXPECT_LT(0, getTableScanRuntimeStats(task)["preloadedSplits"].sum);
+  } else {
+    EXPECT_EQ(0, getTableScanRuntimeStats(task)["preloadedSplits"].sum);
+  }
+
+  task = runQuery(false);
+  EXPECT_EQ(10, getTableScanStats(task).numSplits);
+  EXPECT_EQ(0, getTableScanRuntimeStats(task)["preloadedSplits"].sum);
+
+  // A scan that stops early reports its current and preloaded splits as
+  // finished.
+  CursorParameters params;
+  params.planNode =
+      PlanBuilder().tableScan(rowType_).limit(0, 10, false).planNode();
+  auto [cursor, results] = readCursor(params, [&](Task* task) {
+    if (task->taskStats().numTotalSplits > 0) {
+      return;
+    }
+    for (auto& split : makeHiveSplits(filePaths)) {
+      task->addSplit("0", exec::Split(std::move(split)));
+    }
+    task->noMoreSplits("0");
+  });
+  ASSERT_TRUE(waitForTaskCompletion(cursor->task().get()));
+  auto stats = cursor->task()->taskStats();
+  EXPECT_EQ(0, stats.numRunningSplits);
+}
+
+TEST_P(TableScanTest, decodedCache) {
+  // Few distinct values make the writer use a string dictionary.
+  std::vector<std::string> values;
+  for (auto i = 0; i < 10; ++i) {
+    values.push_back(fmt::format("dictionary value {}", i));
+  }
+  std::vector<RowVectorPtr> vectors = {
+      makeRowVector({makeFlatVector<StringView>(
+          10'000, [&](auto row) { return StringView(values[row % 10]); })})};
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  auto runQuery = [&]() {
+    CursorParameters params;
+    params.planNode =
+        PlanBuilder().tableScan(ROW({"c0"}, {VARCHAR()})).planNode();
+    params.queryCtx = std::make_shared<core::QueryCtx>(
+        std::make_shared<folly::CPUThreadPoolExecutor>(4),
+        std::make_shared<core::MemConfig>(),
+        std::unordered_map<std::string, std::shared_ptr<Config>>{
+            {kHiveConnectorId,
+             std::make_shared<core::MemConfig>(
+                 std::unordered_map<std::string, std::string>{
+                     {"decoded_cache_pct", "1"}})}});
+    return test::assertQuery(
+        params,
+        [&](Task* task) {
+          if (task->taskStats().numTotalSplits > 0) {
+            return;
+          }
+          task->addSplit("0", exec::Split(makeHiveSplit(filePath->path)));
+          task->noMoreSplits("0");
+        },
+        "SELECT * FROM tmp",
+        duckDbQueryRunner_);
+  };
+
+  runQuery();
+  if (!useAsyncCache_) {
+    return;
+  }
+  // The config adds the decoded data tier to the cache. The second scan
+  // finds the stripe dictionary there.
+  auto decodedCache = asyncDataCache_->decodedCache();
+  ASSERT_NE(nullptr, decodedCache);
+  auto numHit = decodedCache->stats().numHit;
+  runQuery();
+  EXPECT_LT(numHit, decodedCache->stats().numHit);
+}
+
 TEST_P(TableScanTest, statsBasedSkippingFloat) {
   auto filePaths = makeFilePaths(1);
   auto size = 31'234;
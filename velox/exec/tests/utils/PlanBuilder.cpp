@@ -793,6 +793,27 @@ PlanBuilder& PlanBuilder::aggregation(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::singleAggregation(
+    const std::vector<std::string>& groupingKeys,
+    const std::vector<std::string>& aggregates,
+    const std::vector<bool>& distinctAggregates) {
+  auto step = core::AggregationNode::Step::kSingle;
+  auto aggregatesAndNames =
+      createAggregateExpressionsAndNames(aggregates, step, {});
+  planNode_ = std::make_shared<core::AggregationNode>(
+      nextPlanNodeId(),
+      step,
+      fields(groupingKeys),
+      std::vector<std::shared_ptr<const core::FieldAccessTypedExpr>>{},
+      aggregatesAndNames.names,
+      aggregatesAndNames.aggregates,
+      createAggregateMasks(aggregates.size(), {}),
+      false,
+      planNode_,
+      distinctAggregates);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::streamingAggregation(
     const std::vector<std::string>& groupingKeys,
     const std::vector<std::string>& aggregates,
@@ -881,6 +902,30 @@ PlanBuilder& PlanBuilder::assignUniqueId(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::groupId(
+    const std::vector<std::vector<std::string>>& groupingSets,
+    const std::vector<std::string>& aggregationInputs,
+    const std::string& groupIdName) {
+  std::vector<core::GroupIdNode::GroupingKeyInfo> groupingKeyInfos;
+  std::unordered_set<std::string> groupingKeys;
+  for (const auto& groupingSet : groupingSets) {
+    for (const auto& key : groupingSet) {
+      if (groupingKeys.insert(key).second) {
+        groupingKeyInfos.push_back({key, field(key)});
+      }
+    }
+  }
+
+  planNode_ = std::make_shared<core::GroupIdNode>(
+      nextPlanNodeId(),
+      groupingSets,
+      std::move(groupingKeyInfos),
+      fields(aggregationInputs),
+      groupIdName,
+      planNode_);
+  return *this;
+}
+
 namespace {
 core::PartitionFunctionFactory createPartitionFunctionFactory(
     const RowTypePtr& inputType,
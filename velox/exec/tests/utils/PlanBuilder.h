@@ -336,6 +336,17 @@ class PlanBuilder {
         false);
   }
 
+  /// Same as above, but aggregates[i] consumes only the distinct values of its
+  /// argument within each group if distinctAggregates[i] is true. For example,
+  ///
+  ///     singleAggregation({"k"}, {"count(a)", "sum(b)"}, {true, false})
+  ///
+  /// computes count(distinct a) and sum(b) for each value of k.
+  PlanBuilder& singleAggregation(
+      const std::vector<std::string>& groupingKeys,
+      const std::vector<std::string>& aggregates,
+      const std::vector<bool>& distinctAggregates);
+
   /// Add an AggregationNode using specified grouping keys,
   /// aggregate expressions and masks. See 'partialAggregation' method for the
   /// supported types of aggregate expressions.
@@ -479,6 +490,28 @@ class PlanBuilder {
       const std::string& idName = "unique",
       const int32_t taskUniqueId = 1);
 
+  /// Add a GroupIdNode to replicate the input once per grouping set. Feed the
+  /// output into an aggregation grouped on all grouping keys and the group id
+  /// column to compute GROUPING SETS, ROLLUP or CUBE.
+  ///
+  /// For example,
+  ///
+  ///     groupId({{"a", "b"}, {"a"}, {}}, {"c"})
+  ///         .singleAggregation({"a", "b", "group_id"}, {"sum(c)"})
+  ///
+  /// computes sum(c) for ROLLUP(a, b).
+  ///
+  /// @param groupingSets A list of grouping sets, each a list of input column
+  /// names. The grouping keys keep their input names in the output.
+  /// @param aggregationInputs Input columns to project as is. Must not be
+  /// grouping keys.
+  /// @param groupIdName The name of output column that contains the index of
+  /// the grouping set. Column type is BIGINT.
+  PlanBuilder& groupId(
+      const std::vector<std::vector<std::string>>& groupingSets,
+      const std::vector<std::string>& aggregationInputs,
+      const std::string& groupIdName = "group_id");
+
   /// Add a PartitionedOutputNode to hash-partition the input on the specified
   /// keys using exec::HashPartitionFunction.
   ///
@@ -370,6 +370,17 @@ void ConjunctExpr::evalSpecialForm(
   ExceptionContextSetter exceptionContext(
       {[](auto* expr) { return static_cast<Expr*>(expr)->toString(); }, this});
 
+  if (!reorderEnabledChecked_) {
+    reorderEnabled_ = context->execCtx()
+                          ->queryCtx()
+                          ->config()
+                          .adaptiveFilterReorderingEnabled();
+    reorderEnabledChecked_ = true;
+    if (reorderEnabled_) {
+      orderByEstimatedCost();
+    }
+  }
+
   // TODO Revisit error handling
   bool throwOnError = *context->mutableThrowOnError();
   VarSetter saveError(context->mutableThrowOnError(), false);
@@ -444,34 +455,70 @@ void ConjunctExpr::evalSpecialForm(
   }
   // Clear errors for 'rows' that are not in 'activeRows'.
   finalizeErrors(rows, *activeRows, throwOnError, context);
-  if (!reorderEnabledChecked_) {
-    reorderEnabled_ = context->execCtx()
-                          ->queryCtx()
-                          ->config()
-                          .adaptiveFilterReorderingEnabled();
-    reorderEnabledChecked_ = true;
-  }
   if (reorderEnabled_) {
     maybeReorderInputs();
   }
 }
 
+// static
+int32_t ConjunctExpr::estimateCost(const Expr& expr) {
+  // Field references and constants are free. Each function call costs 1 if it
+  // only reads fixed width values and more if it reads strings or complex
+  // types, e.g. a regular expression match costs more than an integer
+  // comparison.
+  constexpr int32_t kVariableWidthCost = 10;
+  if (expr.inputs().empty()) {
+    return 0;
+  }
+  int32_t cost = 1;
+  for (auto& input : expr.inputs()) {
+    if (!input->type()->isFixedWidth()) {
+      cost += kVariableWidthCost;
+    }
+    cost += estimateCost(*input);
+  }
+  return cost;
+}
+
+void ConjunctExpr::orderByEstimatedCost() {
+  // Stable sort keeps the plan order for inputs of equal cost.
+  std::stable_sort(
+      inputOrder_.begin(), inputOrder_.end(), [this](auto left, auto right) {
+        return estimatedCost_[left] < estimatedCost_[right];
+      });
+}
+
+bool ConjunctExpr::isCheaper(int32_t left, int32_t right, bool useStats)
+    const {
+  if (useStats) {
+    return selectivity_[left].timeToDropValue() <
+        selectivity_[right].timeToDropValue();
+  }
+  return estimatedCost_[left] < estimatedCost_[right];
+}
+
 void ConjunctExpr::maybeReorderInputs() {
+  // All inputs are compared by the same measure so that the comparison is a
+  // strict weak ordering. The time per dropped row is only used once every
+  // input has been evaluated. An input that was never reached, e.g. because
+  // an earlier input dropped all rows, has no time and would sort first.
+  bool useStats = std::all_of(
+      selectivity_.begin(), selectivity_.end(), [](const auto& selectivity) {
+        return selectivity.numIn() > 0;
+      });
   bool reorder = false;
   for (auto i = 1; i < inputs_.size(); ++i) {
-    if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
-        selectivity_[inputOrder_[i]].timeToDropValue()) {
+    if (isCheaper(inputOrder_[i], inputOrder_[i - 1], useStats)) {
       reorder = true;
       break;
     }
   }
   if (reorder) {
-    std::sort(
+    std::stable_sort(
         inputOrder_.begin(),
         inputOrder_.end(),
-        [this](size_t left, size_t right) {
-          return selectivity_[left].timeToDropValue() <
-              selectivity_[right].timeToDropValue();
+        [this, useStats](int32_t left, int32_t right) {
+          return isCheaper(left, right, useStats);
         });
   }
 }
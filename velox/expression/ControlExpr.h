@@ -200,6 +200,10 @@ class ConjunctExpr : public SpecialForm {
     selectivity_.resize(inputs_.size());
     inputOrder_.resize(inputs_.size());
     std::iota(inputOrder_.begin(), inputOrder_.end(), 0);
+    estimatedCost_.reserve(inputs_.size());
+    for (auto& input : inputs_) {
+      estimatedCost_.push_back(estimateCost(*input));
+    }
   }
 
   void evalSpecialForm(
@@ -220,7 +224,21 @@ class ConjunctExpr : public SpecialForm {
   }
 
  private:
+  // Returns a static estimate of the per-row cost of evaluating 'expr'. Used
+  // to order inputs before any run time statistics are available.
+  static int32_t estimateCost(const Expr& expr);
+
+  // Orders the inputs by estimated cost. Called before the first batch if
+  // adaptive reordering is enabled.
+  void orderByEstimatedCost();
+
   void maybeReorderInputs();
+
+  // Returns true if the input at 'left' is expected to drop rows more cheaply
+  // than the input at 'right'. Compares the observed time per dropped row if
+  // 'useStats' is true, the estimated cost otherwise.
+  bool isCheaper(int32_t left, int32_t right, bool useStats) const;
+
   void updateResult(
       BaseVector* inputResult,
       EvalCtx* context,
@@ -239,6 +257,8 @@ class ConjunctExpr : public SpecialForm {
   bool reorderEnabled_;
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
+  // Static cost estimate for each input, indexed like 'inputs_'.
+  std::vector<int32_t> estimatedCost_;
 };
 
 class LambdaExpr : public SpecialForm {
@@ -182,6 +182,35 @@ class EvalCtx {
     wrapNulls_ = std::move(wrapNulls);
   }
 
+  /// Returns a flat vector of 'type' and 'size' from the vector pool of the
+  /// ExecCtx.
+  VectorPtr getVector(const TypePtr& type, vector_size_t size) {
+    return execCtx_->getVector(type, size);
+  }
+
+  /// Returns 'vector' to the vector pool of the ExecCtx if it is not
+  /// referenced from elsewhere.
+  bool releaseVector(VectorPtr& vector) {
+    return execCtx_->releaseVector(vector);
+  }
+
+  size_t releaseVectors(std::vector<VectorPtr>& vectors) {
+    return execCtx_->releaseVectors(vectors);
+  }
+
+  /// Same as BaseVector::ensureWritable() except that a new '*result' comes
+  /// from the vector pool.
+  void ensureWritable(
+      const SelectivityVector& rows,
+      const TypePtr& type,
+      VectorPtr* result) {
+    if (!*result) {
+      *result = getVector(type, rows.size());
+      return;
+    }
+    BaseVector::ensureWritable(rows, type, pool(), result);
+  }
+
   // Copy "rows" of localResult into results if "result" is partially populated
   // and must be preserved. Copy localResult pointer into result otherwise.
   void moveOrCopyResult(
@@ -749,7 +749,7 @@ void Expr::evalWithMemo(
       auto cached = cachedHolder.get();
       cached->intersect(*cachedDictionaryIndices_);
       if (cached->hasSelections()) {
-        BaseVector::ensureWritable(rows, type(), context->pool(), result);
+        context->ensureWritable(rows, type(), result);
         (*result)->copy(dictionaryCache_.get(), *cached, nullptr);
       }
     }
@@ -815,7 +815,7 @@ void Expr::setAllNulls(
     EvalCtx* context,
     VectorPtr* result) const {
   if (*result) {
-    BaseVector::ensureWritable(rows, type(), context->pool(), result);
+    context->ensureWritable(rows, type(), result);
     LocalSelectivityVector notNulls(context, rows.end());
     notNulls.get()->setAll();
     notNulls.get()->deselect(rows);
@@ -971,6 +971,9 @@ void Expr::evalAll(
   if (remainingRows != &rows) {
     addNulls(rows, remainingRows->asRange().bits(), context, result);
   }
+  // Arguments that are not referenced from elsewhere, e.g. the results of
+  // nested function calls, are recycled for later results.
+  context->releaseVectors(inputValues_);
   inputValues_.clear();
 }
 
@@ -1173,7 +1176,7 @@ void Expr::applySingleConstArgVectorFunction(
   vectorFunction_->apply(*inputRows, args, type(), context, &tempResult);
 
   if (*result && !context->isFinalSelection()) {
-    BaseVector::ensureWritable(rows, type(), context->pool(), result);
+    context->ensureWritable(rows, type(), result);
     (*result)->copy(tempResult.get(), resultRow, inputRow, 1);
   } else {
     // TODO Move is available only for flat vectors. Check if tempResult is
@@ -72,7 +72,7 @@ class SimpleFunctionAdapter : public VectorFunction {
         EvalCtx* _context,
         VectorPtr* _result)
         : rows{_rows}, context{_context} {
-      BaseVector::ensureWritable(*rows, outputType, context->pool(), _result);
+      context->ensureWritable(*rows, outputType, _result);
       result = reinterpret_cast<result_vector_t*>((*_result).get());
       resultWriter.init(*result);
     }
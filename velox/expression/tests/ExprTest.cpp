@@ -942,6 +942,31 @@ TEST_F(ExprTest, reorder) {
   }
 }
 
+TEST_F(ExprTest, reorderByEstimatedCost) {
+  constexpr int32_t kSize = 1'000;
+  auto input = makeRowVector(
+      {makeFlatVector<int64_t>(kSize, [](auto row) { return row + 10; }),
+       makeFlatVector<StringView>(
+           kSize, [](auto /*row*/) { return StringView("xyz"); })});
+  auto exprSet = compileExpression(
+      "strpos(c1, 'x') > 0 and c0 = 5",
+      std::dynamic_pointer_cast<const RowType>(input->type()));
+
+  auto condition =
+      std::dynamic_pointer_cast<exec::ConjunctExpr>(exprSet->expr(0));
+  ASSERT_TRUE(condition != nullptr);
+  // The integer comparison is cheaper than the string function, so it runs
+  // first. It drops all rows and strpos is never evaluated. strpos has no
+  // time per dropped row, which must not move it first on later batches.
+  for (auto i = 0; i < 5; ++i) {
+    auto result = evaluate(exprSet.get(), input);
+    assertEqualVectors(
+        BaseVector::createConstant(false, kSize, execCtx_->pool()), result);
+    EXPECT_EQ((i + 1) * kSize, condition->selectivityAt(0).numIn());
+    EXPECT_EQ(0, condition->selectivityAt(1).numIn());
+  }
+}
+
 TEST_F(ExprTest, constant) {
   auto expr = compileExpression("1 + 2 + 3 + 4");
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(expr);
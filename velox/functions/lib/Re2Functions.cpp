@@ -15,14 +15,19 @@
  */
 #include "velox/functions/lib/Re2Functions.h"
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 #include <re2/re2.h>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorUdfTypeSystem.h"
 #include "velox/functions/lib/ArrayBuilder.h"
+#include "velox/functions/lib/string/StringCore.h"
 #include "velox/type/StringView.h"
 #include "velox/vector/FlatVector.h"
 
@@ -94,6 +99,119 @@ bool re2PartialMatch(StringView str, const RE2& re) {
   return RE2::PartialMatch(toStringPiece(str), re);
 }
 
+// Returns the offset of the first occurrence of 'needle' in 'text' or -1.
+// With AVX2, compares the first and the last byte of 'needle' with 32
+// consecutive positions of 'text' at a time and compares the rest of 'needle'
+// only where both match.
+int64_t findSubstring(std::string_view text, std::string_view needle) {
+  const int64_t size = text.size();
+  const int64_t needleSize = needle.size();
+  if (needleSize == 0) {
+    return 0;
+  }
+  if (needleSize > size) {
+    return -1;
+  }
+  if (needleSize == 1) {
+    auto found = memchr(text.data(), needle[0], size);
+    return found ? static_cast<const char*>(found) - text.data() : -1;
+  }
+  int64_t offset = 0;
+#ifdef __AVX2__
+  const auto first = _mm256_set1_epi8(needle[0]);
+  const auto last = _mm256_set1_epi8(needle[needleSize - 1]);
+  for (; offset + needleSize + 31 <= size; offset += 32) {
+    auto firstBlock = _mm256_loadu_si256((__m256i*)(text.data() + offset));
+    auto lastBlock =
+        _mm256_loadu_si256((__m256i*)(text.data() + offset + needleSize - 1));
+    uint32_t candidates = _mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(first, firstBlock),
+        _mm256_cmpeq_epi8(last, lastBlock)));
+    while (candidates) {
+      auto start = offset + __builtin_ctz(candidates);
+      if (memcmp(
+              text.data() + start + 1, needle.data() + 1, needleSize - 2) ==
+          0) {
+        return start;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+#endif
+  auto found = text.substr(offset).find(needle);
+  return found == std::string_view::npos ? -1 : offset + found;
+}
+
+bool startsWith(std::string_view text, std::string_view prefix) {
+  return text.size() >= prefix.size() &&
+      memcmp(text.data(), prefix.data(), prefix.size()) == 0;
+}
+
+bool endsWith(std::string_view text, std::string_view suffix) {
+  return text.size() >= suffix.size() &&
+      memcmp(text.data() + text.size() - suffix.size(),
+             suffix.data(),
+             suffix.size()) == 0;
+}
+
+// Matches literal fragments separated by '%'. Each fragment between the
+// anchored first and last one is matched at its leftmost position after the
+// previous one.
+bool matchSubstrings(
+    std::string_view text,
+    const std::vector<std::string>& fragments) {
+  const auto& first = fragments.front();
+  const auto& last = fragments.back();
+  if (text.size() < first.size() + last.size() || !startsWith(text, first) ||
+      !endsWith(text, last)) {
+    return false;
+  }
+  text = text.substr(first.size(), text.size() - first.size() - last.size());
+  for (auto i = 1; i < fragments.size() - 1; ++i) {
+    auto offset = findSubstring(text, fragments[i]);
+    if (offset < 0) {
+      return false;
+    }
+    text.remove_prefix(offset + fragments[i].size());
+  }
+  return true;
+}
+
+// Matches a pattern with '_' wildcards and no '%'. For ASCII input each
+// wildcard is one byte. Otherwise, a wildcard is one UTF-8 character.
+template <bool isAscii>
+bool matchWithWildcards(
+    std::string_view text,
+    const std::string& pattern,
+    const std::vector<bool>& wildcards) {
+  if constexpr (isAscii) {
+    if (text.size() != pattern.size()) {
+      return false;
+    }
+    for (auto i = 0; i < pattern.size(); ++i) {
+      if (!wildcards[i] && text[i] != pattern[i]) {
+        return false;
+      }
+    }
+    return true;
+  } else {
+    size_t pos = 0;
+    for (auto i = 0; i < pattern.size(); ++i) {
+      if (pos >= text.size()) {
+        return false;
+      }
+      if (wildcards[i]) {
+        // Bytes that do not start a valid character count as one character,
+        // as in RE2.
+        pos += std::max(1, utf8proc_char_length(text.data() + pos));
+      } else if (text[pos++] != pattern[i]) {
+        return false;
+      }
+    }
+    return pos == text.size();
+  }
+}
+
 bool re2Extract(
     FlatVector<StringView>& result,
     int row,
@@ -132,7 +250,8 @@ std::string likePatternToRe2(
   std::string regex;
   validPattern = true;
   regex.reserve(pattern.size() * 2);
-  regex.append("^");
+  // '%' and '_' match any character, including new lines.
+  regex.append("(?s)^");
   bool escaped = false;
   for (const char c : pattern) {
     if (escaped && !(c == '%' || c == '_' || c == escapeChar)) {
@@ -186,7 +305,9 @@ template <bool (*Fn)(StringView, const RE2&)>
 class Re2MatchConstantPattern final : public VectorFunction {
  public:
   explicit Re2MatchConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+      : re_(toStringPiece(pattern), RE2::Quiet),
+        patternMetadata_(
+            determineRegexpPatternKind(pattern, Fn == re2FullMatch)) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -199,6 +320,16 @@ class Re2MatchConstantPattern final : public VectorFunction {
         ensureWritableBool(rows, context->pool(), resultRef);
     exec::LocalDecodedVector toSearch(context, *args[0], rows);
     checkForBadPattern(re_);
+    if (patternMetadata_.kind != PatternKind::kGeneric) {
+      // Literal patterns have no wildcards, so ASCII-ness does not matter.
+      rows.applyToSelected([&](vector_size_t i) {
+        result.set(
+            i,
+            matchPattern(
+                patternMetadata_, toSearch->valueAt<StringView>(i), false));
+      });
+      return;
+    }
     rows.applyToSelected([&](vector_size_t i) {
       result.set(i, Fn(toSearch->valueAt<StringView>(i), re_));
     });
@@ -206,6 +337,7 @@ class Re2MatchConstantPattern final : public VectorFunction {
 
  private:
   RE2 re_;
+  const PatternMetadata patternMetadata_;
 };
 
 template <bool (*Fn)(StringView, const RE2&)>
@@ -381,7 +513,8 @@ class LikeConstantPattern final : public VectorFunction {
  public:
   LikeConstantPattern(StringView pattern, std::optional<char> escapeChar)
       : re_(toStringPiece(likePatternToRe2(pattern, escapeChar, validPattern_)),
-            RE2::Quiet) {}
+            RE2::Quiet),
+        patternMetadata_(determineLikePatternKind(pattern, escapeChar)) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -407,14 +540,34 @@ class LikeConstantPattern final : public VectorFunction {
     auto toSearch = decodedArgs.at(0);
     if (toSearch->isIdentityMapping()) {
       auto rawStrings = toSearch->data<StringView>();
+      if (patternMetadata_.kind == PatternKind::kGeneric) {
+        rows.applyToSelected([&](vector_size_t i) {
+          result.set(i, re2FullMatch(rawStrings[i], re_));
+        });
+        return;
+      }
+      // ASCII-ness only matters for '_' wildcards. Use it if known.
+      bool isAscii = false;
+      if (patternMetadata_.kind == PatternKind::kExactWithWildcards) {
+        isAscii = toSearch->base()
+                      ->asUnchecked<SimpleVector<StringView>>()
+                      ->isAscii(rows)
+                      .value_or(false);
+      }
       rows.applyToSelected([&](vector_size_t i) {
-        result.set(i, re2FullMatch(rawStrings[i], re_));
+        result.set(i, matchPattern(patternMetadata_, rawStrings[i], isAscii));
       });
       return;
     }
 
     if (toSearch->isConstantMapping()) {
-      bool match = re2FullMatch(toSearch->valueAt<StringView>(0), re_);
+      auto value = toSearch->valueAt<StringView>(0);
+      bool match = patternMetadata_.kind == PatternKind::kGeneric
+          ? re2FullMatch(value, re_)
+          : matchPattern(
+                patternMetadata_,
+                value,
+                stringCore::isAscii(value.data(), value.size()));
       rows.applyToSelected([&](vector_size_t i) { result.set(i, match); });
       return;
     }
@@ -428,6 +581,7 @@ class LikeConstantPattern final : public VectorFunction {
  private:
   RE2 re_;
   bool validPattern_;
+  const PatternMetadata patternMetadata_;
 };
 
 void re2ExtractAll(
@@ -874,4 +1028,151 @@ re2ExtractAllSignatures() {
   };
 }
 
+PatternMetadata determineLikePatternKind(
+    StringView pattern,
+    std::optional<char> escapeChar) {
+  PatternMetadata metadata;
+  std::vector<std::string> fragments(1);
+  std::vector<bool> wildcards;
+  bool hasPercent = false;
+  bool hasWildcard = false;
+  bool escaped = false;
+  for (const char c : pattern) {
+    if (escaped) {
+      if (!(c == '%' || c == '_' || c == escapeChar)) {
+        // Invalid pattern. Reported by LikeConstantPattern.
+        return metadata;
+      }
+      fragments.back().push_back(c);
+      wildcards.push_back(false);
+      escaped = false;
+    } else if (c == escapeChar) {
+      escaped = true;
+    } else if (c == '%') {
+      hasPercent = true;
+      fragments.emplace_back();
+    } else {
+      hasWildcard |= c == '_';
+      fragments.back().push_back(c);
+      wildcards.push_back(c == '_');
+    }
+  }
+  if (escaped) {
+    return metadata;
+  }
+
+  if (!hasPercent) {
+    if (hasWildcard) {
+      metadata.kind = PatternKind::kExactWithWildcards;
+      metadata.wildcards = std::move(wildcards);
+    } else {
+      metadata.kind = PatternKind::kExact;
+    }
+    metadata.fragments = std::move(fragments);
+    return metadata;
+  }
+  if (hasWildcard) {
+    return metadata;
+  }
+
+  // Consecutive '%' are the same as one.
+  metadata.fragments.push_back(std::move(fragments.front()));
+  for (auto i = 1; i < fragments.size() - 1; ++i) {
+    if (!fragments[i].empty()) {
+      metadata.fragments.push_back(std::move(fragments[i]));
+    }
+  }
+  metadata.fragments.push_back(std::move(fragments.back()));
+
+  const auto& newFragments = metadata.fragments;
+  if (newFragments.size() == 2 && newFragments[1].empty()) {
+    metadata.kind = PatternKind::kPrefix;
+  } else if (newFragments.size() == 2 && newFragments[0].empty()) {
+    metadata.kind = PatternKind::kSuffix;
+  } else if (
+      newFragments.size() == 3 && newFragments[0].empty() &&
+      newFragments[2].empty()) {
+    metadata.kind = PatternKind::kSubstring;
+  } else {
+    metadata.kind = PatternKind::kSubstrings;
+  }
+  return metadata;
+}
+
+PatternMetadata determineRegexpPatternKind(StringView pattern, bool fullMatch) {
+  PatternMetadata metadata;
+  std::string_view literal(pattern.data(), pattern.size());
+  const bool anchoredAtStart = !literal.empty() && literal.front() == '^';
+  if (anchoredAtStart) {
+    literal.remove_prefix(1);
+  }
+  const bool anchoredAtEnd = !literal.empty() && literal.back() == '$';
+  if (anchoredAtEnd) {
+    literal.remove_suffix(1);
+  }
+  for (const char c : literal) {
+    switch (c) {
+      case '\\':
+      case '|':
+      case '^':
+      case '$':
+      case '.':
+      case '*':
+      case '+':
+      case '?':
+      case '(':
+      case ')':
+      case '[':
+      case ']':
+      case '{':
+      case '}':
+        return metadata;
+      default:
+        break;
+    }
+  }
+
+  std::string text(literal);
+  if (fullMatch || (anchoredAtStart && anchoredAtEnd)) {
+    metadata.kind = PatternKind::kExact;
+    metadata.fragments = {std::move(text)};
+  } else if (anchoredAtStart) {
+    metadata.kind = PatternKind::kPrefix;
+    metadata.fragments = {std::move(text), ""};
+  } else if (anchoredAtEnd) {
+    metadata.kind = PatternKind::kSuffix;
+    metadata.fragments = {"", std::move(text)};
+  } else {
+    metadata.kind = PatternKind::kSubstring;
+    metadata.fragments = {"", std::move(text), ""};
+  }
+  return metadata;
+}
+
+bool matchPattern(
+    const PatternMetadata& pattern,
+    StringView input,
+    bool isAscii) {
+  std::string_view text(input.data(), input.size());
+  const auto& fragments = pattern.fragments;
+  switch (pattern.kind) {
+    case PatternKind::kExact:
+      return text == fragments[0];
+    case PatternKind::kExactWithWildcards:
+      return isAscii
+          ? matchWithWildcards<true>(text, fragments[0], pattern.wildcards)
+          : matchWithWildcards<false>(text, fragments[0], pattern.wildcards);
+    case PatternKind::kPrefix:
+      return startsWith(text, fragments[0]);
+    case PatternKind::kSuffix:
+      return endsWith(text, fragments[1]);
+    case PatternKind::kSubstring:
+      return findSubstring(text, fragments[1]) >= 0;
+    case PatternKind::kSubstrings:
+      return matchSubstrings(text, fragments);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 } // namespace facebook::velox::functions
@@ -16,6 +16,8 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include <re2/re2.h>
@@ -84,6 +86,57 @@ std::shared_ptr<exec::VectorFunction> makeLike(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> likeSignatures();
 
+/// Kinds of constant LIKE and regular expression patterns that are matched
+/// without RE2.
+enum class PatternKind {
+  /// Literal text, e.g. LIKE 'abc'.
+  kExact,
+  /// Literal text with '_' wildcards and no '%', e.g. LIKE 'a_c'.
+  kExactWithWildcards,
+  /// Literal text followed by '%', e.g. LIKE 'abc%'.
+  kPrefix,
+  /// Literal text after '%', e.g. LIKE '%abc'.
+  kSuffix,
+  /// Literal text between two '%', e.g. LIKE '%abc%'.
+  kSubstring,
+  /// Several literal texts separated by '%', e.g. LIKE 'ab%cd%ef'.
+  kSubstrings,
+  /// Any other pattern. Matched with RE2.
+  kGeneric,
+};
+
+struct PatternMetadata {
+  PatternKind kind{PatternKind::kGeneric};
+
+  /// Literal text of the pattern with escapes removed, split at '%'. The first
+  /// and last fragments are anchored at the start and the end of the input
+  /// and may be empty. Empty fragments in between are left out. kExact and
+  /// kExactWithWildcards have a single fragment.
+  std::vector<std::string> fragments;
+
+  /// For kExactWithWildcards, true for each byte of fragments[0] that is a
+  /// '_' wildcard rather than a literal '_'.
+  std::vector<bool> wildcards;
+};
+
+/// Classifies a LIKE pattern. Invalid patterns are kGeneric.
+PatternMetadata determineLikePatternKind(
+    StringView pattern,
+    std::optional<char> escapeChar);
+
+/// Classifies a regular expression. Only literals without metacharacters,
+/// optionally anchored with '^' and '$', are recognized. If 'fullMatch' is
+/// true, the expression must match the whole input, as in re2Match().
+PatternMetadata determineRegexpPatternKind(StringView pattern, bool fullMatch);
+
+/// Returns true if 'input' matches 'pattern', which must not be kGeneric.
+/// 'isAscii' tells that 'input' has only ASCII characters, so that '_'
+/// wildcards match single bytes.
+bool matchPattern(
+    const PatternMetadata& pattern,
+    StringView input,
+    bool isAscii);
+
 /// re2ExtractAll(string, pattern, group_id) → array<string>
 /// re2ExtractAll(string, pattern) → array<string>
 ///
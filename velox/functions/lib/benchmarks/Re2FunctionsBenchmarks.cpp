@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <fmt/format.h>
+#include <fmt/format.h>
 #include <folly/Benchmark.h>
 #include <folly/Conv.h>
 #include <folly/init/Init.h>
@@ -82,6 +83,54 @@ BENCHMARK_NAMED_PARAM_MULTI(regexExtract, bs1k, 1 << 10);
 BENCHMARK_NAMED_PARAM_MULTI(regexExtract, bs10k, 10 << 10);
 BENCHMARK_NAMED_PARAM_MULTI(regexExtract, bs100k, 100 << 10);
 
+// Evaluates 'functionName(c0, pattern)' on random strings. The pattern
+// classes LIKE and re2_search recognize are matched without RE2.
+int evaluatePattern(
+    int n,
+    int blockSize,
+    const char* functionName,
+    const char* pattern) {
+  folly::BenchmarkSuspender kSuspender;
+  FunctionBenchmarkBase benchmarkBase;
+
+  VectorFuzzer::Options opts;
+  opts.vectorSize = blockSize;
+  opts.stringLength = 100;
+  auto vector = VectorFuzzer(opts, benchmarkBase.pool()).fuzzFlat(VARCHAR());
+  const auto data = benchmarkBase.maker().rowVector({vector});
+
+  exec::ExprSet expr = benchmarkBase.compileExpression(
+      fmt::format("{}(c0, '{}')", functionName, pattern), data->type());
+  kSuspender.dismiss();
+  for (int i = 0; i != n; ++i) {
+    benchmarkBase.evaluate(expr, data);
+  }
+  return n * blockSize;
+}
+
+int like(int n, int blockSize, const char* pattern) {
+  return evaluatePattern(n, blockSize, "like", pattern);
+}
+
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(like, exact, 10 << 10, "abcdef");
+BENCHMARK_NAMED_PARAM_MULTI(like, exactWithWildcards, 10 << 10, "ab_d_f");
+BENCHMARK_NAMED_PARAM_MULTI(like, prefix, 10 << 10, "abc%");
+BENCHMARK_NAMED_PARAM_MULTI(like, suffix, 10 << 10, "%abc");
+BENCHMARK_NAMED_PARAM_MULTI(like, substring, 10 << 10, "%abc%");
+BENCHMARK_NAMED_PARAM_MULTI(like, substrings, 10 << 10, "%ab%cd%ef%");
+BENCHMARK_NAMED_PARAM_MULTI(like, generic, 10 << 10, "_b%c");
+
+int regexSearchLiteral(int n, int blockSize, const char* pattern) {
+  return evaluatePattern(n, blockSize, "re2_search", pattern);
+}
+
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(regexSearchLiteral, substring, 10 << 10, "abc");
+BENCHMARK_NAMED_PARAM_MULTI(regexSearchLiteral, prefix, 10 << 10, "^abc");
+BENCHMARK_NAMED_PARAM_MULTI(regexSearchLiteral, suffix, 10 << 10, "abc$");
+BENCHMARK_NAMED_PARAM_MULTI(regexSearchLiteral, generic, 10 << 10, "ab+c");
+
 } // namespace
 
 std::shared_ptr<exec::VectorFunction> makeRegexExtract(
@@ -97,6 +146,7 @@ void registerRe2Functions() {
       "re2_search", re2SearchSignatures(), makeRe2Search);
   exec::registerStatefulVectorFunction(
       "re2_extract", re2ExtractSignatures(), makeRegexExtract);
+  exec::registerStatefulVectorFunction("like", likeSignatures(), makeLike);
 }
 
 } // namespace facebook::velox::functions::test
@@ -22,6 +22,7 @@
 #include <string>
 
 #include "velox/common/base/VeloxException.h"
+#include "velox/functions/lib/string/StringCore.h"
 #include "velox/functions/prestosql/tests/FunctionBaseTest.h"
 #include "velox/parse/TypeResolver.h"
 #include "velox/type/StringView.h"
@@ -411,6 +412,132 @@ TEST_F(Re2FunctionsTest, likePatternAndEscape) {
   EXPECT_THROW(like("abcd", "a#}#+", '#'), std::exception);
 }
 
+TEST_F(Re2FunctionsTest, likePatternKind) {
+  auto kind = [](const std::string& pattern,
+                 std::optional<char> escape = std::nullopt) {
+    return determineLikePatternKind(StringView(pattern), escape).kind;
+  };
+
+  EXPECT_EQ(kind("abc"), PatternKind::kExact);
+  EXPECT_EQ(kind("a#%c", '#'), PatternKind::kExact);
+  EXPECT_EQ(kind("a_c"), PatternKind::kExactWithWildcards);
+  EXPECT_EQ(kind("___"), PatternKind::kExactWithWildcards);
+  EXPECT_EQ(kind("abc%"), PatternKind::kPrefix);
+  EXPECT_EQ(kind("abc%%"), PatternKind::kPrefix);
+  EXPECT_EQ(kind("%"), PatternKind::kPrefix);
+  EXPECT_EQ(kind("%abc"), PatternKind::kSuffix);
+  EXPECT_EQ(kind("%abc%"), PatternKind::kSubstring);
+  EXPECT_EQ(kind("%%abc%%"), PatternKind::kSubstring);
+  EXPECT_EQ(kind("%#_%", '#'), PatternKind::kSubstring);
+  EXPECT_EQ(kind("ab%cd"), PatternKind::kSubstrings);
+  EXPECT_EQ(kind("%ab%cd%"), PatternKind::kSubstrings);
+  EXPECT_EQ(kind("_b%"), PatternKind::kGeneric);
+  EXPECT_EQ(kind("a#}#+", '#'), PatternKind::kGeneric);
+  EXPECT_EQ(kind("abc#", '#'), PatternKind::kGeneric);
+
+  auto metadata = determineLikePatternKind(StringView("%%ab%%cd%ef"), '#');
+  EXPECT_EQ(
+      metadata.fragments, (std::vector<std::string>{"", "ab", "cd", "ef"}));
+}
+
+TEST_F(Re2FunctionsTest, regexpPatternKind) {
+  auto kind = [](const std::string& pattern, bool fullMatch) {
+    return determineRegexpPatternKind(StringView(pattern), fullMatch).kind;
+  };
+
+  EXPECT_EQ(kind("abc", false), PatternKind::kSubstring);
+  EXPECT_EQ(kind("^abc", false), PatternKind::kPrefix);
+  EXPECT_EQ(kind("abc$", false), PatternKind::kSuffix);
+  EXPECT_EQ(kind("^abc$", false), PatternKind::kExact);
+  EXPECT_EQ(kind("abc", true), PatternKind::kExact);
+  EXPECT_EQ(kind("a-b c,d", false), PatternKind::kSubstring);
+  EXPECT_EQ(kind("a.c", false), PatternKind::kGeneric);
+  EXPECT_EQ(kind("a\\.c", false), PatternKind::kGeneric);
+  EXPECT_EQ(kind("a$c", false), PatternKind::kGeneric);
+  EXPECT_EQ(kind("[abc]", true), PatternKind::kGeneric);
+}
+
+// Compares patterns matched without RE2 with the same patterns evaluated by
+// RE2, on inputs long enough to exercise the vectorized substring search.
+TEST_F(Re2FunctionsTest, patternFastPaths) {
+  const std::string longText(100, 'x');
+  const std::vector<std::string> inputs = {
+      "",
+      "abc",
+      "ab",
+      "xabcx",
+      "abcabc",
+      "a\nc",
+      "a_c",
+      longText,
+      longText + "abc",
+      "abc" + longText,
+      longText + "ab" + longText + "c",
+      longText + "abc" + longText + "def" + longText,
+      longText + "def" + longText + "abc" + longText,
+      "\u4FE1\u5FF5 \u7231 abc \u5E0C\u671B",
+      "\u4FE1bc",
+  };
+  const std::vector<std::string> likePatterns = {
+      "abc",
+      "a_c",
+      "___",
+      "_bc",
+      "abc%",
+      "%abc",
+      "%abc%",
+      "%abc%def%",
+      "ab%c",
+      "%",
+      "",
+  };
+  const std::vector<std::string> regexpPatterns = {
+      "abc", "^abc", "abc$", "^abc$", "def", "", "^", "$"};
+
+  for (const auto& pattern : likePatterns) {
+    auto metadata = determineLikePatternKind(StringView(pattern), std::nullopt);
+    ASSERT_NE(metadata.kind, PatternKind::kGeneric) << pattern;
+    std::string regex = "(?s)^";
+    for (auto c : pattern) {
+      if (c == '%') {
+        regex += ".*";
+      } else if (c == '_') {
+        regex += ".";
+      } else {
+        regex += RE2::QuoteMeta(std::string(1, c));
+      }
+    }
+    regex += "$";
+    RE2 re(regex);
+    for (const auto& input : inputs) {
+      SCOPED_TRACE(fmt::format("{} LIKE {}", input, pattern));
+      bool expected = RE2::FullMatch(input, re);
+      EXPECT_EQ(matchPattern(metadata, StringView(input), false), expected);
+      if (stringCore::isAscii(input.data(), input.size())) {
+        EXPECT_EQ(matchPattern(metadata, StringView(input), true), expected);
+      }
+      EXPECT_EQ(
+          evaluateOnce<bool>(
+              "like(c0, '" + pattern + "')", std::optional(input)),
+          expected);
+    }
+  }
+
+  for (const auto& pattern : regexpPatterns) {
+    for (const auto& input : inputs) {
+      SCOPED_TRACE(fmt::format("{} ~ {}", input, pattern));
+      EXPECT_EQ(
+          evaluateOnce<bool>(
+              "re2_search(c0, '" + pattern + "')", std::optional(input)),
+          RE2::PartialMatch(input, RE2(pattern)));
+      EXPECT_EQ(
+          evaluateOnce<bool>(
+              "re2_match(c0, '" + pattern + "')", std::optional(input)),
+          RE2::FullMatch(input, RE2(pattern)));
+    }
+  }
+}
+
 template <typename T>
 void Re2FunctionsTest::testRe2ExtractAll(
     const std::vector<std::optional<std::string>>& inputs,
@@ -38,6 +38,10 @@ class ArrayAggAggregate : public exec::Aggregate {
     return false;
   }
 
+  bool acceptsOwnIntermediateResults() const override {
+    return true;
+  }
+
   void initializeNewGroups(
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/prestosql/json/JsonExtractor.h"
+
+using namespace facebook::velox::functions;
+
+namespace {
+
+constexpr int32_t kNumDocuments = 1'000;
+
+// Event-like documents with a few small top level fields followed by a large
+// nested payload.
+std::vector<std::string> makeDocuments() {
+  std::vector<std::string> documents;
+  documents.reserve(kNumDocuments);
+  for (auto i = 0; i < kNumDocuments; ++i) {
+    std::string payload;
+    for (auto j = 0; j < 20; ++j) {
+      payload += fmt::format(
+          "{}{{\"id\": {}, \"tags\": [\"a\", \"b\\\"c\"], \"score\": {}.5}}",
+          j == 0 ? "" : ", ",
+          i * 20 + j,
+          j);
+    }
+    documents.push_back(fmt::format(
+        "{{\"user\": {{\"id\": {}, \"country\": \"US\"}}, "
+        "\"type\": \"click\", \"items\": [{}], \"ts\": {}}}",
+        i,
+        payload,
+        1'600'000'000 + i));
+  }
+  return documents;
+}
+
+const std::vector<std::string>& documents() {
+  static const auto kDocuments = makeDocuments();
+  return kDocuments;
+}
+
+size_t extractFromDynamic(const std::string& path) {
+  size_t count = 0;
+  for (const auto& document : documents()) {
+    count += jsonExtractScalarFromDynamic(document, path).hasValue();
+  }
+  return count;
+}
+
+size_t extractOnDemand(const std::string& path) {
+  size_t count = 0;
+  for (const auto& document : documents()) {
+    count += jsonExtractScalar(document, path).hasValue();
+  }
+  return count;
+}
+
+BENCHMARK(leadingFieldDynamic) {
+  folly::doNotOptimizeAway(extractFromDynamic("$.user.country"));
+}
+
+BENCHMARK_RELATIVE(leadingFieldOnDemand) {
+  folly::doNotOptimizeAway(extractOnDemand("$.user.country"));
+}
+
+BENCHMARK(trailingFieldDynamic) {
+  folly::doNotOptimizeAway(extractFromDynamic("$.ts"));
+}
+
+BENCHMARK_RELATIVE(trailingFieldOnDemand) {
+  folly::doNotOptimizeAway(extractOnDemand("$.ts"));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  documents();
+  folly::runBenchmarks();
+  return 0;
+}
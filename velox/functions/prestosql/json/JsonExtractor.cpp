@@ -25,6 +25,7 @@
 #include "folly/json.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
+#include "velox/functions/prestosql/json/OnDemandJsonExtractor.h"
 
 namespace facebook::velox::functions {
 
@@ -35,6 +36,11 @@ thread_local std::unordered_map<std::string, std::shared_ptr<JsonExtractor>>
 
 thread_local JsonPathTokenizer kTokenizer;
 
+// Cache of OnDemandJsonExtractors for jsonExtractScalar.
+thread_local std::
+    unordered_map<std::string, std::shared_ptr<OnDemandJsonExtractor>>
+        kOnDemandExtractorCache;
+
 static const std::string kIgnoreChars = " \n\t\r\\";
 // Max extractor number in extractor cache
 static const uint32_t kMaxCacheNum = 32;
@@ -192,7 +198,7 @@ folly::Optional<folly::dynamic> jsonExtract(
   return folly::none;
 }
 
-folly::Optional<std::string> jsonExtractScalar(
+folly::Optional<std::string> jsonExtractScalarFromDynamic(
     folly::StringPiece json,
     folly::StringPiece path) {
   auto res = jsonExtract(json, path);
@@ -203,15 +209,30 @@ folly::Optional<std::string> jsonExtractScalar(
   return folly::none;
 }
 
+folly::Optional<std::string> jsonExtractScalar(
+    folly::StringPiece json,
+    folly::StringPiece path) {
+  auto trimmedPath = folly::trimWhitespace(path).str();
+
+  std::shared_ptr<OnDemandJsonExtractor> op;
+  auto it = kOnDemandExtractorCache.find(trimmedPath);
+  if (it != kOnDemandExtractorCache.end()) {
+    op = it->second;
+  } else {
+    if (kOnDemandExtractorCache.size() == kMaxCacheNum) {
+      // TODO: Blindly evict the first one, use better policy
+      kOnDemandExtractorCache.erase(kOnDemandExtractorCache.begin());
+    }
+    op = std::make_shared<OnDemandJsonExtractor>(trimmedPath);
+    kOnDemandExtractorCache[trimmedPath] = op;
+  }
+  return op->extractScalar(json);
+}
+
 folly::Optional<std::string> jsonExtractScalar(
     const std::string& json,
     const std::string& path) {
-  auto res = jsonExtract(json, path);
-  // Not a scalar value
-  if (isScalarType(res)) {
-    return res->asString();
-  }
-  return folly::none;
+  return jsonExtractScalar(folly::StringPiece(json), folly::StringPiece(path));
 }
 
 } // namespace facebook::velox::functions
@@ -61,10 +61,19 @@ folly::Optional<folly::dynamic> jsonExtract(
     const folly::dynamic& json,
     folly::StringPiece path);
 
+/// Like jsonExtract(), but returns the value as a string if it is a scalar
+/// (boolean, number or string) and folly::none otherwise. Only the values on
+/// 'path' are parsed, see OnDemandJsonExtractor.
 folly::Optional<std::string> jsonExtractScalar(
     folly::StringPiece json,
     folly::StringPiece path);
 
+/// Same as jsonExtractScalar(), but parses the whole of 'json' into a
+/// folly::dynamic. Used for paths with wildcards and for malformed documents.
+folly::Optional<std::string> jsonExtractScalarFromDynamic(
+    folly::StringPiece json,
+    folly::StringPiece path);
+
 folly::Optional<folly::dynamic> jsonExtract(
     const std::string& json,
     const std::string& path);
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/json/OnDemandJsonExtractor.h"
+
+#include <cstring>
+
+#include "folly/Conv.h"
+#include "folly/String.h"
+#include "folly/json.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/functions/prestosql/json/JsonExtractor.h"
+#include "velox/functions/prestosql/json/JsonPathTokenizer.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+bool isDelimiter(char c) {
+  return c == ',' || c == ']' || c == '}' || c == ' ' || c == '\n' ||
+      c == '\t' || c == '\r';
+}
+
+// True if the contents of a JSON string can be returned as is, i.e. there are
+// no escapes to decode and no control characters for the parser to reject.
+bool isPlainString(folly::StringPiece text) {
+  for (auto c : text) {
+    if (c == '\\' || static_cast<unsigned char>(c) < 0x20) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Parses a JSON scalar with folly and returns it as a string the same way
+// jsonExtractScalar() does. Returns false if 'text' is not a valid scalar.
+bool parseScalar(
+    folly::StringPiece text,
+    folly::Optional<std::string>& result) {
+  try {
+    result = folly::parseJson(text).asString();
+    return true;
+  } catch (const folly::json::parse_error&) {
+  } catch (const folly::ConversionError&) {
+  } catch (const folly::TypeError&) {
+  }
+  return false;
+}
+} // namespace
+
+OnDemandJsonExtractor::OnDemandJsonExtractor(const std::string& path)
+    : path_(folly::trimWhitespace(path).str()) {
+  JsonPathTokenizer tokenizer;
+  if (path_.empty() || !tokenizer.reset(path_)) {
+    return;
+  }
+  while (tokenizer.hasNext()) {
+    auto token = tokenizer.getNext();
+    if (!token || token.value() == "*") {
+      return;
+    }
+    auto subscript = folly::tryTo<int32_t>(token.value());
+    subscripts_.push_back(subscript.hasValue() ? subscript.value() : -1);
+    tokens_.push_back(std::move(token.value()));
+  }
+  onDemand_ = true;
+}
+
+folly::Optional<std::string> OnDemandJsonExtractor::extractScalar(
+    folly::StringPiece json) {
+  if (!onDemand_) {
+    return jsonExtractScalarFromDynamic(json, path_);
+  }
+  pos_ = json.begin();
+  end_ = json.end();
+  folly::Optional<std::string> result;
+  if (!scan(result)) {
+    // Malformed or unusual text. Let the folly parser decide.
+    return jsonExtractScalarFromDynamic(json, path_);
+  }
+  return result;
+}
+
+bool OnDemandJsonExtractor::scan(folly::Optional<std::string>& result) {
+  for (auto depth = 0;; ++depth) {
+    skipWhitespace();
+    if (pos_ == end_) {
+      return false;
+    }
+    const bool isObject = *pos_ == '{';
+    const bool isArray = *pos_ == '[';
+    if (depth == tokens_.size()) {
+      if (isObject || isArray) {
+        // A container is not a scalar, so the result stays none.
+        return skipValue();
+      }
+      return extractValue(result);
+    }
+    if (!isObject && !isArray) {
+      // The path continues below a scalar and has no value.
+      return skipValue();
+    }
+    bool found;
+    if (isObject ? !seekKey(tokens_[depth], found)
+                 : !seekIndex(subscripts_[depth], found)) {
+      return false;
+    }
+    if (!found) {
+      return true;
+    }
+  }
+}
+
+bool OnDemandJsonExtractor::seekKey(const std::string& key, bool& found) {
+  found = false;
+  ++pos_;
+  skipWhitespace();
+  if (pos_ < end_ && *pos_ == '}') {
+    return true;
+  }
+  std::string unescapedName;
+  for (;;) {
+    skipWhitespace();
+    if (pos_ == end_ || *pos_ != '"') {
+      return false;
+    }
+    const char* nameStart = pos_;
+    if (!skipString()) {
+      return false;
+    }
+    folly::StringPiece name(nameStart + 1, pos_ - 1);
+    if (memchr(name.data(), '\\', name.size())) {
+      folly::Optional<std::string> decoded;
+      if (!parseScalar(folly::StringPiece(nameStart, pos_), decoded)) {
+        return false;
+      }
+      unescapedName = std::move(decoded.value());
+      name = unescapedName;
+    }
+    skipWhitespace();
+    if (pos_ == end_ || *pos_ != ':') {
+      return false;
+    }
+    ++pos_;
+
+    // The first occurrence of a key decides, as in Presto.
+    if (name == key) {
+      found = true;
+      return true;
+    }
+    if (!skipValue()) {
+      return false;
+    }
+    skipWhitespace();
+    if (pos_ == end_) {
+      return false;
+    }
+    if (*pos_ == ',') {
+      ++pos_;
+      continue;
+    }
+    return *pos_ == '}';
+  }
+}
+
+bool OnDemandJsonExtractor::seekIndex(int32_t index, bool& found) {
+  found = false;
+  ++pos_;
+  skipWhitespace();
+  if (pos_ < end_ && *pos_ == ']') {
+    return true;
+  }
+  for (int32_t i = 0;; ++i) {
+    if (i == index) {
+      found = true;
+      return true;
+    }
+    if (!skipValue()) {
+      return false;
+    }
+    skipWhitespace();
+    if (pos_ == end_) {
+      return false;
+    }
+    if (*pos_ == ',') {
+      ++pos_;
+      continue;
+    }
+    return *pos_ == ']';
+  }
+}
+
+bool OnDemandJsonExtractor::extractValue(
+    folly::Optional<std::string>& result) {
+  const char* start = pos_;
+  if (*pos_ == '"') {
+    if (!skipString()) {
+      return false;
+    }
+    folly::StringPiece text(start + 1, pos_ - 1);
+    if (isPlainString(text)) {
+      result = text.str();
+      return true;
+    }
+  } else {
+    if (!skipScalar()) {
+      return false;
+    }
+    if (folly::StringPiece(start, pos_) == "null") {
+      result = folly::none;
+      return true;
+    }
+  }
+  // Numbers, booleans and strings with escapes are converted by folly so that
+  // the text of the result is the same as with a fully parsed document.
+  return parseScalar(folly::StringPiece(start, pos_), result);
+}
+
+bool OnDemandJsonExtractor::skipValue() {
+  skipWhitespace();
+  if (pos_ == end_) {
+    return false;
+  }
+  switch (*pos_) {
+    case '"':
+      return skipString();
+    case '{':
+    case '[': {
+      // Skips the container by counting brackets outside of strings. The
+      // contents are not validated.
+      int32_t nesting = 0;
+      while (pos_ < end_) {
+        switch (*pos_) {
+          case '"':
+            if (!skipString()) {
+              return false;
+            }
+            continue;
+          case '{':
+          case '[':
+            ++nesting;
+            break;
+          case '}':
+          case ']':
+            if (--nesting == 0) {
+              ++pos_;
+              return true;
+            }
+            break;
+          default:
+            break;
+        }
+        ++pos_;
+      }
+      return false;
+    }
+    default:
+      return skipScalar();
+  }
+}
+
+bool OnDemandJsonExtractor::skipString() {
+  const char* start = pos_ + 1;
+  for (;;) {
+    auto quote = static_cast<const char*>(memchr(start, '"', end_ - start));
+    if (!quote) {
+      return false;
+    }
+    // The quote is escaped if it follows an odd number of backslashes.
+    auto backslash = quote;
+    while (backslash > start && backslash[-1] == '\\') {
+      --backslash;
+    }
+    if ((quote - backslash) % 2 == 0) {
+      pos_ = quote + 1;
+      return true;
+    }
+    start = quote + 1;
+  }
+}
+
+bool OnDemandJsonExtractor::skipScalar() {
+  const char* start = pos_;
+  while (pos_ < end_ && !isDelimiter(*pos_)) {
+    ++pos_;
+  }
+  return pos_ > start;
+}
+
+} // namespace facebook::velox::functions
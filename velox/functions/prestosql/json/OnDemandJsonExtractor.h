@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "folly/Optional.h"
+#include "folly/Range.h"
+
+namespace facebook::velox::functions {
+
+/// Extracts the scalar value for a JSON path from JSON text without building
+/// a folly::dynamic for the document. Only the values on the path are looked
+/// at. Other values are skipped by matching brackets and quotes, and scanning
+/// stops as soon as the path has been resolved.
+///
+/// Results are the same as jsonExtractScalar() for well formed documents
+/// without duplicate keys. Like Presto, the first of several equal keys is
+/// used and text after the requested value is not validated. Paths with a
+/// wildcard and documents found to be malformed are delegated to the
+/// folly::dynamic based implementation.
+class OnDemandJsonExtractor {
+ public:
+  /// 'path' is a JSON path in the syntax accepted by jsonExtract().
+  explicit OnDemandJsonExtractor(const std::string& path);
+
+  /// Returns the scalar value of the path in 'json', or folly::none if there
+  /// is no such value or it is not a scalar. Throws VeloxUserError for an
+  /// invalid path, like jsonExtractScalar().
+  folly::Optional<std::string> extractScalar(folly::StringPiece json);
+
+ private:
+  // Follows the path from the value at 'pos_' and sets 'result' to the value
+  // at its end. Returns false if the text is malformed.
+  bool scan(folly::Optional<std::string>& result);
+
+  // Moves 'pos_' from the start of an object to the value of 'key'. Sets
+  // 'found' to false if the object has no such key. Returns false if the text
+  // is malformed.
+  bool seekKey(const std::string& key, bool& found);
+
+  // Same as seekKey() for the element at 'index' of an array.
+  bool seekIndex(int32_t index, bool& found);
+
+  // Sets 'result' from the scalar value at 'pos_' and moves past the value.
+  bool extractValue(folly::Optional<std::string>& result);
+
+  bool skipValue();
+
+  bool skipString();
+
+  bool skipScalar();
+
+  void skipWhitespace() {
+    while (pos_ < end_ &&
+           (*pos_ == ' ' || *pos_ == '\n' || *pos_ == '\t' || *pos_ == '\r')) {
+      ++pos_;
+    }
+  }
+
+  // Path text with surrounding whitespace removed.
+  const std::string path_;
+  std::vector<std::string> tokens_;
+  // Array subscript for each token, -1 if the token is not an integer.
+  std::vector<int32_t> subscripts_;
+  // False if the path is invalid or has a wildcard. Such paths are evaluated
+  // by jsonExtractScalarFromDynamic().
+  bool onDemand_{false};
+
+  // State of the current extractScalar() call.
+  const char* pos_{nullptr};
+  const char* end_{nullptr};
+};
+
+} // namespace facebook::velox::functions
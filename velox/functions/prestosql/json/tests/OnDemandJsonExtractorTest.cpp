@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/json/OnDemandJsonExtractor.h"
+
+#include "gtest/gtest.h"
+#include "velox/common/base/VeloxException.h"
+#include "velox/functions/prestosql/json/JsonExtractor.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::functions;
+
+namespace {
+
+const std::string kJson = R"DELIM(
+    {"store":
+      {"fruit":[
+        {"weight":8, "type":"apple"},
+        {"weight":9, "type":"pear"}],
+       "basket":[[1,2,{"b":"y","a":"x"}],[3,4],[5,6]],
+       "book":[
+          {"author":"Nigel Rees",
+           "title":"Sayings of the \"Century\"",
+           "category":"reference",
+           "price":8.95},
+          {"author":"J. R. R. Tolkien",
+           "title":"The Lord of the Rings",
+           "reader":[{"age":25, "name":"bob"}, {"age":26, "name":"jack"}],
+           "available":true,
+           "isbn":null}],
+        "bicycle":{"price":19.95, "color":"red"}},
+      "e mail":"amy@only_for_json_udf_test.net",
+      "a\"b": "quoted",
+      "owner":"amy"})DELIM";
+
+const std::vector<std::string> kPaths = {
+    "$",
+    "$.owner",
+    " $.owner ",
+    "$[\"e mail\"]",
+    "$.store",
+    "$.store.fruit[0].weight",
+    "$.store.fruit[1].type",
+    "$.store.fruit[2].type",
+    "$.store.fruit[*].type",
+    "$.store.basket[0][2].a",
+    "$.store.basket[1][1]",
+    "$.store.basket.1",
+    "$.store.book[0].title",
+    "$.store.book[0].price",
+    "$.store.book[1].reader[1].name",
+    "$.store.book[1].available",
+    "$.store.book[1].isbn",
+    "$.store.book[1].isbn.x",
+    "$.store.bicycle.price",
+    "$.store.bicycle.price.x",
+    "$.missing",
+    "$.owner.x",
+};
+
+} // namespace
+
+TEST(OnDemandJsonExtractorTest, singlePath) {
+  for (const auto& path : kPaths) {
+    SCOPED_TRACE(path);
+    EXPECT_EQ(
+        jsonExtractScalarFromDynamic(kJson, path),
+        jsonExtractScalar(kJson, path));
+  }
+}
+
+TEST(OnDemandJsonExtractorTest, reuse) {
+  for (const auto& path : kPaths) {
+    SCOPED_TRACE(path);
+    OnDemandJsonExtractor extractor(path);
+    // Extract twice to check that state is reset between documents.
+    for (auto i = 0; i < 2; ++i) {
+      EXPECT_EQ(
+          jsonExtractScalarFromDynamic(kJson, path),
+          extractor.extractScalar(kJson));
+    }
+  }
+  EXPECT_EQ(
+      "Sayings of the \"Century\"",
+      OnDemandJsonExtractor("$.store.book[0].title").extractScalar(kJson));
+  EXPECT_EQ(
+      "jack",
+      OnDemandJsonExtractor("$.store.book[1].reader[1].name")
+          .extractScalar(kJson));
+}
+
+TEST(OnDemandJsonExtractorTest, scalars) {
+  OnDemandJsonExtractor extractor("$.a");
+  EXPECT_EQ("1", extractor.extractScalar(R"({"a": 1})"));
+  EXPECT_EQ("-1.5", extractor.extractScalar(R"({"a": -1.5})"));
+  EXPECT_EQ("", extractor.extractScalar(R"({"a": ""})"));
+  EXPECT_EQ("ab\001c", extractor.extractScalar(R"({"a": "ab\u0001c"})"));
+  EXPECT_EQ(folly::none, extractor.extractScalar(R"({"a": null})"));
+  EXPECT_EQ(folly::none, extractor.extractScalar(R"({"a": [1]})"));
+  EXPECT_EQ(folly::none, extractor.extractScalar(R"({"a": {}})"));
+  EXPECT_EQ(folly::none, extractor.extractScalar(R"({"b": 1})"));
+  EXPECT_EQ(folly::none, extractor.extractScalar(R"([1, 2])"));
+  EXPECT_EQ(
+      jsonExtractScalarFromDynamic(R"({"a": true})", "$.a"),
+      extractor.extractScalar(R"({"a": true})"));
+}
+
+TEST(OnDemandJsonExtractorTest, skipsRestOfDocument) {
+  OnDemandJsonExtractor extractor("$.b[1]");
+
+  // Text after the requested value is not looked at.
+  EXPECT_EQ(
+      "2", extractor.extractScalar(R"({"a": "x", "b": [1, 2, 3 garbage)"));
+
+  // The first of equal keys is used, as in Presto.
+  EXPECT_EQ("5", extractor.extractScalar(R"({"b": [0, 5], "b": [0, 6]})"));
+}
+
+TEST(OnDemandJsonExtractorTest, malformed) {
+  OnDemandJsonExtractor extractor("$.a");
+  EXPECT_EQ(folly::none, extractor.extractScalar(""));
+  EXPECT_EQ(folly::none, extractor.extractScalar("{"));
+  EXPECT_EQ(folly::none, extractor.extractScalar(R"({"b": [1, 2}, "a": )"));
+  EXPECT_EQ(folly::none, extractor.extractScalar(R"({"a": tru})"));
+  // Out of range numbers are checked by the folly parser.
+  EXPECT_EQ(
+      folly::none,
+      extractor.extractScalar(
+          R"({"a": 18446744073709551615184467440737095516151844})"));
+}
+
+TEST(OnDemandJsonExtractorTest, invalidPath) {
+  OnDemandJsonExtractor extractor("$.b.");
+  EXPECT_THROW(extractor.extractScalar(R"({"a": 1})"), VeloxUserError);
+}
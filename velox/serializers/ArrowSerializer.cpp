@@ -0,0 +1,697 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/serializers/ArrowSerializer.h"
+
+#include <deque>
+#include <numeric>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::serializer::arrow {
+namespace {
+
+// Wire format of a page. Integers are int64 except for the leading size, so
+// that every buffer starts 8 byte aligned in the received page:
+//
+//   int32 size of the rest of the page in bytes
+//   number of rows, number of columns
+//   one node per column
+//
+// A node is one ArrowArray:
+//
+//   length, null_count, n_buffers, n_children, 1 if it has a dictionary
+//   n_buffers times: size in bytes or -1 for a null buffer, bytes padded to 8
+//   n_children child nodes
+//   the dictionary node, if any
+//
+// ArrowSchemas are not sent. The reader derives them from the RowType and the
+// dictionary flags of the nodes.
+constexpr int64_t kNullBuffer = -1;
+
+// A column is sent as a dictionary over the vector it wraps only if that
+// vector has at most this many values per sent row. Otherwise the sent rows
+// are copied, so that a few rows do not ship a large base vector.
+constexpr int32_t kMaxValuesPerRow = 2;
+
+void writeInt32(OutputStream* out, int32_t value) {
+  out->write(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+void writeInt64(OutputStream* out, int64_t value) {
+  out->write(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+void writeBuffer(OutputStream* out, const void* buffer, int64_t size) {
+  static const char kPadding[sizeof(int64_t)] = {};
+  if (buffer == nullptr) {
+    writeInt64(out, kNullBuffer);
+    return;
+  }
+  writeInt64(out, size);
+  out->write(static_cast<const char*>(buffer), size);
+  auto padding = bits::roundUp(size, sizeof(int64_t)) - size;
+  if (padding > 0) {
+    out->write(kPadding, padding);
+  }
+}
+
+// Writes 'arrowArray' exported from a vector of 'type'. The buffer sizes
+// follow from the type and the length, as laid out by the Arrow bridge.
+void writeArray(
+    const TypePtr& type,
+    const ArrowArray& arrowArray,
+    OutputStream* out) {
+  const auto length = arrowArray.length;
+  writeInt64(out, length);
+  writeInt64(out, arrowArray.null_count);
+  writeInt64(out, arrowArray.n_buffers);
+  writeInt64(out, arrowArray.n_children);
+  writeInt64(out, arrowArray.dictionary != nullptr);
+  writeBuffer(out, arrowArray.buffers[0], bits::nbytes(length));
+
+  if (arrowArray.dictionary != nullptr) {
+    writeBuffer(out, arrowArray.buffers[1], length * sizeof(vector_size_t));
+    writeArray(type, *arrowArray.dictionary, out);
+    return;
+  }
+
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      writeBuffer(out, arrowArray.buffers[1], bits::nbytes(length));
+      break;
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      writeBuffer(out, arrowArray.buffers[1], length * type->cppSizeInBytes());
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      auto offsets = static_cast<const int32_t*>(arrowArray.buffers[1]);
+      writeBuffer(out, offsets, (length + 1) * sizeof(int32_t));
+      writeBuffer(out, arrowArray.buffers[2], offsets[length]);
+      break;
+    }
+    case TypeKind::ARRAY:
+      writeBuffer(out, arrowArray.buffers[1], (length + 1) * sizeof(int64_t));
+      writeArray(type->childAt(0), *arrowArray.children[0], out);
+      break;
+    case TypeKind::MAP:
+      // The keys and values are the children of a struct child.
+      writeBuffer(out, arrowArray.buffers[1], (length + 1) * sizeof(int32_t));
+      writeArray(
+          ROW({"key", "value"}, {type->childAt(0), type->childAt(1)}),
+          *arrowArray.children[0],
+          out);
+      break;
+    case TypeKind::ROW:
+      for (auto i = 0; i < arrowArray.n_children; ++i) {
+        writeArray(type->childAt(i), *arrowArray.children[i], out);
+      }
+      break;
+    default:
+      VELOX_NYI("Arrow serialization of {} is not supported.", type->kind());
+  }
+}
+
+// Returns the 'size' rows of 'column' listed in 'rows' as a dictionary over
+// the innermost vector wrapped by 'column', so that no values are copied.
+// Nested dictionaries are combined into one.
+VectorPtr wrapRows(
+    const VectorPtr& column,
+    const vector_size_t* rows,
+    vector_size_t size,
+    memory::MemoryPool* pool) {
+  auto indices = allocateIndices(size, pool);
+  auto rawIndices = indices->asMutable<vector_size_t>();
+  std::copy(rows, rows + size, rawIndices);
+  BufferPtr nulls;
+  uint64_t* rawNulls = nullptr;
+  auto values = BaseVector::loadedVectorShared(column);
+  while (values->encoding() == VectorEncoding::Simple::DICTIONARY) {
+    auto wrapperNulls = values->rawNulls();
+    auto wrapperIndices = values->wrapInfo()->as<vector_size_t>();
+    for (auto i = 0; i < size; ++i) {
+      if (rawNulls && bits::isBitNull(rawNulls, i)) {
+        continue;
+      }
+      if (wrapperNulls && bits::isBitNull(wrapperNulls, rawIndices[i])) {
+        if (!rawNulls) {
+          nulls = AlignedBuffer::allocate<bool>(size, pool, bits::kNotNull);
+          rawNulls = nulls->asMutable<uint64_t>();
+        }
+        bits::setNull(rawNulls, i);
+        rawIndices[i] = 0;
+        continue;
+      }
+      rawIndices[i] = wrapperIndices[rawIndices[i]];
+    }
+    values = BaseVector::loadedVectorShared(values->valueVector());
+  }
+  return BaseVector::wrapInDictionary(nulls, indices, size, values);
+}
+
+// Concatenates 'parts', which are dictionaries made by wrapRows() over the
+// same vector, into one dictionary of 'size' rows over that vector.
+VectorPtr concatenateDictionaries(
+    const std::vector<VectorPtr>& parts,
+    vector_size_t size,
+    memory::MemoryPool* pool) {
+  auto indices = allocateIndices(size, pool);
+  auto rawIndices = indices->asMutable<vector_size_t>();
+  BufferPtr nulls;
+  uint64_t* rawNulls = nullptr;
+  vector_size_t offset = 0;
+  for (auto& part : parts) {
+    memcpy(
+        rawIndices + offset,
+        part->wrapInfo()->as<vector_size_t>(),
+        part->size() * sizeof(vector_size_t));
+    if (part->rawNulls()) {
+      if (!rawNulls) {
+        nulls = AlignedBuffer::allocate<bool>(size, pool, bits::kNotNull);
+        rawNulls = nulls->asMutable<uint64_t>();
+      }
+      bits::copyBits(part->rawNulls(), 0, rawNulls, offset, part->size());
+    }
+    offset += part->size();
+  }
+  return BaseVector::wrapInDictionary(
+      nulls, indices, size, parts[0]->valueVector());
+}
+
+class ArrowVectorSerializer : public VectorSerializer {
+ public:
+  explicit ArrowVectorSerializer(std::shared_ptr<const RowType> type)
+      : type_(std::move(type)) {}
+
+  void append(
+      RowVectorPtr vector,
+      const folly::Range<const IndexRange*>& ranges) override {
+    vector_size_t numRows = 0;
+    for (auto& range : ranges) {
+      numRows += range.size;
+    }
+    if (numRows == 0) {
+      return;
+    }
+    pool_ = vector->pool();
+    // The selected rows are sent as dictionaries over the columns of
+    // 'vector', which is kept alive until flush(). Columns of whole vectors
+    // keep their encodings unless they are dictionaries. A column is copied
+    // instead if its dictionary would send many more values than rows.
+    const bool wholeVector = ranges.size() == 1 && ranges[0].begin == 0 &&
+        ranges[0].size == vector->size();
+    std::vector<vector_size_t> rows;
+    rows.reserve(numRows);
+    for (auto& range : ranges) {
+      for (auto i = 0; i < range.size; ++i) {
+        rows.push_back(range.begin + i);
+      }
+    }
+    std::vector<VectorPtr> children(type_->size());
+    for (auto i = 0; i < type_->size(); ++i) {
+      auto column = BaseVector::loadedVectorShared(vector->childAt(i));
+      if (wholeVector &&
+          column->encoding() != VectorEncoding::Simple::DICTIONARY) {
+        children[i] = std::move(column);
+        continue;
+      }
+      auto wrapped = wrapRows(column, rows.data(), numRows, pool_);
+      if (wrapped->valueVector()->size() <= kMaxValuesPerRow * numRows) {
+        children[i] = std::move(wrapped);
+        continue;
+      }
+      children[i] = BaseVector::create(type_->childAt(i), numRows, pool_);
+      children[i]->copy(wrapped.get(), 0, 0, numRows);
+    }
+    batches_.push_back(std::make_shared<RowVector>(
+        pool_, type_, nullptr, numRows, std::move(children)));
+  }
+
+  void flush(OutputStream* out) override {
+    auto offset = out->tellp();
+    writeInt32(out, 0);
+
+    auto page = pageVector();
+    if (!page) {
+      writeInt64(out, 0);
+      writeInt64(out, 0);
+    } else {
+      writeInt64(out, page->size());
+      writeInt64(out, type_->size());
+      for (auto i = 0; i < type_->size(); ++i) {
+        ArrowArray arrowArray;
+        exportToArrow(exportableColumn(*page, i), arrowArray, pool_);
+        try {
+          writeArray(type_->childAt(i), arrowArray, out);
+        } catch (const std::exception&) {
+          arrowArray.release(&arrowArray);
+          throw;
+        }
+        arrowArray.release(&arrowArray);
+      }
+    }
+
+    auto end = out->tellp();
+    out->seekp(offset);
+    writeInt32(out, end - offset - sizeof(int32_t));
+    out->seekp(end);
+  }
+
+ private:
+  // Returns a single RowVector with all rows appended so far, or nullptr if
+  // there are none. A column whose batches all wrap the same vector becomes
+  // one dictionary over it. Other columns are copied.
+  RowVectorPtr pageVector() const {
+    if (batches_.size() <= 1) {
+      return batches_.empty() ? nullptr : batches_[0];
+    }
+    vector_size_t numRows = 0;
+    vector_size_t maxBatchSize = 0;
+    for (auto& batch : batches_) {
+      numRows += batch->size();
+      maxBatchSize = std::max(maxBatchSize, batch->size());
+    }
+    std::vector<vector_size_t> allRows(maxBatchSize);
+    std::iota(allRows.begin(), allRows.end(), 0);
+
+    std::vector<VectorPtr> children(type_->size());
+    for (auto i = 0; i < type_->size(); ++i) {
+      std::vector<VectorPtr> parts;
+      parts.reserve(batches_.size());
+      bool sameBase = true;
+      for (auto& batch : batches_) {
+        parts.push_back(wrapRows(
+            batch->childAt(i), allRows.data(), batch->size(), pool_));
+        sameBase &= parts.back()->valueVector() == parts[0]->valueVector();
+      }
+      if (sameBase) {
+        children[i] = concatenateDictionaries(parts, numRows, pool_);
+        continue;
+      }
+      children[i] = BaseVector::create(type_->childAt(i), numRows, pool_);
+      vector_size_t target = 0;
+      for (auto& part : parts) {
+        children[i]->copy(part.get(), target, 0, part->size());
+        target += part->size();
+      }
+    }
+    return std::make_shared<RowVector>(
+        pool_, type_, nullptr, numRows, std::move(children));
+  }
+
+  // Returns column 'i' of 'page', copied to a flat vector if it uses
+  // encodings the Arrow bridge does not export, e.g. constant.
+  VectorPtr exportableColumn(RowVector& page, int32_t i) const {
+    auto& column = page.loadedChildAt(i);
+    if (isArrowExportable(*column)) {
+      return column;
+    }
+    auto flat = BaseVector::create(column->type(), column->size(), pool_);
+    flat->copy(column.get(), 0, 0, column->size());
+    return flat;
+  }
+
+  const std::shared_ptr<const RowType> type_;
+  memory::MemoryPool* pool_{nullptr};
+  std::vector<RowVectorPtr> batches_;
+};
+
+// Owns a received page and the Arrow structures describing it. Vectors
+// imported from the page keep it alive through the release callbacks of these
+// structures.
+struct ReceivedPage {
+  ~ReceivedPage() {
+    if (typeSchema.release) {
+      typeSchema.release(&typeSchema);
+    }
+  }
+
+  BufferPtr data;
+
+  // Schema exported from the RowType of the page. Provides the formats and
+  // names of the schemas of the nodes.
+  ArrowSchema typeSchema{};
+
+  // Deques keep the addresses of the structures stable while the page is
+  // being read.
+  std::deque<ArrowSchema> schemas;
+  std::deque<ArrowArray> arrays;
+  std::deque<std::vector<ArrowSchema*>> schemaChildren;
+  std::deque<std::vector<ArrowArray*>> arrayChildren;
+  std::deque<std::vector<const void*>> buffers;
+};
+
+using ReceivedPagePtr = std::shared_ptr<ReceivedPage>;
+
+// Release callback for the ArrowSchemas and ArrowArrays of a received page.
+// Each structure holds a reference to the page in its private_data.
+template <typename T>
+void releaseReceived(T* arrowStruct) {
+  for (int64_t i = 0; i < arrowStruct->n_children; ++i) {
+    auto* child = arrowStruct->children[i];
+    if (child->release != nullptr) {
+      child->release(child);
+    }
+  }
+  auto* dictionary = arrowStruct->dictionary;
+  if (dictionary != nullptr && dictionary->release != nullptr) {
+    dictionary->release(dictionary);
+  }
+  auto* page = static_cast<ReceivedPagePtr*>(arrowStruct->private_data);
+  arrowStruct->release = nullptr;
+  arrowStruct->private_data = nullptr;
+  // May free the page and the structures in it.
+  delete page;
+}
+
+class PageReader {
+ public:
+  explicit PageReader(ReceivedPagePtr page)
+      : page_(std::move(page)),
+        position_(page_->data->as<char>()),
+        end_(position_ + page_->data->size()) {}
+
+  int64_t readInt64() {
+    VELOX_CHECK_LE(position_ + sizeof(int64_t), end_, "Truncated Arrow page");
+    int64_t value;
+    memcpy(&value, position_, sizeof(value));
+    position_ += sizeof(value);
+    return value;
+  }
+
+  // Reads the node for a vector described by 'typeSchema' into 'schema' and
+  // 'arrowArray'. The buffers point into the page.
+  void readNode(
+      const ArrowSchema& typeSchema,
+      ArrowSchema& schema,
+      ArrowArray& arrowArray) {
+    arrowArray.length = readInt64();
+    arrowArray.null_count = readInt64();
+    arrowArray.n_buffers = readInt64();
+    arrowArray.n_children = readInt64();
+    const bool hasDictionary = readInt64() != 0;
+    arrowArray.offset = 0;
+    VELOX_CHECK_LE(arrowArray.n_buffers, 3, "Corrupt Arrow page");
+
+    auto& buffers = page_->buffers.emplace_back(arrowArray.n_buffers);
+    for (auto i = 0; i < arrowArray.n_buffers; ++i) {
+      buffers[i] = readBuffer();
+    }
+    arrowArray.buffers = buffers.data();
+    arrowArray.n_children = hasDictionary ? 0 : arrowArray.n_children;
+    arrowArray.children = nullptr;
+    arrowArray.dictionary = nullptr;
+
+    schema.format = hasDictionary ? "i" : typeSchema.format;
+    schema.name = typeSchema.name;
+    schema.metadata = nullptr;
+    schema.flags = typeSchema.flags;
+    schema.n_children = 0;
+    schema.children = nullptr;
+    schema.dictionary = nullptr;
+
+    if (arrowArray.n_children > 0) {
+      VELOX_CHECK_EQ(
+          arrowArray.n_children, typeSchema.n_children, "Corrupt Arrow page");
+      auto& schemaChildren = page_->schemaChildren.emplace_back();
+      auto& arrayChildren = page_->arrayChildren.emplace_back();
+      for (auto i = 0; i < arrowArray.n_children; ++i) {
+        schemaChildren.push_back(&page_->schemas.emplace_back());
+        arrayChildren.push_back(&page_->arrays.emplace_back());
+        readNode(
+            *typeSchema.children[i], *schemaChildren[i], *arrayChildren[i]);
+      }
+      schema.n_children = arrowArray.n_children;
+      schema.children = schemaChildren.data();
+      arrowArray.children = arrayChildren.data();
+    }
+    if (hasDictionary) {
+      schema.dictionary = &page_->schemas.emplace_back();
+      arrowArray.dictionary = &page_->arrays.emplace_back();
+      readNode(typeSchema, *schema.dictionary, *arrowArray.dictionary);
+    }
+
+    schema.private_data = new ReceivedPagePtr(page_);
+    schema.release = releaseReceived<ArrowSchema>;
+    arrowArray.private_data = new ReceivedPagePtr(page_);
+    arrowArray.release = releaseReceived<ArrowArray>;
+  }
+
+ private:
+  const void* readBuffer() {
+    auto size = readInt64();
+    if (size == kNullBuffer) {
+      return nullptr;
+    }
+    auto buffer = position_;
+    position_ += bits::roundUp(size, sizeof(int64_t));
+    VELOX_CHECK_LE(position_, end_, "Truncated Arrow page");
+    return buffer;
+  }
+
+  const ReceivedPagePtr page_;
+  const char* position_;
+  const char* const end_;
+};
+
+void estimateSerializedSizeInt(
+    const BaseVector* vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes,
+    bool topLevel);
+
+// Adds the sizes of the elements referenced by the non-null rows in 'ranges'
+// and 'offsetSize' bytes per row for the offsets.
+template <typename TVector>
+void estimateNestedSerializedSize(
+    const TVector* vector,
+    int32_t offsetSize,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes,
+    std::vector<IndexRange>& childRanges,
+    std::vector<vector_size_t*>& childSizes) {
+  auto rawOffsets = vector->rawOffsets();
+  auto rawSizes = vector->rawSizes();
+  for (int32_t i = 0; i < ranges.size(); ++i) {
+    auto end = ranges[i].begin + ranges[i].size;
+    *sizes[i] += ranges[i].size * offsetSize + bits::nbytes(ranges[i].size);
+    for (auto row = ranges[i].begin; row < end; ++row) {
+      if (!vector->isNullAt(row) && rawSizes[row] > 0) {
+        childRanges.push_back(IndexRange{rawOffsets[row], rawSizes[row]});
+        childSizes.push_back(sizes[i]);
+      }
+    }
+  }
+}
+
+// Adds the bytes flush() writes for the rows of 'vector' in 'ranges' to
+// 'sizes'. 'topLevel' is true for the columns of the serialized RowVectors,
+// for which append() decides between dictionaries and copies.
+void estimateSerializedSizeInt(
+    const BaseVector* vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes,
+    bool topLevel) {
+  std::vector<IndexRange> childRanges;
+  std::vector<vector_size_t*> childSizes;
+  switch (vector->encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      if (vector->type()->isVarchar() || vector->type()->isVarbinary()) {
+        auto strings = vector->asUnchecked<FlatVector<StringView>>();
+        for (int32_t i = 0; i < ranges.size(); ++i) {
+          auto end = ranges[i].begin + ranges[i].size;
+          int32_t bytes = 0;
+          for (auto row = ranges[i].begin; row < end; ++row) {
+            bytes += sizeof(int32_t) + strings->valueAtFast(row).size();
+          }
+          *sizes[i] += bytes + bits::nbytes(ranges[i].size);
+        }
+      } else {
+        auto valueSize = vector->type()->cppSizeInBytes();
+        for (int32_t i = 0; i < ranges.size(); ++i) {
+          *sizes[i] +=
+              ranges[i].size * valueSize + bits::nbytes(ranges[i].size);
+        }
+      }
+      return;
+    case VectorEncoding::Simple::ROW: {
+      for (int32_t i = 0; i < ranges.size(); ++i) {
+        *sizes[i] += bits::nbytes(ranges[i].size);
+      }
+      for (auto& child : vector->asUnchecked<RowVector>()->children()) {
+        if (child) {
+          estimateSerializedSizeInt(
+              child->loadedVector(), ranges, sizes, false);
+        }
+      }
+      return;
+    }
+    case VectorEncoding::Simple::ARRAY: {
+      auto arrayVector = vector->asUnchecked<ArrayVector>();
+      estimateNestedSerializedSize(
+          arrayVector,
+          sizeof(int64_t),
+          ranges,
+          sizes,
+          childRanges,
+          childSizes);
+      estimateSerializedSizeInt(
+          arrayVector->elements()->loadedVector(),
+          childRanges,
+          childSizes.data(),
+          false);
+      return;
+    }
+    case VectorEncoding::Simple::MAP: {
+      auto mapVector = vector->asUnchecked<MapVector>();
+      estimateNestedSerializedSize(
+          mapVector,
+          sizeof(int32_t),
+          ranges,
+          sizes,
+          childRanges,
+          childSizes);
+      estimateSerializedSizeInt(
+          mapVector->mapKeys()->loadedVector(),
+          childRanges,
+          childSizes.data(),
+          false);
+      estimateSerializedSizeInt(
+          mapVector->mapValues()->loadedVector(),
+          childRanges,
+          childSizes.data(),
+          false);
+      return;
+    }
+    default:
+      break;
+  }
+
+  // Dictionaries send their indices and the whole vector they wrap, unless
+  // append() copies the rows of a top level column. Other encodings are sent
+  // flattened, i.e. as the referenced values of the wrapped vector.
+  const auto* wrapped = vector->wrappedVector();
+  if (wrapped == vector) {
+    // Scalar constant without a value vector.
+    int32_t valueSize = vector->type()->isFixedWidth()
+        ? vector->type()->cppSizeInBytes()
+        : sizeof(int32_t);
+    if (!vector->isNullAt(0) &&
+        (vector->type()->isVarchar() || vector->type()->isVarbinary())) {
+      valueSize += vector->asUnchecked<SimpleVector<StringView>>()
+                       ->valueAt(0)
+                       .size();
+    }
+    for (int32_t i = 0; i < ranges.size(); ++i) {
+      *sizes[i] += ranges[i].size * valueSize + bits::nbytes(ranges[i].size);
+    }
+    return;
+  }
+  int64_t numRows = 0;
+  for (auto& range : ranges) {
+    numRows += range.size;
+  }
+  if (numRows > 0 &&
+      vector->encoding() == VectorEncoding::Simple::DICTIONARY &&
+      (!topLevel || wrapped->size() <= kMaxValuesPerRow * numRows)) {
+    // The wrapped vector is sent once. Its size is spread over the ranges.
+    vector_size_t wrappedSize = 0;
+    auto wrappedSizePtr = &wrappedSize;
+    IndexRange allRows{0, wrapped->size()};
+    estimateSerializedSizeInt(
+        wrapped, folly::Range(&allRows, 1), &wrappedSizePtr, false);
+    for (int32_t i = 0; i < ranges.size(); ++i) {
+      *sizes[i] += ranges[i].size * sizeof(vector_size_t) +
+          bits::nbytes(ranges[i].size) +
+          int64_t{wrappedSize} * ranges[i].size / numRows;
+    }
+    return;
+  }
+  for (int32_t i = 0; i < ranges.size(); ++i) {
+    auto end = ranges[i].begin + ranges[i].size;
+    *sizes[i] += bits::nbytes(ranges[i].size);
+    for (auto row = ranges[i].begin; row < end; ++row) {
+      childRanges.push_back(IndexRange{vector->wrappedIndex(row), 1});
+      childSizes.push_back(sizes[i]);
+    }
+  }
+  estimateSerializedSizeInt(wrapped, childRanges, childSizes.data(), false);
+}
+
+} // namespace
+
+void ArrowVectorSerde::estimateSerializedSize(
+    VectorPtr vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes) {
+  estimateSerializedSizeInt(vector->loadedVector(), ranges, sizes, true);
+}
+
+std::unique_ptr<VectorSerializer> ArrowVectorSerde::createSerializer(
+    std::shared_ptr<const RowType> type,
+    int32_t /*numRows*/,
+    StreamArena* /*streamArena*/) {
+  return std::make_unique<ArrowVectorSerializer>(type);
+}
+
+void ArrowVectorSerde::deserialize(
+    ByteStream* source,
+    velox::memory::MemoryPool* pool,
+    std::shared_ptr<const RowType> type,
+    std::shared_ptr<RowVector>* result) {
+  const auto size = source->read<int32_t>();
+  auto page = std::make_shared<ReceivedPage>();
+  page->data = AlignedBuffer::allocate<char>(size, pool);
+  source->readBytes(page->data->asMutable<uint8_t>(), size);
+
+  PageReader reader(page);
+  const auto numRows = reader.readInt64();
+  const auto numColumns = reader.readInt64();
+  if (numColumns == 0) {
+    *result = std::static_pointer_cast<RowVector>(
+        BaseVector::create(type, numRows, pool));
+    return;
+  }
+  VELOX_CHECK_EQ(numColumns, type->size(), "Arrow page does not match type");
+
+  exportToArrow(type, page->typeSchema);
+  std::vector<VectorPtr> children;
+  children.reserve(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    auto& schema = page->schemas.emplace_back();
+    auto& arrowArray = page->arrays.emplace_back();
+    reader.readNode(*page->typeSchema.children[i], schema, arrowArray);
+    children.push_back(importFromArrowAsOwner(schema, arrowArray, pool));
+  }
+  *result = std::make_shared<RowVector>(
+      pool, type, nullptr, numRows, std::move(children));
+}
+
+// static
+void ArrowVectorSerde::registerVectorSerde() {
+  VELOX_REGISTER_VECTOR_SERDE(ArrowVectorSerde);
+}
+
+VELOX_DECLARE_VECTOR_SERDE(ArrowVectorSerde);
+} // namespace facebook::velox::serializer::arrow
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::serializer::arrow {
+
+/// VectorSerde that serializes RowVectors in the Arrow columnar layout, as
+/// exported through the Arrow C data interface. Vectors are exported without
+/// decoding, so dictionary encoded columns stay dictionary encoded on the
+/// wire, and deserialized vectors reference the received bytes directly:
+/// deserialize() copies a page once into a single buffer and imports the
+/// Arrow arrays pointing into it.
+class ArrowVectorSerde : public VectorSerde {
+ public:
+  void estimateSerializedSize(
+      std::shared_ptr<BaseVector> vector,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t** sizes) override;
+
+  std::unique_ptr<VectorSerializer> createSerializer(
+      std::shared_ptr<const RowType> type,
+      int32_t numRows,
+      StreamArena* streamArena) override;
+
+  void deserialize(
+      ByteStream* source,
+      velox::memory::MemoryPool* pool,
+      std::shared_ptr<const RowType> type,
+      std::shared_ptr<RowVector>* result) override;
+
+  static void registerVectorSerde();
+};
+
+} // namespace facebook::velox::serializer::arrow
@@ -0,0 +1,940 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/serializers/NativeSerializer.h"
+
+#include <folly/io/IOBuf.h>
+#include <numeric>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Nulls.h"
+#include "velox/vector/BiasVector.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
+#include "velox/vector/LazyVector.h"
+
+namespace facebook::velox::serializer::native {
+namespace {
+
+// Wire format of a page:
+//
+//   int32 size of the rest of the page in bytes
+//   int32 number of rows
+//   int32 number of columns
+//   per column: int8 folly::io::CodecType, int32 uncompressed size, int32
+//     size, 'size' bytes holding the node of the column, compressed with the
+//     codec.
+//
+// A node starts with an int8 Encoding and the int32 number of rows, followed
+// by a payload that depends on the encoding. Nulls are written as an int8
+// flag, followed by bits::nbytes(rows) bytes of null bits if the flag is set.
+//
+//   kFlat: nulls, values. Fixed width values are written in their in-memory
+//     layout, booleans as bits, strings as int32 lengths followed by the
+//     bytes of all strings.
+//   kConstant: int8 1 for a null constant, else 0 followed by a one row node
+//     with the value.
+//   kDictionary: nulls of the dictionary, int32 indices, node of the
+//     dictionary values.
+//   kBiased: nulls, int8 TypeKind of the deltas, bias, deltas.
+//   kRow: nulls, one node per child.
+//   kArray: nulls, int32 sizes, node of the elements.
+//   kMap: nulls, int32 sizes, nodes of the keys and of the values.
+enum class Encoding : int8_t {
+  kFlat = 0,
+  kConstant = 1,
+  kDictionary = 2,
+  kBiased = 3,
+  kRow = 4,
+  kArray = 5,
+  kMap = 6,
+};
+
+// Columns smaller than this are sent uncompressed.
+constexpr int32_t kMinCompressionSize = 64;
+
+template <typename T>
+void appendValue(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendBytes(std::string& out, const void* data, size_t size) {
+  out.append(static_cast<const char*>(data), size);
+}
+
+std::vector<vector_size_t> allRows(vector_size_t size) {
+  std::vector<vector_size_t> rows(size);
+  std::iota(rows.begin(), rows.end(), 0);
+  return rows;
+}
+
+// Calls 'func(begin, size)' for each run of consecutive row numbers in 'rows'.
+template <typename Func>
+void forEachRun(const std::vector<vector_size_t>& rows, Func func) {
+  size_t begin = 0;
+  while (begin < rows.size()) {
+    auto end = begin + 1;
+    while (end < rows.size() && rows[end] == rows[end - 1] + 1) {
+      ++end;
+    }
+    func(rows[begin], end - begin);
+    begin = end;
+  }
+}
+
+bool isNullRow(const uint64_t* rawNulls, vector_size_t row) {
+  return rawNulls && bits::isBitNull(rawNulls, row);
+}
+
+// Size in bytes of a delta of a BiasVector with deltas of 'kind'.
+int32_t deltaSize(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return sizeof(int8_t);
+    case TypeKind::SMALLINT:
+      return sizeof(int16_t);
+    case TypeKind::INTEGER:
+      return sizeof(int32_t);
+    default:
+      VELOX_FAIL("Invalid type of biased values: {}", kind);
+  }
+}
+
+// Appends the bits of 'bits' at 'rows'.
+void appendBits(
+    const uint64_t* bits,
+    const std::vector<vector_size_t>& rows,
+    std::string& out) {
+  std::vector<uint64_t> gathered(bits::nwords(rows.size()));
+  for (auto i = 0; i < rows.size(); ++i) {
+    bits::setBit(gathered.data(), i, bits::isBitSet(bits, rows[i]));
+  }
+  appendBytes(out, gathered.data(), bits::nbytes(rows.size()));
+}
+
+void writeHeader(
+    Encoding encoding,
+    const std::vector<vector_size_t>& rows,
+    std::string& out) {
+  appendValue<int8_t>(out, static_cast<int8_t>(encoding));
+  appendValue<int32_t>(out, rows.size());
+}
+
+void writeNulls(
+    const uint64_t* rawNulls,
+    const std::vector<vector_size_t>& rows,
+    std::string& out) {
+  const bool hasNulls = rawNulls &&
+      std::any_of(rows.begin(), rows.end(), [&](auto row) {
+        return bits::isBitNull(rawNulls, row);
+      });
+  appendValue<int8_t>(out, hasNulls);
+  if (hasNulls) {
+    appendBits(rawNulls, rows, out);
+  }
+}
+
+void serializeNode(
+    const BaseVector& vector,
+    const std::vector<vector_size_t>& rows,
+    std::string& out,
+    memory::MemoryPool* pool);
+
+void serializeFlat(
+    const BaseVector& vector,
+    const std::vector<vector_size_t>& rows,
+    std::string& out) {
+  const auto* rawNulls = vector.rawNulls();
+  writeHeader(Encoding::kFlat, rows, out);
+  writeNulls(rawNulls, rows, out);
+  const auto& type = vector.type();
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      appendBits(
+          static_cast<const uint64_t*>(vector.valuesAsVoid()), rows, out);
+      return;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      auto* strings = static_cast<const StringView*>(vector.valuesAsVoid());
+      for (auto row : rows) {
+        appendValue<int32_t>(
+            out, isNullRow(rawNulls, row) ? 0 : strings[row].size());
+      }
+      for (auto row : rows) {
+        if (!isNullRow(rawNulls, row)) {
+          appendBytes(out, strings[row].data(), strings[row].size());
+        }
+      }
+      return;
+    }
+    default:
+      break;
+  }
+  VELOX_CHECK(
+      type->isFixedWidth(),
+      "Native serialization of {} is not supported",
+      type->toString());
+  const auto width = type->cppSizeInBytes();
+  auto* rawValues = static_cast<const char*>(vector.valuesAsVoid());
+  forEachRun(rows, [&](auto begin, auto size) {
+    appendBytes(out, rawValues + begin * width, size * width);
+  });
+}
+
+void serializeConstant(
+    const BaseVector& vector,
+    const std::vector<vector_size_t>& rows,
+    std::string& out,
+    memory::MemoryPool* pool) {
+  writeHeader(Encoding::kConstant, rows, out);
+  const bool isNull = vector.isNullAt(0);
+  appendValue<int8_t>(out, isNull);
+  if (isNull) {
+    return;
+  }
+  const auto* wrapped = vector.wrappedVector();
+  if (wrapped != &vector) {
+    // Constant referring to a row of a complex vector.
+    serializeNode(*wrapped, {vector.wrappedIndex(0)}, out, pool);
+    return;
+  }
+  auto value = BaseVector::create(vector.type(), 1, pool);
+  value->copy(&vector, 0, 0, 1);
+  serializeNode(*value, {0}, out, pool);
+}
+
+// Writes 'vector' with dictionary encoding. Returns false without writing
+// anything if the dictionary has more values than 'rows', in which case
+// flattening the rows is smaller.
+bool serializeDictionary(
+    const BaseVector& vector,
+    const std::vector<vector_size_t>& rows,
+    std::string& out,
+    memory::MemoryPool* pool) {
+  auto base = vector.valueVector();
+  if (!base || base->size() == 0 || base->size() > rows.size()) {
+    return false;
+  }
+  const auto* rawNulls = vector.rawNulls();
+  writeHeader(Encoding::kDictionary, rows, out);
+  writeNulls(rawNulls, rows, out);
+  const auto* indices = vector.wrapInfo()->as<vector_size_t>();
+  for (auto row : rows) {
+    appendValue<int32_t>(out, isNullRow(rawNulls, row) ? 0 : indices[row]);
+  }
+  serializeNode(*base, allRows(base->size()), out, pool);
+  return true;
+}
+
+template <typename T>
+void serializeBiased(
+    const BaseVector& vector,
+    const std::vector<vector_size_t>& rows,
+    std::string& out) {
+  auto* biased = vector.asUnchecked<BiasVector<T>>();
+  writeHeader(Encoding::kBiased, rows, out);
+  writeNulls(vector.rawNulls(), rows, out);
+  appendValue<int8_t>(out, static_cast<int8_t>(biased->valueType()));
+  appendValue<T>(out, biased->bias());
+  const auto width = deltaSize(biased->valueType());
+  auto* rawDeltas = biased->values()->template as<char>();
+  forEachRun(rows, [&](auto begin, auto size) {
+    appendBytes(out, rawDeltas + begin * width, size * width);
+  });
+}
+
+// Writes the sizes of the arrays or maps of 'vector' at 'rows' and returns
+// the rows of their elements.
+template <typename TVector>
+std::vector<vector_size_t> writeSizes(
+    const TVector& vector,
+    const std::vector<vector_size_t>& rows,
+    std::string& out) {
+  const auto* rawNulls = vector.rawNulls();
+  const auto* rawOffsets = vector.rawOffsets();
+  const auto* rawSizes = vector.rawSizes();
+  std::vector<vector_size_t> elementRows;
+  for (auto row : rows) {
+    const vector_size_t size = isNullRow(rawNulls, row) ? 0 : rawSizes[row];
+    appendValue<int32_t>(out, size);
+    for (auto i = 0; i < size; ++i) {
+      elementRows.push_back(rawOffsets[row] + i);
+    }
+  }
+  return elementRows;
+}
+
+// Returns a vector with the values of 'vector' at 'rows' that has no
+// encodings other than flat, row, array and map.
+VectorPtr copyRows(
+    const BaseVector& vector,
+    const std::vector<vector_size_t>& rows,
+    memory::MemoryPool* pool) {
+  auto copy = BaseVector::create(vector.type(), rows.size(), pool);
+  vector_size_t target = 0;
+  forEachRun(rows, [&](auto begin, auto size) {
+    copy->copy(&vector, target, begin, size);
+    target += size;
+  });
+  return copy;
+}
+
+void serializeNode(
+    const BaseVector& input,
+    const std::vector<vector_size_t>& rows,
+    std::string& out,
+    memory::MemoryPool* pool) {
+  const auto& vector = *input.loadedVector();
+  switch (vector.encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      serializeFlat(vector, rows, out);
+      return;
+    case VectorEncoding::Simple::CONSTANT:
+      serializeConstant(vector, rows, out, pool);
+      return;
+    case VectorEncoding::Simple::DICTIONARY:
+      if (serializeDictionary(vector, rows, out, pool)) {
+        return;
+      }
+      break;
+    case VectorEncoding::Simple::BIASED:
+      switch (vector.typeKind()) {
+        case TypeKind::SMALLINT:
+          serializeBiased<int16_t>(vector, rows, out);
+          return;
+        case TypeKind::INTEGER:
+          serializeBiased<int32_t>(vector, rows, out);
+          return;
+        case TypeKind::BIGINT:
+          serializeBiased<int64_t>(vector, rows, out);
+          return;
+        default:
+          VELOX_UNREACHABLE();
+      }
+    case VectorEncoding::Simple::ROW: {
+      writeHeader(Encoding::kRow, rows, out);
+      writeNulls(vector.rawNulls(), rows, out);
+      auto* rowVector = vector.asUnchecked<RowVector>();
+      for (auto i = 0; i < rowVector->childrenSize(); ++i) {
+        serializeNode(*rowVector->childAt(i), rows, out, pool);
+      }
+      return;
+    }
+    case VectorEncoding::Simple::ARRAY: {
+      auto* arrayVector = vector.asUnchecked<ArrayVector>();
+      writeHeader(Encoding::kArray, rows, out);
+      writeNulls(vector.rawNulls(), rows, out);
+      auto elementRows = writeSizes(*arrayVector, rows, out);
+      serializeNode(*arrayVector->elements(), elementRows, out, pool);
+      return;
+    }
+    case VectorEncoding::Simple::MAP: {
+      auto* mapVector = vector.asUnchecked<MapVector>();
+      writeHeader(Encoding::kMap, rows, out);
+      writeNulls(vector.rawNulls(), rows, out);
+      auto elementRows = writeSizes(*mapVector, rows, out);
+      serializeNode(*mapVector->mapKeys(), elementRows, out, pool);
+      serializeNode(*mapVector->mapValues(), elementRows, out, pool);
+      return;
+    }
+    default:
+      break;
+  }
+  // Other encodings, and dictionaries that are larger than the serialized
+  // rows, are sent flattened.
+  auto flat = copyRows(vector, rows, pool);
+  serializeNode(*flat, allRows(rows.size()), out, pool);
+}
+
+class NativeVectorSerializer : public VectorSerializer {
+ public:
+  NativeVectorSerializer(
+      std::shared_ptr<const RowType> type,
+      folly::io::CodecType codecType,
+      StreamArena* streamArena)
+      : type_(std::move(type)),
+        codecType_(codecType),
+        codec_(
+            codecType == folly::io::CodecType::NO_COMPRESSION
+                ? nullptr
+                : folly::io::getCodec(codecType)),
+        stream_(streamArena) {}
+
+  // Serializes the rows in 'ranges' as one page. The encodings of 'vector'
+  // apply to all rows of the page, so the pages of different appends are
+  // not merged.
+  void append(
+      RowVectorPtr vector,
+      const folly::Range<const IndexRange*>& ranges) override {
+    std::vector<vector_size_t> rows;
+    for (auto& range : ranges) {
+      for (auto i = 0; i < range.size; ++i) {
+        rows.push_back(range.begin + i);
+      }
+    }
+    if (rows.empty()) {
+      return;
+    }
+    std::string page;
+    appendValue<int32_t>(page, 0);
+    appendValue<int32_t>(page, rows.size());
+    appendValue<int32_t>(page, type_->size());
+    std::string column;
+    for (auto i = 0; i < type_->size(); ++i) {
+      column.clear();
+      serializeNode(*vector->childAt(i), rows, column, vector->pool());
+      writeColumn(column, page);
+    }
+    const int32_t size = page.size() - sizeof(int32_t);
+    memcpy(page.data(), &size, sizeof(size));
+
+    if (numPages_ == 0) {
+      stream_.startWrite(page.size());
+    }
+    stream_.appendStringPiece(folly::StringPiece(page));
+    ++numPages_;
+  }
+
+  void flush(OutputStream* out) override {
+    if (numPages_ == 0) {
+      // An empty page: no rows and no columns.
+      const int32_t header[] = {2 * sizeof(int32_t), 0, 0};
+      out->write(reinterpret_cast<const char*>(header), sizeof(header));
+      return;
+    }
+    stream_.flush(out);
+  }
+
+ private:
+  void writeColumn(const std::string& column, std::string& page) {
+    if (codec_ && column.size() >= kMinCompressionSize) {
+      auto input = folly::IOBuf::wrapBuffer(column.data(), column.size());
+      auto compressed = codec_->compress(input.get());
+      const auto compressedSize = compressed->computeChainDataLength();
+      if (compressedSize < column.size()) {
+        appendValue<int8_t>(page, static_cast<int8_t>(codecType_));
+        appendValue<int32_t>(page, column.size());
+        appendValue<int32_t>(page, compressedSize);
+        for (auto range : *compressed) {
+          appendBytes(page, range.data(), range.size());
+        }
+        return;
+      }
+    }
+    appendValue<int8_t>(
+        page, static_cast<int8_t>(folly::io::CodecType::NO_COMPRESSION));
+    appendValue<int32_t>(page, column.size());
+    appendValue<int32_t>(page, column.size());
+    page.append(column);
+  }
+
+  const std::shared_ptr<const RowType> type_;
+  const folly::io::CodecType codecType_;
+  const std::unique_ptr<folly::io::Codec> codec_;
+  ByteStream stream_;
+  int32_t numPages_{0};
+};
+
+// Reads the nodes of one column. Strings reference 'data' without copying.
+class NodeReader {
+ public:
+  NodeReader(BufferPtr data, memory::MemoryPool* pool)
+      : data_(std::move(data)),
+        pool_(pool),
+        position_(data_->as<char>()),
+        end_(position_ + data_->size()) {}
+
+  VectorPtr readNode(const TypePtr& type) {
+    const auto encoding = static_cast<Encoding>(read<int8_t>());
+    const auto size = read<int32_t>();
+    switch (encoding) {
+      case Encoding::kFlat: {
+        auto nulls = readNulls(size);
+        return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+            readFlat, type->kind(), type, std::move(nulls), size);
+      }
+      case Encoding::kConstant:
+        if (read<int8_t>()) {
+          return BaseVector::createNullConstant(type, size, pool_);
+        }
+        return BaseVector::wrapInConstant(size, 0, readNode(type));
+      case Encoding::kDictionary: {
+        auto nulls = readNulls(size);
+        auto indices = readBuffer<vector_size_t>(size);
+        return BaseVector::wrapInDictionary(
+            std::move(nulls), std::move(indices), size, readNode(type));
+      }
+      case Encoding::kBiased: {
+        auto nulls = readNulls(size);
+        switch (type->kind()) {
+          case TypeKind::SMALLINT:
+            return readBiased<int16_t>(std::move(nulls), size);
+          case TypeKind::INTEGER:
+            return readBiased<int32_t>(std::move(nulls), size);
+          case TypeKind::BIGINT:
+            return readBiased<int64_t>(std::move(nulls), size);
+          default:
+            VELOX_FAIL("Corrupt native page: biased {}", type->toString());
+        }
+      }
+      case Encoding::kRow: {
+        auto nulls = readNulls(size);
+        std::vector<VectorPtr> children;
+        children.reserve(type->size());
+        for (auto i = 0; i < type->size(); ++i) {
+          children.push_back(readNode(type->childAt(i)));
+        }
+        return std::make_shared<RowVector>(
+            pool_, type, std::move(nulls), size, std::move(children));
+      }
+      case Encoding::kArray: {
+        auto nulls = readNulls(size);
+        BufferPtr offsets;
+        BufferPtr sizes;
+        readSizes(size, offsets, sizes);
+        auto elements = readNode(type->childAt(0));
+        return std::make_shared<ArrayVector>(
+            pool_,
+            type,
+            std::move(nulls),
+            size,
+            std::move(offsets),
+            std::move(sizes),
+            std::move(elements));
+      }
+      case Encoding::kMap: {
+        auto nulls = readNulls(size);
+        BufferPtr offsets;
+        BufferPtr sizes;
+        readSizes(size, offsets, sizes);
+        auto keys = readNode(type->childAt(0));
+        auto values = readNode(type->childAt(1));
+        return std::make_shared<MapVector>(
+            pool_,
+            type,
+            std::move(nulls),
+            size,
+            std::move(offsets),
+            std::move(sizes),
+            std::move(keys),
+            std::move(values));
+      }
+    }
+    VELOX_FAIL(
+        "Corrupt native page: unknown encoding {}",
+        static_cast<int32_t>(encoding));
+  }
+
+ private:
+  const char* readBytes(size_t size) {
+    VELOX_CHECK_LE(
+        size, static_cast<size_t>(end_ - position_), "Truncated native page");
+    auto* bytes = position_;
+    position_ += size;
+    return bytes;
+  }
+
+  template <typename T>
+  T read() {
+    T value;
+    memcpy(&value, readBytes(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  template <typename T>
+  BufferPtr readBuffer(vector_size_t size) {
+    auto buffer = AlignedBuffer::allocate<T>(size, pool_);
+    memcpy(
+        buffer->template asMutable<char>(),
+        readBytes(size * sizeof(T)),
+        size * sizeof(T));
+    return buffer;
+  }
+
+  BufferPtr readBits(vector_size_t size) {
+    auto buffer = AlignedBuffer::allocate<bool>(size, pool_);
+    memcpy(
+        buffer->asMutable<char>(),
+        readBytes(bits::nbytes(size)),
+        bits::nbytes(size));
+    return buffer;
+  }
+
+  BufferPtr readNulls(vector_size_t size) {
+    return read<int8_t>() ? readBits(size) : nullptr;
+  }
+
+  void readSizes(vector_size_t size, BufferPtr& offsets, BufferPtr& sizes) {
+    sizes = readBuffer<vector_size_t>(size);
+    offsets = AlignedBuffer::allocate<vector_size_t>(size, pool_);
+    auto* rawSizes = sizes->as<vector_size_t>();
+    auto* rawOffsets = offsets->asMutable<vector_size_t>();
+    vector_size_t offset = 0;
+    for (auto i = 0; i < size; ++i) {
+      rawOffsets[i] = offset;
+      offset += rawSizes[i];
+    }
+  }
+
+  template <TypeKind Kind>
+  VectorPtr readFlat(const TypePtr& type, BufferPtr nulls, vector_size_t size) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    BufferPtr values;
+    std::vector<BufferPtr> stringBuffers;
+    if constexpr (std::is_same_v<T, bool>) {
+      values = readBits(size);
+    } else if constexpr (std::is_same_v<T, StringView>) {
+      const auto* lengths = readBytes(size * sizeof(int32_t));
+      values = AlignedBuffer::allocate<StringView>(size, pool_);
+      auto* rawValues = values->asMutable<StringView>();
+      for (auto i = 0; i < size; ++i) {
+        int32_t length;
+        memcpy(&length, lengths + i * sizeof(int32_t), sizeof(length));
+        rawValues[i] = StringView(readBytes(length), length);
+      }
+      stringBuffers.push_back(data_);
+    } else {
+      values = readBuffer<T>(size);
+    }
+    return std::make_shared<FlatVector<T>>(
+        pool_,
+        type,
+        std::move(nulls),
+        size,
+        std::move(values),
+        std::move(stringBuffers));
+  }
+
+  template <typename T>
+  VectorPtr readBiased(BufferPtr nulls, vector_size_t size) {
+    const auto deltaKind = static_cast<TypeKind>(read<int8_t>());
+    const auto bias = read<T>();
+    auto deltas = readBuffer<char>(size * deltaSize(deltaKind));
+    return std::make_shared<BiasVector<T>>(
+        pool_, std::move(nulls), size, deltaKind, std::move(deltas), bias);
+  }
+
+  const BufferPtr data_;
+  memory::MemoryPool* const pool_;
+  const char* position_;
+  const char* const end_;
+};
+
+// Decompresses and deserializes a column when its LazyVector is loaded.
+class CompressedColumnLoader : public VectorLoader {
+ public:
+  CompressedColumnLoader(
+      TypePtr type,
+      folly::io::CodecType codecType,
+      int32_t uncompressedSize,
+      BufferPtr compressed,
+      memory::MemoryPool* pool)
+      : type_(std::move(type)),
+        codecType_(codecType),
+        uncompressedSize_(uncompressedSize),
+        compressed_(std::move(compressed)),
+        pool_(pool) {}
+
+ protected:
+  void loadInternal(RowSet /*rows*/, ValueHook* hook, VectorPtr* result)
+      override {
+    VELOX_CHECK(!hook, "Native serde does not support ValueHook");
+    auto input = folly::IOBuf::wrapBuffer(
+        compressed_->as<char>(), compressed_->size());
+    auto uncompressed = folly::io::getCodec(codecType_)->uncompress(
+        input.get(), uncompressedSize_);
+    compressed_.reset();
+
+    auto data = AlignedBuffer::allocate<char>(uncompressedSize_, pool_);
+    auto* target = data->asMutable<char>();
+    for (auto range : *uncompressed) {
+      memcpy(target, range.data(), range.size());
+      target += range.size();
+    }
+    *result = NodeReader(std::move(data), pool_).readNode(type_);
+  }
+
+ private:
+  const TypePtr type_;
+  const folly::io::CodecType codecType_;
+  const int32_t uncompressedSize_;
+  BufferPtr compressed_;
+  memory::MemoryPool* const pool_;
+};
+
+void estimateSerializedSizeInt(
+    const BaseVector* vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes);
+
+vector_size_t countRows(const folly::Range<const IndexRange*>& ranges) {
+  vector_size_t numRows = 0;
+  for (auto& range : ranges) {
+    numRows += range.size;
+  }
+  return numRows;
+}
+
+// Adds 'bytesPerRow' per row and the null bits to each range.
+void addPerRow(
+    double bytesPerRow,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes) {
+  for (int32_t i = 0; i < ranges.size(); ++i) {
+    *sizes[i] +=
+        ranges[i].size * bytesPerRow + bits::nbytes(ranges[i].size);
+  }
+}
+
+// Returns the estimated size of the rows in 'ranges' of 'vector' together.
+vector_size_t estimateTotalSize(
+    const BaseVector* vector,
+    const folly::Range<const IndexRange*>& ranges) {
+  vector_size_t total = 0;
+  std::vector<vector_size_t*> sizes(ranges.size(), &total);
+  estimateSerializedSizeInt(vector, ranges, sizes.data());
+  return total;
+}
+
+// Adds the sizes of the elements referenced by the non-null rows in 'ranges'
+// and 4 bytes per row for the sizes.
+template <typename TVector>
+void estimateNestedSerializedSize(
+    const TVector* vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes,
+    std::vector<IndexRange>& childRanges,
+    std::vector<vector_size_t*>& childSizes) {
+  auto rawOffsets = vector->rawOffsets();
+  auto rawSizes = vector->rawSizes();
+  addPerRow(sizeof(int32_t), ranges, sizes);
+  for (int32_t i = 0; i < ranges.size(); ++i) {
+    auto end = ranges[i].begin + ranges[i].size;
+    for (auto row = ranges[i].begin; row < end; ++row) {
+      if (!vector->isNullAt(row) && rawSizes[row] > 0) {
+        childRanges.push_back(IndexRange{rawOffsets[row], rawSizes[row]});
+        childSizes.push_back(sizes[i]);
+      }
+    }
+  }
+}
+
+// Returns the size of a scalar value of 'vector' at 'row'.
+int32_t scalarSize(const BaseVector* vector, vector_size_t row) {
+  const auto& type = vector->type();
+  if (type->isVarchar() || type->isVarbinary()) {
+    return sizeof(int32_t) +
+        (vector->isNullAt(row)
+             ? 0
+             : vector->asUnchecked<SimpleVector<StringView>>()
+                   ->valueAt(row)
+                   .size());
+  }
+  return type->cppSizeInBytes();
+}
+
+int32_t biasedDeltaSize(const BaseVector* vector) {
+  switch (vector->typeKind()) {
+    case TypeKind::SMALLINT:
+      return deltaSize(vector->asUnchecked<BiasVector<int16_t>>()->valueType());
+    case TypeKind::INTEGER:
+      return deltaSize(vector->asUnchecked<BiasVector<int32_t>>()->valueType());
+    case TypeKind::BIGINT:
+      return deltaSize(vector->asUnchecked<BiasVector<int64_t>>()->valueType());
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+void estimateSerializedSizeInt(
+    const BaseVector* vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes) {
+  std::vector<IndexRange> childRanges;
+  std::vector<vector_size_t*> childSizes;
+  switch (vector->encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      if (vector->type()->isVarchar() || vector->type()->isVarbinary()) {
+        for (int32_t i = 0; i < ranges.size(); ++i) {
+          auto end = ranges[i].begin + ranges[i].size;
+          int32_t bytes = 0;
+          for (auto row = ranges[i].begin; row < end; ++row) {
+            bytes += scalarSize(vector, row);
+          }
+          *sizes[i] += bytes + bits::nbytes(ranges[i].size);
+        }
+      } else {
+        addPerRow(vector->type()->cppSizeInBytes(), ranges, sizes);
+      }
+      return;
+    case VectorEncoding::Simple::CONSTANT: {
+      // The value is sent once and shared by all rows.
+      const auto numRows = countRows(ranges);
+      if (numRows == 0 || vector->isNullAt(0)) {
+        return;
+      }
+      const auto* wrapped = vector->wrappedVector();
+      IndexRange valueRange{vector->wrappedIndex(0), 1};
+      const double valueSize = wrapped == vector
+          ? scalarSize(vector, 0)
+          : estimateTotalSize(wrapped, folly::Range(&valueRange, 1));
+      addPerRow(valueSize / numRows, ranges, sizes);
+      return;
+    }
+    case VectorEncoding::Simple::DICTIONARY: {
+      // Dictionaries that are sent as such cost an index per row and the
+      // dictionary values once, shared by all rows.
+      const auto numRows = countRows(ranges);
+      auto base = vector->valueVector();
+      if (base && base->size() > 0 && base->size() <= numRows) {
+        IndexRange baseRange{0, base->size()};
+        const double baseSize = estimateTotalSize(
+            base->loadedVector(), folly::Range(&baseRange, 1));
+        addPerRow(sizeof(int32_t) + baseSize / numRows, ranges, sizes);
+        return;
+      }
+      break;
+    }
+    case VectorEncoding::Simple::BIASED:
+      addPerRow(biasedDeltaSize(vector), ranges, sizes);
+      return;
+    case VectorEncoding::Simple::ROW: {
+      addPerRow(0, ranges, sizes);
+      for (auto& child : vector->asUnchecked<RowVector>()->children()) {
+        if (child) {
+          estimateSerializedSizeInt(child->loadedVector(), ranges, sizes);
+        }
+      }
+      return;
+    }
+    case VectorEncoding::Simple::ARRAY: {
+      auto arrayVector = vector->asUnchecked<ArrayVector>();
+      estimateNestedSerializedSize(
+          arrayVector, ranges, sizes, childRanges, childSizes);
+      estimateSerializedSizeInt(
+          arrayVector->elements()->loadedVector(),
+          childRanges,
+          childSizes.data());
+      return;
+    }
+    case VectorEncoding::Simple::MAP: {
+      auto mapVector = vector->asUnchecked<MapVector>();
+      estimateNestedSerializedSize(
+          mapVector, ranges, sizes, childRanges, childSizes);
+      estimateSerializedSizeInt(
+          mapVector->mapKeys()->loadedVector(), childRanges, childSizes.data());
+      estimateSerializedSizeInt(
+          mapVector->mapValues()->loadedVector(),
+          childRanges,
+          childSizes.data());
+      return;
+    }
+    default:
+      break;
+  }
+
+  // Other encodings are sent flattened. Count the referenced values of the
+  // wrapped vector.
+  const auto* wrapped = vector->wrappedVector();
+  addPerRow(0, ranges, sizes);
+  for (int32_t i = 0; i < ranges.size(); ++i) {
+    auto end = ranges[i].begin + ranges[i].size;
+    for (auto row = ranges[i].begin; row < end; ++row) {
+      childRanges.push_back(IndexRange{vector->wrappedIndex(row), 1});
+      childSizes.push_back(sizes[i]);
+    }
+  }
+  estimateSerializedSizeInt(wrapped, childRanges, childSizes.data());
+}
+
+} // namespace
+
+void NativeVectorSerde::estimateSerializedSize(
+    VectorPtr vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes) {
+  estimateSerializedSizeInt(vector->loadedVector(), ranges, sizes);
+}
+
+std::unique_ptr<VectorSerializer> NativeVectorSerde::createSerializer(
+    std::shared_ptr<const RowType> type,
+    int32_t /*numRows*/,
+    StreamArena* streamArena) {
+  return std::make_unique<NativeVectorSerializer>(
+      type, codecType_, streamArena);
+}
+
+void NativeVectorSerde::deserialize(
+    ByteStream* source,
+    velox::memory::MemoryPool* pool,
+    std::shared_ptr<const RowType> type,
+    std::shared_ptr<RowVector>* result) {
+  // The page size allows skipping a page without decoding it.
+  source->read<int32_t>();
+  const auto numRows = source->read<int32_t>();
+  const auto numColumns = source->read<int32_t>();
+  if (numColumns == 0) {
+    *result = std::static_pointer_cast<RowVector>(
+        BaseVector::create(type, numRows, pool));
+    return;
+  }
+  VELOX_CHECK_EQ(numColumns, type->size(), "Native page does not match type");
+
+  std::vector<VectorPtr> children;
+  children.reserve(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    const auto codecType =
+        static_cast<folly::io::CodecType>(source->read<int8_t>());
+    const auto uncompressedSize = source->read<int32_t>();
+    const auto size = source->read<int32_t>();
+    auto data = AlignedBuffer::allocate<char>(size, pool);
+    source->readBytes(data->asMutable<uint8_t>(), size);
+    if (codecType == folly::io::CodecType::NO_COMPRESSION) {
+      children.push_back(
+          NodeReader(std::move(data), pool).readNode(type->childAt(i)));
+    } else {
+      children.push_back(std::make_shared<LazyVector>(
+          pool,
+          type->childAt(i),
+          numRows,
+          std::make_unique<CompressedColumnLoader>(
+              type->childAt(i),
+              codecType,
+              uncompressedSize,
+              std::move(data),
+              pool)));
+    }
+  }
+  *result = std::make_shared<RowVector>(
+      pool, type, nullptr, numRows, std::move(children));
+}
+
+// static
+void NativeVectorSerde::registerVectorSerde() {
+  VELOX_REGISTER_VECTOR_SERDE(NativeVectorSerde);
+}
+
+// static
+void NativeVectorSerde::registerNamedVectorSerde(
+    const std::string& name,
+    folly::io::CodecType codecType) {
+  velox::registerNamedVectorSerde(
+      name, std::make_unique<NativeVectorSerde>(codecType));
+}
+
+VELOX_DECLARE_VECTOR_SERDE(NativeVectorSerde);
+} // namespace facebook::velox::serializer::native
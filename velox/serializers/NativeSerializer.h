@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <folly/compression/Compression.h>
+
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::serializer::native {
+
+/// VectorSerde for exchanges between Velox workers. Unlike the Presto wire
+/// format, which flattens every column, this format keeps the encodings of the
+/// serialized vectors: constant vectors are sent as a single value, dictionary
+/// vectors as their indices plus the dictionary values and biased vectors as
+/// their deltas. Dictionaries are kept when they are not larger than the
+/// number of rows serialized, otherwise the selected rows are flattened.
+///
+/// Columns may be compressed with 'codecType'. A column is sent compressed
+/// only if this makes it smaller. Compressed columns are deserialized into
+/// LazyVectors, so that they are decompressed only when accessed.
+///
+/// Both sides of an exchange must use the same serde, e.g. by registering it
+/// with registerNamedVectorSerde() and selecting it per query with
+/// QueryConfig::kShuffleSerde.
+class NativeVectorSerde : public VectorSerde {
+ public:
+  explicit NativeVectorSerde(
+      folly::io::CodecType codecType = folly::io::CodecType::NO_COMPRESSION)
+      : codecType_(codecType) {}
+
+  void estimateSerializedSize(
+      std::shared_ptr<BaseVector> vector,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t** sizes) override;
+
+  std::unique_ptr<VectorSerializer> createSerializer(
+      std::shared_ptr<const RowType> type,
+      int32_t numRows,
+      StreamArena* streamArena) override;
+
+  void deserialize(
+      ByteStream* source,
+      velox::memory::MemoryPool* pool,
+      std::shared_ptr<const RowType> type,
+      std::shared_ptr<RowVector>* result) override;
+
+  static void registerVectorSerde();
+
+  /// Registers a NativeVectorSerde with 'codecType' under 'name' for
+  /// selection through QueryConfig::kShuffleSerde.
+  static void registerNamedVectorSerde(
+      const std::string& name = "native",
+      folly::io::CodecType codecType = folly::io::CodecType::NO_COMPRESSION);
+
+ private:
+  const folly::io::CodecType codecType_;
+};
+
+} // namespace facebook::velox::serializer::native
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/serializers/ArrowSerializer.h"
+#include <gtest/gtest.h>
+#include <numeric>
+#include "velox/common/memory/ByteStream.h"
+#include "velox/vector/BaseVector.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/tests/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+
+class ArrowSerializerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pool_ = memory::getDefaultScopedMemoryPool();
+    serde_ = std::make_unique<serializer::arrow::ArrowVectorSerde>();
+    vectorMaker_ = std::make_unique<test::VectorMaker>(pool_.get());
+  }
+
+  void sanityCheckEstimateSerializedSize(
+      RowVectorPtr rowVector,
+      const folly::Range<const IndexRange*>& ranges) {
+    std::vector<vector_size_t> rangeSizes(ranges.size(), 0);
+    std::vector<vector_size_t*> rawRangeSizes(ranges.size());
+    for (auto i = 0; i < ranges.size(); i++) {
+      rawRangeSizes[i] = &rangeSizes[i];
+    }
+    serde_->estimateSerializedSize(rowVector, ranges, rawRangeSizes.data());
+    for (auto i = 0; i < ranges.size(); i++) {
+      if (ranges[i].size > 0) {
+        EXPECT_GT(rangeSizes[i], 0);
+      }
+    }
+  }
+
+  // Serializes 'ranges' of each of 'rowVectors' into one page.
+  void serialize(
+      const std::vector<RowVectorPtr>& rowVectors,
+      const std::vector<std::vector<IndexRange>>& ranges,
+      std::ostream* output) {
+    auto arena =
+        std::make_unique<StreamArena>(memory::MappedMemory::getInstance());
+    auto rowType =
+        std::dynamic_pointer_cast<const RowType>(rowVectors[0]->type());
+    auto serializer = serde_->createSerializer(rowType, 0, arena.get());
+    for (auto i = 0; i < rowVectors.size(); ++i) {
+      auto range = folly::Range(ranges[i].data(), ranges[i].size());
+      sanityCheckEstimateSerializedSize(rowVectors[i], range);
+      serializer->append(rowVectors[i], range);
+    }
+    OStreamOutputStream out(output);
+    serializer->flush(&out);
+  }
+
+  void serialize(RowVectorPtr rowVector, std::ostream* output) {
+    serialize({rowVector}, {{IndexRange{0, rowVector->size()}}}, output);
+  }
+
+  std::unique_ptr<ByteStream> toByteStream(const std::string& input) {
+    auto byteStream = std::make_unique<ByteStream>();
+    ByteRange byteRange{
+        reinterpret_cast<uint8_t*>(const_cast<char*>(input.data())),
+        (int32_t)input.length(),
+        0};
+    byteStream->resetInput({byteRange});
+    return byteStream;
+  }
+
+  RowVectorPtr deserialize(
+      std::shared_ptr<const RowType> rowType,
+      const std::string& input) {
+    auto byteStream = toByteStream(input);
+
+    RowVectorPtr result;
+    serde_->deserialize(byteStream.get(), pool_.get(), rowType, &result);
+    EXPECT_TRUE(byteStream->atEnd());
+    return result;
+  }
+
+  RowVectorPtr testRoundTrip(VectorPtr vector) {
+    auto rowVector = vectorMaker_->rowVector({vector});
+    std::ostringstream out;
+    serialize(rowVector, &out);
+
+    auto rowType = std::dynamic_pointer_cast<const RowType>(rowVector->type());
+    auto deserialized = deserialize(rowType, out.str());
+    assertEqualVectors(rowVector, deserialized);
+    return deserialized;
+  }
+
+  std::unique_ptr<memory::MemoryPool> pool_;
+  std::unique_ptr<VectorSerde> serde_;
+  std::unique_ptr<test::VectorMaker> vectorMaker_;
+};
+
+TEST_F(ArrowSerializerTest, basic) {
+  vector_size_t numRows = 1'000;
+  auto rowVector = vectorMaker_->rowVector(
+      {vectorMaker_->flatVector<int64_t>(
+           numRows, [](vector_size_t row) { return row; }),
+       vectorMaker_->flatVector<double>(
+           numRows,
+           [](vector_size_t row) { return row * 0.1; },
+           VectorMaker::nullEvery(7)),
+       vectorMaker_->flatVector<bool>(
+           numRows, [](vector_size_t row) { return row % 3 == 0; }),
+       vectorMaker_->flatVector<StringView>(
+           numRows,
+           [](vector_size_t row) {
+             return row % 2 ? StringView("a string that is not inlined")
+                            : StringView("short");
+           },
+           VectorMaker::nullEvery(11))});
+
+  std::ostringstream out;
+  serialize(rowVector, &out);
+
+  auto rowType = std::dynamic_pointer_cast<const RowType>(rowVector->type());
+  auto deserialized = deserialize(rowType, out.str());
+  assertEqualVectors(rowVector, deserialized);
+}
+
+TEST_F(ArrowSerializerTest, dictionary) {
+  vector_size_t size = 1'000;
+  std::vector<std::string> values;
+  for (auto i = 0; i < 10; i++) {
+    values.push_back(fmt::format("dictionary value number {}", i));
+  }
+  auto base = vectorMaker_->flatVector(values);
+
+  BufferPtr nulls = AlignedBuffer::allocate<bool>(size, pool_.get());
+  auto rawNulls = nulls->asMutable<uint64_t>();
+  BufferPtr indices = AlignedBuffer::allocate<vector_size_t>(size, pool_.get());
+  auto rawIndices = indices->asMutable<vector_size_t>();
+  for (auto i = 0; i < size; i++) {
+    bits::setNull(rawNulls, i, i % 5 == 0);
+    rawIndices[i] = i % 10;
+  }
+
+  auto dictionary = BaseVector::wrapInDictionary(nulls, indices, size, base);
+  auto deserialized = testRoundTrip(dictionary);
+
+  // The encoding is kept and only the 10 distinct values are sent.
+  auto column = deserialized->childAt(0);
+  ASSERT_EQ(VectorEncoding::Simple::DICTIONARY, column->encoding());
+  EXPECT_EQ(10, column->valueVector()->size());
+}
+
+TEST_F(ArrowSerializerTest, nested) {
+  auto arrayVector = vectorMaker_->arrayVector<int32_t>(
+      1'000,
+      [](vector_size_t row) { return row % 5; },
+      [](vector_size_t row) { return row; },
+      VectorMaker::nullEvery(13));
+  testRoundTrip(arrayVector);
+
+  auto mapVector = vectorMaker_->mapVector<int32_t, StringView>(
+      1'000,
+      [](vector_size_t row) { return row % 5; },
+      [](vector_size_t row) { return row; },
+      [](vector_size_t row) {
+        return row % 2 ? StringView("a map value that is not inlined")
+                       : StringView("short");
+      },
+      VectorMaker::nullEvery(17));
+  testRoundTrip(mapVector);
+
+  testRoundTrip(vectorMaker_->rowVector({arrayVector, mapVector}));
+}
+
+TEST_F(ArrowSerializerTest, constant) {
+  testRoundTrip(
+      BaseVector::createConstant(variant(int64_t(11)), 100, pool_.get()));
+  testRoundTrip(BaseVector::createNullConstant(VARCHAR(), 100, pool_.get()));
+}
+
+TEST_F(ArrowSerializerTest, ranges) {
+  auto first = vectorMaker_->rowVector({vectorMaker_->flatVector<int64_t>(
+      100,
+      [](vector_size_t row) { return row; },
+      VectorMaker::nullEvery(3))});
+  auto second = vectorMaker_->rowVector({vectorMaker_->flatVector<int64_t>(
+      100, [](vector_size_t row) { return 1000 + row; })});
+
+  std::ostringstream out;
+  serialize(
+      {first, second},
+      {{IndexRange{10, 5}, IndexRange{50, 20}}, {IndexRange{0, 100}}},
+      &out);
+
+  auto rowType = std::dynamic_pointer_cast<const RowType>(first->type());
+  auto deserialized = deserialize(rowType, out.str());
+  ASSERT_EQ(125, deserialized->size());
+
+  auto expected = BaseVector::create(rowType, 125, pool_.get());
+  expected->copy(first.get(), 0, 10, 5);
+  expected->copy(first.get(), 5, 50, 20);
+  expected->copy(second.get(), 25, 0, 100);
+  assertEqualVectors(expected, deserialized);
+}
+
+TEST_F(ArrowSerializerTest, rangesOfDictionary) {
+  vector_size_t size = 1'000;
+  std::vector<std::string> values;
+  for (auto i = 0; i < 10; i++) {
+    values.push_back(fmt::format("dictionary value number {}", i));
+  }
+  auto base = vectorMaker_->flatVector(values);
+  BufferPtr indices = AlignedBuffer::allocate<vector_size_t>(size, pool_.get());
+  auto rawIndices = indices->asMutable<vector_size_t>();
+  for (auto i = 0; i < size; i++) {
+    rawIndices[i] = i % 10;
+  }
+  auto rowVector = vectorMaker_->rowVector(
+      {BaseVector::wrapInDictionary(nullptr, indices, size, base)});
+
+  std::ostringstream out;
+  serialize(
+      {rowVector, rowVector},
+      {{IndexRange{10, 5}, IndexRange{50, 20}}, {IndexRange{200, 100}}},
+      &out);
+
+  auto rowType = std::dynamic_pointer_cast<const RowType>(rowVector->type());
+  auto deserialized = deserialize(rowType, out.str());
+  ASSERT_EQ(125, deserialized->size());
+
+  auto expected = BaseVector::create(rowType, 125, pool_.get());
+  expected->copy(rowVector.get(), 0, 10, 5);
+  expected->copy(rowVector.get(), 5, 50, 20);
+  expected->copy(rowVector.get(), 25, 200, 100);
+  assertEqualVectors(expected, deserialized);
+
+  // The rows of both appends reference the 10 values of the same base.
+  auto column = deserialized->childAt(0);
+  ASSERT_EQ(VectorEncoding::Simple::DICTIONARY, column->encoding());
+  EXPECT_EQ(10, column->valueVector()->size());
+}
+
+TEST_F(ArrowSerializerTest, wholeDictionaryOverLargeBase) {
+  // A filter keeps 100 of 10'000 rows. The whole filtered vector is appended.
+  vector_size_t baseSize = 10'000;
+  vector_size_t size = 100;
+  auto base = vectorMaker_->flatVector<int64_t>(
+      baseSize, [](vector_size_t row) { return row; });
+  BufferPtr indices = AlignedBuffer::allocate<vector_size_t>(size, pool_.get());
+  auto rawIndices = indices->asMutable<vector_size_t>();
+  for (auto i = 0; i < size; i++) {
+    rawIndices[i] = i * 100;
+  }
+  auto rowVector = vectorMaker_->rowVector(
+      {BaseVector::wrapInDictionary(nullptr, indices, size, base)});
+
+  std::vector<IndexRange> rows(size);
+  std::vector<vector_size_t> rowSizes(size, 0);
+  std::vector<vector_size_t*> rawRowSizes(size);
+  for (auto i = 0; i < size; i++) {
+    rows[i] = IndexRange{i, 1};
+    rawRowSizes[i] = &rowSizes[i];
+  }
+  serde_->estimateSerializedSize(
+      rowVector, folly::Range(rows.data(), size), rawRowSizes.data());
+  auto estimate = std::accumulate(rowSizes.begin(), rowSizes.end(), size_t{0});
+
+  std::ostringstream out;
+  serialize(rowVector, &out);
+
+  // Only the 100 selected values are sent, not the base.
+  auto serializedSize = out.str().size();
+  EXPECT_LT(serializedSize, 2 * size * sizeof(int64_t));
+  EXPECT_LE(estimate, 2 * serializedSize);
+  EXPECT_LE(serializedSize, 2 * estimate);
+
+  auto rowType = std::dynamic_pointer_cast<const RowType>(rowVector->type());
+  auto deserialized = deserialize(rowType, out.str());
+  assertEqualVectors(rowVector, deserialized);
+  EXPECT_EQ(
+      VectorEncoding::Simple::FLAT, deserialized->childAt(0)->encoding());
+}
+
+TEST_F(ArrowSerializerTest, emptyPage) {
+  auto rowVector = vectorMaker_->rowVector(ROW({"a"}, {BIGINT()}), 0);
+
+  std::ostringstream out;
+  serialize(rowVector, &out);
+
+  auto rowType = std::dynamic_pointer_cast<const RowType>(rowVector->type());
+  auto deserialized = deserialize(rowType, out.str());
+  assertEqualVectors(rowVector, deserialized);
+}
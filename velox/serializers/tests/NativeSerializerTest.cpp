@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/serializers/NativeSerializer.h"
+#include <gtest/gtest.h>
+#include "velox/common/memory/ByteStream.h"
+#include "velox/vector/BaseVector.h"
+#include "velox/vector/BiasVector.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/LazyVector.h"
+#include "velox/vector/tests/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+
+class NativeSerializerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pool_ = memory::getDefaultScopedMemoryPool();
+    serde_ = std::make_unique<serializer::native::NativeVectorSerde>();
+    vectorMaker_ = std::make_unique<test::VectorMaker>(pool_.get());
+  }
+
+  void sanityCheckEstimateSerializedSize(
+      RowVectorPtr rowVector,
+      const folly::Range<const IndexRange*>& ranges) {
+    std::vector<vector_size_t> rangeSizes(ranges.size(), 0);
+    std::vector<vector_size_t*> rawRangeSizes(ranges.size());
+    for (auto i = 0; i < ranges.size(); i++) {
+      rawRangeSizes[i] = &rangeSizes[i];
+    }
+    serde_->estimateSerializedSize(rowVector, ranges, rawRangeSizes.data());
+    for (auto i = 0; i < ranges.size(); i++) {
+      if (ranges[i].size > 0) {
+        EXPECT_GT(rangeSizes[i], 0);
+      }
+    }
+  }
+
+  void serialize(
+      const std::vector<RowVectorPtr>& rowVectors,
+      const std::vector<std::vector<IndexRange>>& ranges,
+      std::ostream* output) {
+    auto arena =
+        std::make_unique<StreamArena>(memory::MappedMemory::getInstance());
+    auto rowType =
+        std::dynamic_pointer_cast<const RowType>(rowVectors[0]->type());
+    auto serializer = serde_->createSerializer(rowType, 0, arena.get());
+    for (auto i = 0; i < rowVectors.size(); ++i) {
+      auto range = folly::Range(ranges[i].data(), ranges[i].size());
+      sanityCheckEstimateSerializedSize(rowVectors[i], range);
+      serializer->append(rowVectors[i], range);
+    }
+    OStreamOutputStream out(output);
+    serializer->flush(&out);
+  }
+
+  void serialize(RowVectorPtr rowVector, std::ostream* output) {
+    serialize({rowVector}, {{IndexRange{0, rowVector->size()}}}, output);
+  }
+
+  // Reads all pages in 'input', as Exchange does.
+  std::vector<RowVectorPtr> deserialize(
+      std::shared_ptr<const RowType> rowType,
+      const std::string& input) {
+    auto byteStream = std::make_unique<ByteStream>();
+    ByteRange byteRange{
+        reinterpret_cast<uint8_t*>(const_cast<char*>(input.data())),
+        (int32_t)input.length(),
+        0};
+    byteStream->resetInput({byteRange});
+
+    std::vector<RowVectorPtr> results;
+    while (!byteStream->atEnd()) {
+      RowVectorPtr result;
+      serde_->deserialize(byteStream.get(), pool_.get(), rowType, &result);
+      results.push_back(std::move(result));
+    }
+    return results;
+  }
+
+  // Round trips 'vector' and returns the deserialized column.
+  VectorPtr testRoundTrip(VectorPtr vector) {
+    auto rowVector = vectorMaker_->rowVector({vector});
+    std::ostringstream out;
+    serialize(rowVector, &out);
+
+    auto rowType = std::dynamic_pointer_cast<const RowType>(rowVector->type());
+    auto deserialized = deserialize(rowType, out.str());
+    EXPECT_EQ(1, deserialized.size());
+    assertEqualVectors(rowVector, deserialized[0]);
+    return deserialized[0]->childAt(0);
+  }
+
+  VectorPtr makeDictionary(vector_size_t size, VectorPtr base) {
+    BufferPtr nulls = AlignedBuffer::allocate<bool>(size, pool_.get());
+    auto rawNulls = nulls->asMutable<uint64_t>();
+    BufferPtr indices =
+        AlignedBuffer::allocate<vector_size_t>(size, pool_.get());
+    auto rawIndices = indices->asMutable<vector_size_t>();
+    for (auto i = 0; i < size; i++) {
+      bits::setNull(rawNulls, i, i % 5 == 0);
+      rawIndices[i] = (i * 7) % base->size();
+    }
+    return BaseVector::wrapInDictionary(nulls, indices, size, base);
+  }
+
+  std::unique_ptr<memory::MemoryPool> pool_;
+  std::unique_ptr<VectorSerde> serde_;
+  std::unique_ptr<test::VectorMaker> vectorMaker_;
+};
+
+TEST_F(NativeSerializerTest, basic) {
+  vector_size_t numRows = 1'000;
+  auto rowVector = vectorMaker_->rowVector(
+      {vectorMaker_->flatVector<int64_t>(
+           numRows, [](vector_size_t row) { return row; }),
+       vectorMaker_->flatVector<double>(
+           numRows,
+           [](vector_size_t row) { return row * 0.1; },
+           VectorMaker::nullEvery(7)),
+       vectorMaker_->flatVector<bool>(
+           numRows, [](vector_size_t row) { return row % 3 == 0; }),
+       vectorMaker_->flatVector<StringView>(
+           numRows,
+           [](vector_size_t row) {
+             return row % 2 ? StringView("a string that is not inlined")
+                            : StringView("short");
+           },
+           VectorMaker::nullEvery(11))});
+
+  std::ostringstream out;
+  serialize(rowVector, &out);
+
+  auto rowType = std::dynamic_pointer_cast<const RowType>(rowVector->type());
+  auto deserialized = deserialize(rowType, out.str());
+  ASSERT_EQ(1, deserialized.size());
+  assertEqualVectors(rowVector, deserialized[0]);
+}
+
+TEST_F(NativeSerializerTest, dictionary) {
+  std::vector<std::string> values;
+  for (auto i = 0; i < 10; i++) {
+    values.push_back(fmt::format("dictionary value number {}", i));
+  }
+  auto column = testRoundTrip(
+      makeDictionary(1'000, vectorMaker_->flatVector(values)));
+
+  // The encoding is kept and only the 10 distinct values are sent.
+  ASSERT_EQ(VectorEncoding::Simple::DICTIONARY, column->encoding());
+  EXPECT_EQ(10, column->valueVector()->size());
+
+  // A dictionary with more values than rows is flattened.
+  auto base = vectorMaker_->flatVector<int64_t>(
+      1'000, [](vector_size_t row) { return row; });
+  column = testRoundTrip(makeDictionary(100, base));
+  EXPECT_EQ(VectorEncoding::Simple::FLAT, column->encoding());
+}
+
+TEST_F(NativeSerializerTest, constant) {
+  auto column = testRoundTrip(
+      BaseVector::createConstant(variant(int64_t(11)), 100, pool_.get()));
+  EXPECT_EQ(VectorEncoding::Simple::CONSTANT, column->encoding());
+
+  column = testRoundTrip(BaseVector::createConstant(
+      variant("a constant string"), 100, pool_.get()));
+  EXPECT_EQ(VectorEncoding::Simple::CONSTANT, column->encoding());
+
+  column = testRoundTrip(
+      BaseVector::createNullConstant(VARCHAR(), 100, pool_.get()));
+  EXPECT_EQ(VectorEncoding::Simple::CONSTANT, column->encoding());
+
+  auto arrayVector = vectorMaker_->arrayVector<int32_t>(
+      10,
+      [](vector_size_t row) { return row; },
+      [](vector_size_t row) { return row; });
+  column = testRoundTrip(BaseVector::wrapInConstant(100, 7, arrayVector));
+  EXPECT_EQ(VectorEncoding::Simple::CONSTANT, column->encoding());
+}
+
+TEST_F(NativeSerializerTest, biased) {
+  vector_size_t size = 1'000;
+  BufferPtr deltas = AlignedBuffer::allocate<int8_t>(size, pool_.get());
+  auto rawDeltas = deltas->asMutable<int8_t>();
+  for (auto i = 0; i < size; i++) {
+    rawDeltas[i] = i % 100 - 50;
+  }
+  auto biased = std::make_shared<BiasVector<int64_t>>(
+      pool_.get(),
+      nullptr,
+      size,
+      TypeKind::TINYINT,
+      deltas,
+      int64_t(1) << 40);
+
+  auto column = testRoundTrip(biased);
+  EXPECT_EQ(VectorEncoding::Simple::BIASED, column->encoding());
+}
+
+TEST_F(NativeSerializerTest, nested) {
+  auto arrayVector = vectorMaker_->arrayVector<int32_t>(
+      1'000,
+      [](vector_size_t row) { return row % 5; },
+      [](vector_size_t row) { return row; },
+      VectorMaker::nullEvery(13));
+  testRoundTrip(arrayVector);
+
+  auto mapVector = vectorMaker_->mapVector<int32_t, StringView>(
+      1'000,
+      [](vector_size_t row) { return row % 5; },
+      [](vector_size_t row) { return row; },
+      [](vector_size_t row) {
+        return row % 2 ? StringView("a map value that is not inlined")
+                       : StringView("short");
+      },
+      VectorMaker::nullEvery(17));
+  testRoundTrip(mapVector);
+
+  testRoundTrip(vectorMaker_->rowVector({arrayVector, mapVector}));
+}
+
+TEST_F(NativeSerializerTest, ranges) {
+  auto first = vectorMaker_->rowVector({vectorMaker_->flatVector<int64_t>(
+      100,
+      [](vector_size_t row) { return row; },
+      VectorMaker::nullEvery(3))});
+  auto second = vectorMaker_->rowVector({vectorMaker_->flatVector<int64_t>(
+      100, [](vector_size_t row) { return 1000 + row; })});
+
+  std::ostringstream out;
+  serialize(
+      {first, second},
+      {{IndexRange{10, 5}, IndexRange{50, 20}}, {IndexRange{0, 100}}},
+      &out);
+
+  // Each append is a separate page.
+  auto rowType = std::dynamic_pointer_cast<const RowType>(first->type());
+  auto deserialized = deserialize(rowType, out.str());
+  ASSERT_EQ(2, deserialized.size());
+
+  auto expected = BaseVector::create(rowType, 25, pool_.get());
+  expected->copy(first.get(), 0, 10, 5);
+  expected->copy(first.get(), 5, 50, 20);
+  assertEqualVectors(expected, deserialized[0]);
+  assertEqualVectors(second, deserialized[1]);
+}
+
+TEST_F(NativeSerializerTest, compression) {
+  if (!folly::io::hasCodec(folly::io::CodecType::ZLIB)) {
+    GTEST_SKIP() << "ZLIB codec is not available";
+  }
+  serde_ = std::make_unique<serializer::native::NativeVectorSerde>(
+      folly::io::CodecType::ZLIB);
+
+  auto rowVector = vectorMaker_->rowVector(
+      {vectorMaker_->flatVector<int64_t>(
+           1'000, [](vector_size_t row) { return row % 10; }),
+       BaseVector::createConstant(variant(int32_t(7)), 1'000, pool_.get())});
+
+  std::ostringstream out;
+  serialize(rowVector, &out);
+  EXPECT_LT(out.str().size(), 1'000 * sizeof(int64_t));
+
+  auto rowType = std::dynamic_pointer_cast<const RowType>(rowVector->type());
+  auto deserialized = deserialize(rowType, out.str());
+  ASSERT_EQ(1, deserialized.size());
+
+  // The compressible column is decompressed on first access. The small
+  // constant column is sent uncompressed.
+  EXPECT_EQ(
+      VectorEncoding::Simple::LAZY, deserialized[0]->childAt(0)->encoding());
+  EXPECT_EQ(
+      VectorEncoding::Simple::CONSTANT,
+      deserialized[0]->childAt(1)->encoding());
+  assertEqualVectors(rowVector->childAt(0), deserialized[0]->loadedChildAt(0));
+  assertEqualVectors(rowVector->childAt(1), deserialized[0]->childAt(1));
+}
+
+TEST_F(NativeSerializerTest, emptyPage) {
+  auto rowVector = vectorMaker_->rowVector(ROW({"a"}, {BIGINT()}), 0);
+
+  std::ostringstream out;
+  serialize(rowVector, &out);
+
+  auto rowType = std::dynamic_pointer_cast<const RowType>(rowVector->type());
+  auto deserialized = deserialize(rowType, out.str());
+  ASSERT_EQ(1, deserialized.size());
+  assertEqualVectors(rowVector, deserialized[0]);
+}
+
+TEST_F(NativeSerializerTest, namedSerde) {
+  serializer::native::NativeVectorSerde::registerNamedVectorSerde(
+      "native_test");
+  auto* serde = getNamedVectorSerde("native_test");
+  ASSERT_NE(nullptr, serde);
+  EXPECT_NE(
+      nullptr, dynamic_cast<serializer::native::NativeVectorSerde*>(serde));
+  EXPECT_THROW(
+      serializer::native::NativeVectorSerde::registerNamedVectorSerde(
+          "native_test"),
+      VeloxRuntimeError);
+  EXPECT_THROW(getNamedVectorSerde("unknown"), VeloxUserError);
+}
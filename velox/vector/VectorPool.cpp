@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/vector/VectorPool.h"
+
+namespace facebook::velox {
+
+namespace {
+// Returns the largest 'i' such that 2^i <= 'size'. 'size' must be > 0.
+int32_t floorLog2(vector_size_t size) {
+  return 63 - __builtin_clzll(size);
+}
+
+bool isPoolable(const TypePtr& type) {
+  return type->isPrimitiveType() &&
+      static_cast<int32_t>(type->kind()) <=
+      static_cast<int32_t>(TypeKind::DATE);
+}
+} // namespace
+
+VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
+  if (isPoolable(type) && size <= kMaxRecycleSize) {
+    auto& kindPool = pools_[static_cast<int32_t>(type->kind())];
+    // Vectors in the size class of 'size' may be too small. All vectors in
+    // the next class are large enough. Larger classes are not searched so as
+    // not to hand out vectors much larger than needed.
+    auto sizeClass = size == 0 ? 0 : floorLog2(size);
+    for (auto i = sizeClass; i < std::min(sizeClass + 2, kNumSizeClasses);
+         ++i) {
+      auto& pool = kindPool[i];
+      for (auto j = pool.numVectors - 1; j >= 0; --j) {
+        if (pool.vectors[j]->size() < size ||
+            *pool.vectors[j]->type() != *type) {
+          continue;
+        }
+        auto vector = std::move(pool.vectors[j]);
+        pool.vectors[j] = std::move(pool.vectors[--pool.numVectors]);
+        vector->resize(size, false);
+        if (vector->mayHaveNulls()) {
+          vector->clearAllNulls();
+        }
+        ++numHits_;
+        return vector;
+      }
+    }
+  }
+  ++numMisses_;
+  return BaseVector::create(type, size, pool_);
+}
+
+bool VectorPool::release(VectorPtr& vector) {
+  if (!vector || !isPoolable(vector->type()) || vector->size() == 0 ||
+      vector->size() > kMaxRecycleSize || vector->pool() != pool_ ||
+      !BaseVector::isReusableFlatVector(vector)) {
+    return false;
+  }
+  auto& pool = pools_[static_cast<int32_t>(vector->typeKind())]
+                     [floorLog2(vector->size())];
+  if (pool.numVectors == kVectorsPerSizeClass) {
+    return false;
+  }
+  vector->prepareForReuse();
+  pool.vectors[pool.numVectors++] = std::move(vector);
+  vector = nullptr;
+  return true;
+}
+
+size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
+  size_t numReleased = 0;
+  for (auto& vector : vectors) {
+    if (release(vector)) {
+      ++numReleased;
+    }
+  }
+  return numReleased;
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox {
+
+/// A pool of flat vectors of primitive types for reuse as results of operators
+/// and expressions. Vectors are kept by type kind and by size class, where
+/// size class 'i' holds vectors of at least 2^i rows. A vector is taken into
+/// the pool only if it and its buffers are singly referenced. Not thread-safe.
+class VectorPool {
+ public:
+  explicit VectorPool(memory::MemoryPool* FOLLY_NONNULL pool) : pool_(pool) {}
+
+  /// Returns a flat vector of 'type' and 'size'. Reuses a pooled vector if one
+  /// is available for the type and size, else makes a new one. The vector has
+  /// no nulls and the values are undefined.
+  VectorPtr get(const TypePtr& type, vector_size_t size);
+
+  /// Moves 'vector' into the pool and sets it to nullptr if it is a singly
+  /// referenced flat vector of primitive type and there is space in the pool.
+  /// Returns true if the vector was taken.
+  bool release(VectorPtr& vector);
+
+  /// Calls release() on each of 'vectors'. Returns the number of vectors
+  /// taken.
+  size_t release(std::vector<VectorPtr>& vectors);
+
+  /// Number of get() calls served from the pool.
+  uint64_t numHits() const {
+    return numHits_;
+  }
+
+  /// Number of get() calls that made a new vector.
+  uint64_t numMisses() const {
+    return numMisses_;
+  }
+
+  // Vectors larger than this are not pooled.
+  static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
+
+  // Maximum number of vectors kept per type kind and size class.
+  static constexpr int32_t kVectorsPerSizeClass = 4;
+
+ private:
+  static constexpr int32_t kNumSizeClasses = 17; // 2^16 = kMaxRecycleSize.
+  static constexpr int32_t kNumKinds = static_cast<int32_t>(TypeKind::DATE) + 1;
+
+  struct SizeClass {
+    int32_t numVectors{0};
+    std::array<VectorPtr, kVectorsPerSizeClass> vectors;
+  };
+
+  memory::MemoryPool* FOLLY_NONNULL const pool_;
+  std::array<std::array<SizeClass, kNumSizeClasses>, kNumKinds> pools_;
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+};
+
+} // namespace facebook::velox
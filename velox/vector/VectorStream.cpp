@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include "velox/vector/VectorStream.h"
+#include <folly/Synchronized.h>
 #include <memory>
+#include <unordered_map>
 
 namespace facebook::velox {
 
@@ -23,6 +25,23 @@ std::unique_ptr<VectorSerde>& getVectorSerde() {
   static std::unique_ptr<VectorSerde> serde;
   return serde;
 }
+
+folly::Synchronized<
+    std::unordered_map<std::string, std::unique_ptr<VectorSerde>>>&
+namedVectorSerdes() {
+  static folly::Synchronized<
+      std::unordered_map<std::string, std::unique_ptr<VectorSerde>>>
+      serdes;
+  return serdes;
+}
+
+VectorSerde* resolveSerde(VectorSerde* serde) {
+  if (serde) {
+    return serde;
+  }
+  VELOX_CHECK(getVectorSerde().get(), "Vector serde is not registered");
+  return getVectorSerde().get();
+}
 } // namespace
 
 bool registerVectorSerde(std::unique_ptr<VectorSerde> serde) {
@@ -35,11 +54,37 @@ bool isRegisteredVectorSerde() {
   return (getVectorSerde().get() != nullptr);
 }
 
+bool registerNamedVectorSerde(
+    const std::string& name,
+    std::unique_ptr<VectorSerde> serde) {
+  VELOX_CHECK(!name.empty(), "Named vector serde needs a non-empty name");
+  namedVectorSerdes().withWLock([&](auto& serdes) {
+    VELOX_CHECK(
+        serdes.find(name) == serdes.end(),
+        "Vector serde '{}' is already registered",
+        name);
+    serdes[name] = std::move(serde);
+  });
+  return true;
+}
+
+VectorSerde* getNamedVectorSerde(const std::string& name) {
+  if (name.empty()) {
+    return getVectorSerde().get();
+  }
+  return namedVectorSerdes().withRLock([&](const auto& serdes) {
+    auto it = serdes.find(name);
+    VELOX_USER_CHECK(
+        it != serdes.end(), "Vector serde '{}' is not registered", name);
+    return it->second.get();
+  });
+}
+
 void VectorStreamGroup::createStreamTree(
     std::shared_ptr<const RowType> type,
-    int32_t numRows) {
-  VELOX_CHECK(getVectorSerde().get(), "Vector serde is not registered");
-  serializer_ = getVectorSerde()->createSerializer(type, numRows, this);
+    int32_t numRows,
+    VectorSerde* serde) {
+  serializer_ = resolveSerde(serde)->createSerializer(type, numRows, this);
 }
 
 void VectorStreamGroup::append(
@@ -56,9 +101,9 @@ void VectorStreamGroup::flush(OutputStream* out) {
 void VectorStreamGroup::estimateSerializedSize(
     std::shared_ptr<BaseVector> vector,
     const folly::Range<const IndexRange*>& ranges,
-    vector_size_t** sizes) {
-  VELOX_CHECK(getVectorSerde().get(), "Vector serde is not registered");
-  getVectorSerde()->estimateSerializedSize(vector, ranges, sizes);
+    vector_size_t** sizes,
+    VectorSerde* serde) {
+  resolveSerde(serde)->estimateSerializedSize(vector, ranges, sizes);
 }
 
 // static
@@ -66,9 +111,9 @@ void VectorStreamGroup::read(
     ByteStream* source,
     velox::memory::MemoryPool* pool,
     std::shared_ptr<const RowType> type,
-    std::shared_ptr<RowVector>* result) {
-  VELOX_CHECK(getVectorSerde().get(), "Vector serde is not registered");
-  getVectorSerde()->deserialize(source, pool, type, result);
+    std::shared_ptr<RowVector>* result,
+    VectorSerde* serde) {
+  resolveSerde(serde)->deserialize(source, pool, type, result);
 }
 
 } // namespace facebook::velox
@@ -71,6 +71,18 @@ bool registerVectorSerde(std::unique_ptr<VectorSerde> serde);
 
 bool isRegisteredVectorSerde();
 
+/// Registers an additional serde under 'name'. Named serdes are alternatives
+/// to the default one, e.g. for exchanges between Velox workers, and are
+/// selected per query by name. Throws if 'name' is already registered.
+bool registerNamedVectorSerde(
+    const std::string& name,
+    std::unique_ptr<VectorSerde> serde);
+
+/// Returns the serde registered under 'name'. An empty 'name' returns the
+/// default serde, which may be nullptr if none is registered. Throws if no
+/// serde is registered under a non-empty 'name'.
+VectorSerde* getNamedVectorSerde(const std::string& name);
+
 #define _VELOX_REGISTER_VECTOR_SERDE_NAME(serde) registerVectorSerde_##serde
 
 #define VELOX_DECLARE_VECTOR_SERDE(serde)             \
@@ -89,12 +101,18 @@ class VectorStreamGroup : public StreamArena {
   explicit VectorStreamGroup(memory::MappedMemory* mappedMemory)
       : StreamArena(mappedMemory) {}
 
-  void createStreamTree(std::shared_ptr<const RowType> type, int32_t numRows);
+  // Prepares to serialize 'numRows' rows of 'type' with 'serde'. Uses the
+  // default serde if 'serde' is nullptr.
+  void createStreamTree(
+      std::shared_ptr<const RowType> type,
+      int32_t numRows,
+      VectorSerde* serde = nullptr);
 
   static void estimateSerializedSize(
       std::shared_ptr<BaseVector> vector,
       const folly::Range<const IndexRange*>& ranges,
-      vector_size_t** sizes);
+      vector_size_t** sizes,
+      VectorSerde* serde = nullptr);
 
   void append(
       std::shared_ptr<RowVector> vector,
@@ -103,12 +121,14 @@ class VectorStreamGroup : public StreamArena {
   // Writes the contents to 'stream' in wire format.
   void flush(OutputStream* stream);
 
-  // Reads data in wire format. Returns the RowVector in 'result'.
+  // Reads data in wire format. Returns the RowVector in 'result'. 'serde' must
+  // be the serde the data was written with, nullptr for the default serde.
   static void read(
       ByteStream* source,
       velox::memory::MemoryPool* pool,
       std::shared_ptr<const RowType> type,
-      std::shared_ptr<RowVector>* result);
+      std::shared_ptr<RowVector>* result,
+      VectorSerde* serde = nullptr);
 
  private:
   std::unique_ptr<VectorSerializer> serializer_;
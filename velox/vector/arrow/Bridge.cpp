@@ -21,6 +21,8 @@
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/FlatVector.h"
 
+#include <cerrno>
+
 namespace facebook::velox {
 
 namespace {
@@ -77,6 +79,12 @@ class VeloxToArrowBridgeHolder {
     return children_.get();
   }
 
+  // Allocates the ArrowArray structure for the values of a dictionary.
+  ArrowArray* allocateDictionary() {
+    dictionary_ = std::make_unique<ArrowArray>();
+    return dictionary_.get();
+  }
+
  private:
   // Holds the pointers to the arrow buffers.
   const void* buffers_[kMaxBuffers];
@@ -91,6 +99,9 @@ class VeloxToArrowBridgeHolder {
   // Array that will hold pointers to the structures above - to be used by
   // ArrowArray.children
   std::unique_ptr<ArrowArray*[]> children_;
+
+  // Holds ownership over the ArrowArray.dictionary structure, if any.
+  std::unique_ptr<ArrowArray> dictionary_;
 };
 
 // Structure that will hold buffers needed by ArrowSchema. This is opaquely
@@ -109,6 +120,10 @@ struct VeloxToArrowSchemaBridgeHolder {
   // ArrowSchema.name pointer to the internal string that contains the column
   // name.
   RowTypePtr rowType;
+
+  // Schema of the dictionary values when exporting a dictionary encoded
+  // vector.
+  std::unique_ptr<ArrowSchema> dictionary;
 };
 
 // Release function for ArrowArray. Arrow standard requires it to recurse down
@@ -268,6 +283,190 @@ void exportRowVector(
   arrowArray.children = bridgeHolder.getChildrenArrays();
 }
 
+// Returns true if the non-empty rows of 'vector' reference consecutive ranges
+// of its elements in row order. The elements of such a vector can be exported
+// as is, with Arrow offsets pointing into them.
+template <typename TVector>
+bool hasConsecutiveRanges(const TVector& vector) {
+  auto rawOffsets = vector.rawOffsets();
+  auto rawSizes = vector.rawSizes();
+  auto rawNulls = vector.rawNulls();
+  std::optional<vector_size_t> end;
+  for (vector_size_t i = 0; i < vector.size(); ++i) {
+    if ((rawNulls && bits::isBitNull(rawNulls, i)) || rawSizes[i] == 0) {
+      continue;
+    }
+    if (end.has_value() && rawOffsets[i] != end.value()) {
+      return false;
+    }
+    end = rawOffsets[i] + rawSizes[i];
+  }
+  return true;
+}
+
+// Writes the Arrow offsets of 'vector' to buffer 1. If 'consecutive', the
+// offsets point into the elements of 'vector' as is. Otherwise they point into
+// the elements returned by compactElements().
+template <typename TOffset, typename TVector>
+void exportOffsets(
+    const TVector& vector,
+    bool consecutive,
+    VeloxToArrowBridgeHolder& bridgeHolder,
+    memory::MemoryPool* pool) {
+  auto rawOffsets = vector.rawOffsets();
+  auto rawSizes = vector.rawSizes();
+  auto rawNulls = vector.rawNulls();
+  auto isEmpty = [&](vector_size_t row) {
+    return (rawNulls && bits::isBitNull(rawNulls, row)) || rawSizes[row] == 0;
+  };
+
+  bridgeHolder.setBuffer(
+      1, AlignedBuffer::allocate<TOffset>(vector.size() + 1, pool));
+  auto arrowOffsets = bridgeHolder.getBufferAs<TOffset>(1);
+  arrowOffsets[0] = 0;
+  if (consecutive) {
+    for (vector_size_t i = 0; i < vector.size(); ++i) {
+      if (!isEmpty(i)) {
+        arrowOffsets[0] = rawOffsets[i];
+        break;
+      }
+    }
+  }
+  for (vector_size_t i = 0; i < vector.size(); ++i) {
+    arrowOffsets[i + 1] = arrowOffsets[i] + (isEmpty(i) ? 0 : rawSizes[i]);
+  }
+}
+
+// Copies the ranges of 'elements' referenced by the non-empty rows of
+// 'vector' into a new flat vector, in row order.
+template <typename TVector>
+VectorPtr compactElements(
+    const TVector& vector,
+    const VectorPtr& elements,
+    memory::MemoryPool* pool) {
+  auto rawOffsets = vector.rawOffsets();
+  auto rawSizes = vector.rawSizes();
+  auto rawNulls = vector.rawNulls();
+  vector_size_t numElements = 0;
+  for (vector_size_t i = 0; i < vector.size(); ++i) {
+    if (!rawNulls || !bits::isBitNull(rawNulls, i)) {
+      numElements += rawSizes[i];
+    }
+  }
+  auto compacted = BaseVector::create(elements->type(), numElements, pool);
+  vector_size_t target = 0;
+  for (vector_size_t i = 0; i < vector.size(); ++i) {
+    if ((rawNulls && bits::isBitNull(rawNulls, i)) || rawSizes[i] == 0) {
+      continue;
+    }
+    compacted->copy(elements.get(), target, rawOffsets[i], rawSizes[i]);
+    target += rawSizes[i];
+  }
+  return compacted;
+}
+
+// Arrays are exported as Arrow large lists ("+L"), with 64 bit offsets.
+void exportArrayVector(
+    const ArrayVector& arrayVector,
+    ArrowArray& arrowArray,
+    VeloxToArrowBridgeHolder& bridgeHolder,
+    memory::MemoryPool* pool) {
+  const bool consecutive = hasConsecutiveRanges(arrayVector);
+  exportOffsets<int64_t>(arrayVector, consecutive, bridgeHolder, pool);
+  arrowArray.n_buffers = 2;
+
+  bridgeHolder.resizeChildren(1);
+  exportToArrow(
+      consecutive
+          ? arrayVector.elements()
+          : compactElements(arrayVector, arrayVector.elements(), pool),
+      *bridgeHolder.allocateChild(0),
+      pool);
+  arrowArray.n_children = 1;
+  arrowArray.children = bridgeHolder.getChildrenArrays();
+}
+
+// Returns the type of the struct child of an Arrow map of 'mapType'.
+RowTypePtr mapEntriesType(const TypePtr& mapType) {
+  return ROW({"key", "value"}, {mapType->childAt(0), mapType->childAt(1)});
+}
+
+// Maps are exported as Arrow maps ("+m"), with 32 bit offsets and a single
+// non-nullable struct child holding the keys and values.
+void exportMapVector(
+    const MapVector& mapVector,
+    ArrowArray& arrowArray,
+    VeloxToArrowBridgeHolder& bridgeHolder,
+    memory::MemoryPool* pool) {
+  const bool consecutive = hasConsecutiveRanges(mapVector);
+  exportOffsets<int32_t>(mapVector, consecutive, bridgeHolder, pool);
+  arrowArray.n_buffers = 2;
+
+  auto keys = consecutive
+      ? mapVector.mapKeys()
+      : compactElements(mapVector, mapVector.mapKeys(), pool);
+  auto values = consecutive
+      ? mapVector.mapValues()
+      : compactElements(mapVector, mapVector.mapValues(), pool);
+  VELOX_CHECK_EQ(keys->size(), values->size());
+  auto entries = std::make_shared<RowVector>(
+      pool,
+      mapEntriesType(mapVector.type()),
+      nullptr,
+      keys->size(),
+      std::vector<VectorPtr>{keys, values});
+  bridgeHolder.resizeChildren(1);
+  exportToArrow(entries, *bridgeHolder.allocateChild(0), pool);
+  arrowArray.n_children = 1;
+  arrowArray.children = bridgeHolder.getChildrenArrays();
+}
+
+// Dictionaries are exported without copying: the int32 indices become the
+// values buffer and the dictionary values are exported as
+// ArrowArray.dictionary.
+void exportDictionaryVector(
+    const BaseVector& vector,
+    ArrowArray& arrowArray,
+    VeloxToArrowBridgeHolder& bridgeHolder,
+    memory::MemoryPool* pool) {
+  static_assert(sizeof(vector_size_t) == sizeof(int32_t));
+  bridgeHolder.setBuffer(1, vector.wrapInfo());
+  arrowArray.n_buffers = 2;
+  auto* dictionary = bridgeHolder.allocateDictionary();
+  exportToArrow(vector.valueVector(), *dictionary, pool);
+  arrowArray.dictionary = dictionary;
+}
+
+// Returns the children of 'vector' as exportToArrow() exports them, or an
+// empty vector if the children of the ArrowSchema follow from the type.
+std::vector<VectorPtr> exportedChildren(const BaseVector& vector) {
+  switch (vector.encoding()) {
+    case VectorEncoding::Simple::ROW: {
+      std::vector<VectorPtr> children;
+      for (auto& child : vector.as<RowVector>()->children()) {
+        children.push_back(BaseVector::loadedVectorShared(child));
+      }
+      return children;
+    }
+    case VectorEncoding::Simple::ARRAY: {
+      auto arrayVector = vector.as<ArrayVector>();
+      if (hasConsecutiveRanges(*arrayVector)) {
+        return {arrayVector->elements()};
+      }
+      return {};
+    }
+    case VectorEncoding::Simple::MAP: {
+      auto mapVector = vector.as<MapVector>();
+      if (hasConsecutiveRanges(*mapVector)) {
+        return {mapVector->mapKeys(), mapVector->mapValues()};
+      }
+      return {};
+    }
+    default:
+      return {};
+  }
+}
+
 // Returns the Arrow C data interface format type for a given Velox type.
 const char* exportArrowFormatStr(const TypePtr& type) {
   switch (type->kind()) {
@@ -319,6 +518,11 @@ void exportToArrow(
     const VectorPtr& vector,
     ArrowArray& arrowArray,
     memory::MemoryPool* pool) {
+  if (vector->encoding() == VectorEncoding::Simple::LAZY) {
+    exportToArrow(BaseVector::loadedVectorShared(vector), arrowArray, pool);
+    return;
+  }
+
   // Bridge holder is stored in private_data, which is a C-compatible naked
   // pointer. However, since this function can throw (unsupported conversion
   // type, for instance), we temporarily use a unique_ptr to ensure the bridge
@@ -350,6 +554,7 @@ void exportToArrow(
     // If no nulls buffer, it means we have exactly zero nulls.
     arrowArray.null_count = 0;
   }
+  arrowArray.dictionary = nullptr;
 
   switch (vector->encoding()) {
     case VectorEncoding::Simple::FLAT:
@@ -364,24 +569,43 @@ void exportToArrow(
           pool);
       break;
 
+    case VectorEncoding::Simple::ARRAY:
+      exportArrayVector(
+          *vector->asUnchecked<ArrayVector>(), arrowArray, *bridgeHolder, pool);
+      break;
+
+    case VectorEncoding::Simple::MAP:
+      exportMapVector(
+          *vector->asUnchecked<MapVector>(), arrowArray, *bridgeHolder, pool);
+      break;
+
+    case VectorEncoding::Simple::DICTIONARY:
+      exportDictionaryVector(*vector, arrowArray, *bridgeHolder, pool);
+      break;
+
     default:
       VELOX_NYI("{} cannot be exported to Arrow yet.", vector->encoding());
       break;
   }
 
-  // TODO: No dictionaries for now.
-  arrowArray.dictionary = nullptr;
-
   // We release the unique_ptr since bridgeHolder will now be carried inside
   // ArrowArray.
   arrowArray.private_data = bridgeHolder.release();
 }
 
-void exportToArrow(const TypePtr& type, ArrowSchema& arrowSchema) {
+namespace {
+
+// Exports 'type' to 'arrowSchema'. If 'children' is not empty, the child
+// schemas are exported from these vectors instead of from the child types, so
+// that they describe the encodings of the children.
+void exportSchema(
+    const TypePtr& type,
+    const std::vector<VectorPtr>& children,
+    ArrowSchema& arrowSchema) {
   arrowSchema.format = exportArrowFormatStr(type);
   arrowSchema.name = nullptr;
 
-  // No additional metadata or support for dictionaries for now.
+  // No additional metadata for now.
   arrowSchema.metadata = nullptr;
   arrowSchema.dictionary = nullptr;
 
@@ -390,6 +614,23 @@ void exportToArrow(const TypePtr& type, ArrowSchema& arrowSchema) {
 
   // Allocate private data buffer holder and recurse down to children types.
   auto bridgeHolder = std::make_unique<VeloxToArrowSchemaBridgeHolder>();
+
+  // The child of a map is a non-nullable struct named 'entries' with
+  // non-nullable keys.
+  if (type->kind() == TypeKind::MAP) {
+    auto& entries = bridgeHolder->childrenOwned.emplace_back(
+        std::make_unique<ArrowSchema>());
+    exportSchema(mapEntriesType(type), children, *entries);
+    entries->name = "entries";
+    entries->flags = 0;
+    entries->children[0]->flags = 0;
+    bridgeHolder->childrenRaw.push_back(entries.get());
+    arrowSchema.n_children = 1;
+    arrowSchema.children = bridgeHolder->childrenRaw.data();
+    arrowSchema.release = bridgeSchemaRelease;
+    arrowSchema.private_data = bridgeHolder.release();
+    return;
+  }
   const size_t numChildren = type->size();
 
   if (numChildren > 0) {
@@ -419,7 +660,11 @@ void exportToArrow(const TypePtr& type, ArrowSchema& arrowSchema) {
       try {
         auto& currentSchema = bridgeHolder->childrenOwned[i];
         currentSchema = std::make_unique<ArrowSchema>();
-        exportToArrow(type->childAt(i), *currentSchema);
+        if (children.empty()) {
+          exportToArrow(type->childAt(i), *currentSchema);
+        } else {
+          exportToArrow(children[i], *currentSchema);
+        }
 
         if (bridgeHolder->rowType) {
           currentSchema->name = bridgeHolder->rowType->nameOf(i).data();
@@ -444,7 +689,185 @@ void exportToArrow(const TypePtr& type, ArrowSchema& arrowSchema) {
   arrowSchema.private_data = bridgeHolder.release();
 }
 
+} // namespace
+
+void exportToArrow(const TypePtr& type, ArrowSchema& arrowSchema) {
+  exportSchema(type, {}, arrowSchema);
+}
+
+void exportToArrow(const VectorPtr& vector, ArrowSchema& arrowSchema) {
+  auto loaded = BaseVector::loadedVectorShared(vector);
+  if (loaded->encoding() != VectorEncoding::Simple::DICTIONARY) {
+    exportSchema(loaded->type(), exportedChildren(*loaded), arrowSchema);
+    return;
+  }
+
+  // Dictionary indices are int32 and the schema of the values hangs off
+  // ArrowSchema.dictionary.
+  auto bridgeHolder = std::make_unique<VeloxToArrowSchemaBridgeHolder>();
+  bridgeHolder->dictionary = std::make_unique<ArrowSchema>();
+  exportToArrow(loaded->valueVector(), *bridgeHolder->dictionary);
+
+  arrowSchema.format = "i";
+  arrowSchema.name = nullptr;
+  arrowSchema.metadata = nullptr;
+  arrowSchema.flags = ARROW_FLAG_NULLABLE;
+  arrowSchema.n_children = 0;
+  arrowSchema.children = nullptr;
+  arrowSchema.dictionary = bridgeHolder->dictionary.get();
+  arrowSchema.release = bridgeSchemaRelease;
+  arrowSchema.private_data = bridgeHolder.release();
+}
+
+bool isArrowExportable(const BaseVector& vector, bool allowDictionaries) {
+  const auto& loaded = *vector.loadedVector();
+  switch (loaded.encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      switch (loaded.typeKind()) {
+        case TypeKind::BOOLEAN:
+        case TypeKind::TINYINT:
+        case TypeKind::SMALLINT:
+        case TypeKind::INTEGER:
+        case TypeKind::BIGINT:
+        case TypeKind::REAL:
+        case TypeKind::DOUBLE:
+        case TypeKind::VARCHAR:
+        case TypeKind::VARBINARY:
+          return true;
+        default:
+          return false;
+      }
+    case VectorEncoding::Simple::ROW:
+      for (auto& child : loaded.as<RowVector>()->children()) {
+        if (!child || !isArrowExportable(*child, allowDictionaries)) {
+          return false;
+        }
+      }
+      return true;
+    case VectorEncoding::Simple::ARRAY:
+      return isArrowExportable(
+          *loaded.as<ArrayVector>()->elements(), allowDictionaries);
+    case VectorEncoding::Simple::MAP: {
+      auto mapVector = loaded.as<MapVector>();
+      return isArrowExportable(*mapVector->mapKeys(), allowDictionaries) &&
+          isArrowExportable(*mapVector->mapValues(), allowDictionaries);
+    }
+    case VectorEncoding::Simple::DICTIONARY:
+      return allowDictionaries &&
+          isArrowExportable(*loaded.valueVector(), allowDictionaries);
+    default:
+      return false;
+  }
+}
+
+namespace {
+
+// State of an ArrowArrayStream exported by exportToArrow(). Carried by
+// ArrowArrayStream.private_data.
+struct VeloxToArrowStreamHolder {
+  RowTypePtr type;
+  std::function<RowVectorPtr()> next;
+  memory::MemoryPool* pool;
+  std::string lastError;
+};
+
+VeloxToArrowStreamHolder* streamHolder(ArrowArrayStream* arrowStream) {
+  return static_cast<VeloxToArrowStreamHolder*>(arrowStream->private_data);
+}
+
+// Copies the columns of 'batch' that cannot be exported as plain Arrow arrays
+// into flat vectors.
+RowVectorPtr makeStreamExportable(
+    const RowVectorPtr& batch,
+    memory::MemoryPool* pool) {
+  if (isArrowExportable(*batch, false)) {
+    return batch;
+  }
+  std::vector<VectorPtr> children;
+  children.reserve(batch->childrenSize());
+  for (auto i = 0; i < batch->childrenSize(); ++i) {
+    auto& child = batch->loadedChildAt(i);
+    if (isArrowExportable(*child, false)) {
+      children.push_back(child);
+    } else {
+      auto flat = BaseVector::create(child->type(), child->size(), pool);
+      flat->copy(child.get(), 0, 0, child->size());
+      children.push_back(std::move(flat));
+    }
+  }
+  return std::make_shared<RowVector>(
+      pool,
+      batch->type(),
+      batch->nulls(),
+      batch->size(),
+      std::move(children));
+}
+
+int streamGetSchema(ArrowArrayStream* arrowStream, ArrowSchema* out) {
+  auto* holder = streamHolder(arrowStream);
+  try {
+    exportToArrow(holder->type, *out);
+  } catch (const std::exception& e) {
+    holder->lastError = e.what();
+    return EINVAL;
+  }
+  return 0;
+}
+
+int streamGetNext(ArrowArrayStream* arrowStream, ArrowArray* out) {
+  auto* holder = streamHolder(arrowStream);
+  try {
+    auto batch = holder->next();
+    if (!batch) {
+      // A released array marks the end of the stream.
+      out->release = nullptr;
+      return 0;
+    }
+    exportToArrow(
+        makeStreamExportable(batch, holder->pool), *out, holder->pool);
+  } catch (const std::exception& e) {
+    holder->lastError = e.what();
+    return EIO;
+  }
+  return 0;
+}
+
+const char* streamGetLastError(ArrowArrayStream* arrowStream) {
+  auto* holder = streamHolder(arrowStream);
+  return holder->lastError.empty() ? nullptr : holder->lastError.c_str();
+}
+
+void streamRelease(ArrowArrayStream* arrowStream) {
+  if (!arrowStream || !arrowStream->release) {
+    return;
+  }
+  delete streamHolder(arrowStream);
+  arrowStream->release = nullptr;
+  arrowStream->private_data = nullptr;
+}
+
+} // namespace
+
+void exportToArrow(
+    const RowTypePtr& type,
+    std::function<RowVectorPtr()> next,
+    ArrowArrayStream& arrowStream,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK_NOT_NULL(next);
+  arrowStream.get_schema = streamGetSchema;
+  arrowStream.get_next = streamGetNext;
+  arrowStream.get_last_error = streamGetLastError;
+  arrowStream.release = streamRelease;
+  arrowStream.private_data =
+      new VeloxToArrowStreamHolder{type, std::move(next), pool, ""};
+}
+
 TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
+  // The type of a dictionary encoded array is the type of its values.
+  if (arrowSchema.dictionary != nullptr) {
+    return importFromArrow(*arrowSchema.dictionary);
+  }
+
   const char* format = arrowSchema.format;
   VELOX_CHECK_NOT_NULL(format);
 
@@ -494,13 +917,19 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
           return ARRAY(importFromArrow(*arrowSchema.children[0]));
 
         // Map.
-        case 'm':
-          VELOX_CHECK_EQ(arrowSchema.n_children, 2);
-          VELOX_CHECK_NOT_NULL(arrowSchema.children[0]);
-          VELOX_CHECK_NOT_NULL(arrowSchema.children[1]);
+        case 'm': {
+          // A single struct child holds the keys and values.
+          VELOX_CHECK_EQ(arrowSchema.n_children, 1);
+          auto entries = arrowSchema.children[0];
+          VELOX_CHECK_NOT_NULL(entries);
+          VELOX_CHECK_EQ(std::string_view(entries->format), "+s");
+          VELOX_CHECK_EQ(entries->n_children, 2);
+          VELOX_CHECK_NOT_NULL(entries->children[0]);
+          VELOX_CHECK_NOT_NULL(entries->children[1]);
           return MAP(
-              importFromArrow(*arrowSchema.children[0]),
-              importFromArrow(*arrowSchema.children[1]));
+              importFromArrow(*entries->children[0]),
+              importFromArrow(*entries->children[1]));
+        }
 
         // Struct/rows.
         case 's': {
@@ -626,7 +1055,7 @@ VectorPtr createStringFlatVector(
   std::vector<BufferPtr> stringViewBuffers;
   if (shouldAcquireStringBuffer) {
     stringViewBuffers.emplace_back(
-        wrapInBufferView(values, offsets[length + 1]));
+        wrapInBufferView(values, offsets[length]));
   }
 
   return std::make_shared<FlatVector<StringView>>(
@@ -648,6 +1077,16 @@ VectorPtr importFromArrowImpl(
     bool isViewer,
     WrapInBufferViewFunc wrapInBufferView);
 
+// Imports a child or dictionary of an ArrowArray being imported.
+VectorPtr importChild(
+    ArrowSchema& arrowSchema,
+    ArrowArray& arrowArray,
+    memory::MemoryPool* pool,
+    bool isViewer) {
+  return isViewer ? importFromArrowAsViewer(arrowSchema, arrowArray, pool)
+                  : importFromArrowAsOwner(arrowSchema, arrowArray, pool);
+}
+
 RowVectorPtr createRowVector(
     memory::MemoryPool* pool,
     const RowTypePtr& rowType,
@@ -662,12 +1101,8 @@ RowVectorPtr createRowVector(
   childrenVector.reserve(arrowArray.n_children);
 
   for (size_t i = 0; i < arrowArray.n_children; ++i) {
-    childrenVector.emplace_back(
-        isViewer
-            ? importFromArrowAsViewer(
-                  *arrowSchema.children[i], *arrowArray.children[i], pool)
-            : importFromArrowAsOwner(
-                  *arrowSchema.children[i], *arrowArray.children[i], pool));
+    childrenVector.emplace_back(importChild(
+        *arrowSchema.children[i], *arrowArray.children[i], pool, isViewer));
   }
   return std::make_shared<RowVector>(
       pool,
@@ -680,6 +1115,117 @@ RowVectorPtr createRowVector(
           : std::optional<int64_t>(arrowArray.null_count));
 }
 
+// Velox offsets and sizes are int32. Arrow offsets are converted, while the
+// elements are imported without copying.
+template <typename TOffset>
+void importOffsets(
+    const ArrowArray& arrowArray,
+    memory::MemoryPool* pool,
+    BufferPtr& offsets,
+    BufferPtr& sizes) {
+  VELOX_USER_CHECK_EQ(
+      arrowArray.n_buffers,
+      2,
+      "Expecting two buffers as input for list and map types.");
+  auto arrowOffsets = static_cast<const TOffset*>(arrowArray.buffers[1]);
+  offsets = AlignedBuffer::allocate<vector_size_t>(arrowArray.length, pool);
+  sizes = AlignedBuffer::allocate<vector_size_t>(arrowArray.length, pool);
+  auto rawOffsets = offsets->asMutable<vector_size_t>();
+  auto rawSizes = sizes->asMutable<vector_size_t>();
+  for (int64_t i = 0; i < arrowArray.length; ++i) {
+    rawOffsets[i] = arrowOffsets[i];
+    rawSizes[i] = arrowOffsets[i + 1] - arrowOffsets[i];
+  }
+}
+
+VectorPtr createArrayVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowSchema& arrowSchema,
+    const ArrowArray& arrowArray,
+    bool isViewer) {
+  VELOX_USER_CHECK_EQ(arrowArray.n_children, 1);
+  BufferPtr offsets;
+  BufferPtr sizes;
+  importOffsets<int64_t>(arrowArray, pool, offsets, sizes);
+  auto elements = importChild(
+      *arrowSchema.children[0], *arrowArray.children[0], pool, isViewer);
+  return std::make_shared<ArrayVector>(
+      pool,
+      type,
+      nulls,
+      arrowArray.length,
+      offsets,
+      sizes,
+      elements,
+      arrowArray.null_count == -1
+          ? std::nullopt
+          : std::optional<int64_t>(arrowArray.null_count));
+}
+
+VectorPtr createMapVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowSchema& arrowSchema,
+    const ArrowArray& arrowArray,
+    bool isViewer) {
+  VELOX_USER_CHECK_EQ(arrowArray.n_children, 1);
+  BufferPtr offsets;
+  BufferPtr sizes;
+  importOffsets<int32_t>(arrowArray, pool, offsets, sizes);
+  // The keys and values are the children of the struct child.
+  auto entries = importChild(
+      *arrowSchema.children[0], *arrowArray.children[0], pool, isViewer);
+  VELOX_USER_CHECK_EQ(
+      entries->encoding(),
+      VectorEncoding::Simple::ROW,
+      "Expecting a struct child for map type.");
+  auto keys = entries->as<RowVector>()->childAt(0);
+  auto values = entries->as<RowVector>()->childAt(1);
+  return std::make_shared<MapVector>(
+      pool,
+      type,
+      nulls,
+      arrowArray.length,
+      offsets,
+      sizes,
+      keys,
+      values,
+      arrowArray.null_count == -1
+          ? std::nullopt
+          : std::optional<int64_t>(arrowArray.null_count));
+}
+
+// Wraps the imported dictionary values in a DictionaryVector using the int32
+// indices without copying them.
+VectorPtr createDictionaryVector(
+    memory::MemoryPool* pool,
+    BufferPtr nulls,
+    const ArrowSchema& arrowSchema,
+    const ArrowArray& arrowArray,
+    bool isViewer,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_USER_CHECK_NOT_NULL(
+      arrowSchema.dictionary,
+      "Dictionary encoded arrowArray requires a dictionary in arrowSchema.");
+  VELOX_USER_CHECK_EQ(
+      std::string_view(arrowSchema.format),
+      "i",
+      "Only int32 dictionary indices are supported.");
+  VELOX_USER_CHECK_EQ(
+      arrowArray.n_buffers,
+      2,
+      "Expecting two buffers as input for dictionary indices.");
+  auto indices = wrapInBufferView(
+      arrowArray.buffers[1], arrowArray.length * sizeof(vector_size_t));
+  auto values = importChild(
+      *arrowSchema.dictionary, *arrowArray.dictionary, pool, isViewer);
+  return BaseVector::wrapInDictionary(
+      nulls, indices, arrowArray.length, values);
+}
+
 VectorPtr importFromArrowImpl(
     const ArrowSchema& arrowSchema,
     const ArrowArray& arrowArray,
@@ -688,24 +1234,12 @@ VectorPtr importFromArrowImpl(
     WrapInBufferViewFunc wrapInBufferView) {
   VELOX_USER_CHECK_NOT_NULL(arrowSchema.release, "arrowSchema was released.");
   VELOX_USER_CHECK_NOT_NULL(arrowArray.release, "arrowArray was released.");
-  VELOX_USER_CHECK_NULL(
-      arrowArray.dictionary,
-      "Dictionary encoded arrowArrays not supported yet.");
   VELOX_USER_CHECK_EQ(
       arrowArray.offset,
       0,
       "Offsets are not supported during arrow conversion yet.");
   VELOX_CHECK_GE(arrowArray.length, 0, "Array length needs to be positive.");
 
-  // First parse and generate a Velox type.
-  auto type = importFromArrow(arrowSchema);
-
-  // Only primitive types and row/struct supported for now.
-  VELOX_CHECK(
-      type->isPrimitiveType() || type->isRow(),
-      "Conversion of '{}' from arrow not supported yet.",
-      type->toString());
-
   // Wrap the nulls buffer into a Velox BufferView (zero-copy). Null buffer size
   // needs to be at least one bit per element.
   BufferPtr nulls = nullptr;
@@ -723,6 +1257,14 @@ VectorPtr importFromArrowImpl(
         arrowArray.buffers[0], bits::nbytes(arrowArray.length));
   }
 
+  if (arrowArray.dictionary != nullptr) {
+    return createDictionaryVector(
+        pool, nulls, arrowSchema, arrowArray, isViewer, wrapInBufferView);
+  }
+
+  // First parse and generate a Velox type.
+  auto type = importFromArrow(arrowSchema);
+
   // String data types (VARCHAR and VARBINARY).
   if (type->isVarchar() || type->isVarbinary()) {
     VELOX_USER_CHECK_EQ(
@@ -749,8 +1291,21 @@ VectorPtr importFromArrowImpl(
         arrowArray,
         isViewer);
   }
+  // Arrays/lists.
+  else if (type->kind() == TypeKind::ARRAY) {
+    return createArrayVector(
+        pool, type, nulls, arrowSchema, arrowArray, isViewer);
+  }
+  // Maps.
+  else if (type->kind() == TypeKind::MAP) {
+    return createMapVector(pool, type, nulls, arrowSchema, arrowArray, isViewer);
+  }
   // Other primitive types.
   else {
+    VELOX_CHECK(
+        type->isPrimitiveType(),
+        "Conversion of '{}' from arrow not supported yet.",
+        type->toString());
     // Wrap the values buffer into a Velox BufferView - zero-copy.
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <functional>
+
 #include "velox/common/memory/Memory.h"
-#include "velox/vector/BaseVector.h"
+#include "velox/vector/ComplexVector.h"
 #include "velox/vector/arrow/Abi.h"
 
 namespace facebook::velox {
@@ -74,6 +76,43 @@ void exportToArrow(
 ///
 void exportToArrow(const TypePtr& type, ArrowSchema& arrowSchema);
 
+/// Export the schema of a generic Velox Vector to an ArrowSchema.
+///
+/// Unlike the TypePtr overload, this one describes the encodings of 'vector'
+/// the way exportToArrow(vector, arrowArray) exports them: dictionary encoded
+/// vectors, at any level of nesting, are described as int32 indices with
+/// ArrowSchema.dictionary set to the schema of the dictionary values. Use
+/// this schema together with an ArrowArray exported from the same vector.
+void exportToArrow(const VectorPtr& vector, ArrowSchema& arrowSchema);
+
+/// Returns true if exportToArrow(vector, arrowArray) can export 'vector'
+/// without throwing. Vectors using encodings the bridge does not export, e.g.
+/// constant vectors, need to be copied into flat vectors first. If
+/// 'allowDictionaries' is false, vectors with dictionary encoding at any level
+/// also return false.
+bool isArrowExportable(const BaseVector& vector, bool allowDictionaries = true);
+
+/// Export a sequence of RowVectors of type 'type' to an ArrowArrayStream, as
+/// defined by Arrow's C stream interface:
+///
+///   https://arrow.apache.org/docs/format/CStreamInterface.html
+///
+/// Each call to get_next() calls 'next' and exports the RowVector it returns.
+/// 'next' returns nullptr after the last batch. Batches are exported without
+/// copying wherever exportToArrow(vector, arrowArray) allows. Since all
+/// batches of a stream share one schema, columns that are not exportable as
+/// plain Arrow arrays (see isArrowExportable()) are copied into flat vectors.
+/// Exceptions thrown by 'next' are reported through get_last_error().
+///
+/// 'pool' is used for these copies and must outlive the stream. The consumer
+/// is responsible for calling arrowStream.release().
+void exportToArrow(
+    const RowTypePtr& type,
+    std::function<RowVectorPtr()> next,
+    ArrowArrayStream& arrowStream,
+    memory::MemoryPool* pool =
+        &velox::memory::getProcessDefaultMemoryManager().getRoot());
+
 /// Import an ArrowSchema into a Velox Type object.
 ///
 /// This function does the exact opposite of the function above. TypePtr carries
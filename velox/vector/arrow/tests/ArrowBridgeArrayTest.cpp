@@ -20,6 +20,7 @@
 #include "velox/core/QueryCtx.h"
 #include "velox/vector/arrow/Bridge.h"
 #include "velox/vector/tests/VectorMaker.h"
+#include "velox/vector/tests/VectorTestBase.h"
 
 namespace {
 
@@ -30,6 +31,19 @@ void mockArrayRelease(ArrowArray*) {}
 
 class ArrowBridgeArrayExportTest : public testing::Test {
  protected:
+  // Exports 'vector' together with its schema and checks that importing the
+  // result gives back the same values.
+  void testRoundTrip(const VectorPtr& vector) {
+    ArrowSchema arrowSchema;
+    ArrowArray arrowArray;
+    exportToArrow(vector, arrowSchema);
+    exportToArrow(vector, arrowArray, pool_.get());
+    auto imported =
+        importFromArrowAsOwner(arrowSchema, arrowArray, pool_.get());
+    EXPECT_EQ(nullptr, arrowArray.release);
+    facebook::velox::test::assertEqualVectors(vector, imported);
+  }
+
   template <typename T>
   void testFlatVector(const std::vector<std::optional<T>>& inputData) {
     const bool isString =
@@ -404,24 +418,164 @@ TEST_F(ArrowBridgeArrayExportTest, unsupported) {
   vector = vectorMaker_.flatVectorNullable<Date>({});
   EXPECT_THROW(exportToArrow(vector, arrowArray, pool_.get()), VeloxException);
 
-  // Arrays.
-  vector = vectorMaker_.arrayVector<int64_t>({{1, 2, 3}, {4, 5}});
-  EXPECT_THROW(exportToArrow(vector, arrowArray, pool_.get()), VeloxException);
-
-  // Maps.
-  auto lambda = [](vector_size_t /* row */) { return 1; };
-  vector = vectorMaker_.mapVector<int64_t, int64_t>(2, lambda, lambda, lambda);
-  EXPECT_THROW(exportToArrow(vector, arrowArray, pool_.get()), VeloxException);
-
   // Constant encoding.
   vector = BaseVector::createConstant(variant(10), 10, pool_.get());
+  EXPECT_FALSE(isArrowExportable(*vector));
   EXPECT_THROW(exportToArrow(vector, arrowArray, pool_.get()), VeloxException);
+}
 
-  // Dictionary encoding.
-  BufferPtr indices = AlignedBuffer::allocate<vector_size_t>(3, pool_.get());
-  vector = BaseVector::wrapInDictionary(
-      BufferPtr(), indices, 3, vectorMaker_.flatVector<int64_t>({1, 2, 3}));
-  EXPECT_THROW(exportToArrow(vector, arrowArray, pool_.get()), VeloxException);
+TEST_F(ArrowBridgeArrayExportTest, arrayVector) {
+  auto vector = vectorMaker_.arrayVectorNullable<int64_t>(
+      {{{1, 2, 3}}, std::nullopt, {{4, std::nullopt}}, {{}}, {{5}}});
+  ArrowArray arrowArray;
+  exportToArrow(vector, arrowArray, pool_.get());
+
+  EXPECT_EQ(5, arrowArray.length);
+  EXPECT_EQ(1, arrowArray.null_count);
+  EXPECT_EQ(2, arrowArray.n_buffers);
+  EXPECT_EQ(1, arrowArray.n_children);
+
+  // Elements are consecutive, so they are exported as is.
+  auto offsets = static_cast<const int64_t*>(arrowArray.buffers[1]);
+  std::vector<int64_t> expectedOffsets = {0, 3, 3, 5, 5, 6};
+  EXPECT_EQ(expectedOffsets, std::vector<int64_t>(offsets, offsets + 6));
+  EXPECT_EQ(
+      vector->elements()->values()->as<void>(),
+      arrowArray.children[0]->buffers[1]);
+  arrowArray.release(&arrowArray);
+
+  testRoundTrip(vector);
+}
+
+TEST_F(ArrowBridgeArrayExportTest, arrayVectorOutOfOrder) {
+  // Rows reference the elements backwards, which Arrow offsets cannot express.
+  auto elements = vectorMaker_.flatVector<int32_t>({1, 2, 3, 4, 5, 6});
+  auto offsets = AlignedBuffer::allocate<vector_size_t>(3, pool_.get());
+  auto sizes = AlignedBuffer::allocate<vector_size_t>(3, pool_.get());
+  auto rawOffsets = offsets->asMutable<vector_size_t>();
+  auto rawSizes = sizes->asMutable<vector_size_t>();
+  rawOffsets[0] = 4;
+  rawSizes[0] = 2;
+  rawOffsets[1] = 0;
+  rawSizes[1] = 3;
+  rawOffsets[2] = 1;
+  rawSizes[2] = 1;
+  auto vector = std::make_shared<ArrayVector>(
+      pool_.get(), ARRAY(INTEGER()), nullptr, 3, offsets, sizes, elements);
+
+  ArrowArray arrowArray;
+  exportToArrow(vector, arrowArray, pool_.get());
+  auto arrowOffsets = static_cast<const int64_t*>(arrowArray.buffers[1]);
+  std::vector<int64_t> expectedOffsets = {0, 2, 5, 6};
+  EXPECT_EQ(
+      expectedOffsets, std::vector<int64_t>(arrowOffsets, arrowOffsets + 4));
+  EXPECT_EQ(6, arrowArray.children[0]->length);
+  arrowArray.release(&arrowArray);
+
+  testRoundTrip(vector);
+}
+
+TEST_F(ArrowBridgeArrayExportTest, mapVector) {
+  auto vector = vectorMaker_.mapVector<int64_t, StringView>(
+      10,
+      [](vector_size_t row) { return row % 3; },
+      [](vector_size_t idx) { return idx; },
+      [](vector_size_t idx) {
+        return idx % 2 ? StringView("a long string that is not inlined")
+                       : StringView("short");
+      },
+      [](vector_size_t row) { return row % 4 == 1; });
+  ArrowArray arrowArray;
+  exportToArrow(vector, arrowArray, pool_.get());
+  EXPECT_EQ(2, arrowArray.n_buffers);
+  // The keys and values are the children of a single struct child.
+  ASSERT_EQ(1, arrowArray.n_children);
+  auto& entries = *arrowArray.children[0];
+  EXPECT_EQ(vector->mapKeys()->size(), entries.length);
+  EXPECT_EQ(0, entries.null_count);
+  EXPECT_EQ(2, entries.n_children);
+  arrowArray.release(&arrowArray);
+
+  testRoundTrip(vector);
+}
+
+TEST_F(ArrowBridgeArrayExportTest, dictionaryVector) {
+  auto base = vectorMaker_.flatVectorNullable<StringView>(
+      {"apple", std::nullopt, "a string longer than the inline size"});
+  auto indices = AlignedBuffer::allocate<vector_size_t>(6, pool_.get());
+  auto rawIndices = indices->asMutable<vector_size_t>();
+  for (auto i = 0; i < 6; ++i) {
+    rawIndices[i] = (i * 2) % 3;
+  }
+  auto vector = BaseVector::wrapInDictionary(nullptr, indices, 6, base);
+
+  ArrowSchema arrowSchema;
+  exportToArrow(vector, arrowSchema);
+  EXPECT_STREQ("i", arrowSchema.format);
+  ASSERT_NE(nullptr, arrowSchema.dictionary);
+  EXPECT_STREQ("u", arrowSchema.dictionary->format);
+  arrowSchema.release(&arrowSchema);
+
+  // The indices are exported without copying.
+  ArrowArray arrowArray;
+  exportToArrow(vector, arrowArray, pool_.get());
+  EXPECT_EQ(rawIndices, arrowArray.buffers[1]);
+  ASSERT_NE(nullptr, arrowArray.dictionary);
+  EXPECT_EQ(3, arrowArray.dictionary->length);
+  arrowArray.release(&arrowArray);
+
+  testRoundTrip(vector);
+  testRoundTrip(vectorMaker_.rowVector(
+      {vector,
+       vectorMaker_.arrayVector<int32_t>({{1}, {}, {2, 3}, {4}, {5}, {6}})}));
+}
+
+TEST_F(ArrowBridgeArrayExportTest, stream) {
+  auto dictionary = BaseVector::wrapInDictionary(
+      nullptr,
+      facebook::velox::test::makeIndicesInReverse(3, pool_.get()),
+      3,
+      vectorMaker_.flatVector<int64_t>({1, 2, 3}));
+  std::vector<RowVectorPtr> batches = {
+      vectorMaker_.rowVector({vectorMaker_.flatVector<int64_t>({1, 2})}),
+      vectorMaker_.rowVector({dictionary}),
+      vectorMaker_.rowVector(
+          {BaseVector::createConstant(variant(int64_t(7)), 2, pool_.get())})};
+  auto rowType = std::dynamic_pointer_cast<const RowType>(batches[0]->type());
+
+  int32_t numBatches = 0;
+  ArrowArrayStream arrowStream;
+  exportToArrow(
+      rowType,
+      [&]() {
+        return numBatches < batches.size() ? batches[numBatches++] : nullptr;
+      },
+      arrowStream,
+      pool_.get());
+
+  ArrowSchema arrowSchema;
+  ASSERT_EQ(0, arrowStream.get_schema(&arrowStream, &arrowSchema));
+  EXPECT_TRUE(rowType->equivalent(*importFromArrow(arrowSchema)));
+
+  for (auto& batch : batches) {
+    ArrowArray arrowArray;
+    ASSERT_EQ(0, arrowStream.get_next(&arrowStream, &arrowArray));
+    ASSERT_NE(nullptr, arrowArray.release);
+    // All batches follow the stream schema without dictionaries.
+    EXPECT_EQ(nullptr, arrowArray.children[0]->dictionary);
+    auto imported =
+        importFromArrowAsViewer(arrowSchema, arrowArray, pool_.get());
+    facebook::velox::test::assertEqualVectors(batch, imported);
+    arrowArray.release(&arrowArray);
+  }
+
+  ArrowArray end;
+  ASSERT_EQ(0, arrowStream.get_next(&arrowStream, &end));
+  EXPECT_EQ(nullptr, end.release);
+
+  arrowSchema.release(&arrowSchema);
+  arrowStream.release(&arrowStream);
+  EXPECT_EQ(nullptr, arrowStream.release);
 }
 
 class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
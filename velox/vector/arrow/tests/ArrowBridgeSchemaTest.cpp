@@ -60,6 +60,17 @@ class ArrowBridgeSchemaExportTest : public testing::Test {
       EXPECT_EQ(std::string{"+L"}, std::string{schema.format});
     } else if (type->kind() == TypeKind::MAP) {
       EXPECT_EQ(std::string{"+m"}, std::string{schema.format});
+      // The keys and values are the children of a single non-nullable struct
+      // child with non-nullable keys.
+      ASSERT_EQ(1, schema.n_children);
+      auto& entries = *schema.children[0];
+      EXPECT_EQ(std::string{"entries"}, std::string{entries.name});
+      EXPECT_EQ(0, entries.flags);
+      verifyNestedType(
+          ROW({"key", "value"}, {type->childAt(0), type->childAt(1)}),
+          entries);
+      EXPECT_EQ(0, entries.children[0]->flags);
+      return;
     } else if (type->kind() == TypeKind::ROW) {
       EXPECT_EQ(std::string{"+s"}, std::string{schema.format});
     }
@@ -196,6 +207,24 @@ class ArrowBridgeSchemaImportTest : public ArrowBridgeSchemaExportTest {
     mainSchema.release(&mainSchema);
     return type;
   }
+
+  TypePtr testSchemaImportMap(const char* keyFormat, const char* valueFormat) {
+    std::vector<ArrowSchema> schemas = {
+        makeArrowSchema(keyFormat), makeArrowSchema(valueFormat)};
+    std::vector<ArrowSchema*> schemaPtrs = {&schemas[0], &schemas[1]};
+
+    auto entries = makeArrowSchema("+s");
+    entries.n_children = 2;
+    entries.children = schemaPtrs.data();
+    ArrowSchema* entriesPtr = &entries;
+
+    auto mapSchema = makeArrowSchema("+m");
+    mapSchema.n_children = 1;
+    mapSchema.children = &entriesPtr;
+    auto type = importFromArrow(mapSchema);
+    mapSchema.release(&mapSchema);
+    return type;
+  }
 };
 
 TEST_F(ArrowBridgeSchemaImportTest, scalar) {
@@ -224,11 +253,10 @@ TEST_F(ArrowBridgeSchemaImportTest, complexTypes) {
   EXPECT_EQ(*ARRAY(DATE()), *testSchemaImportComplex("+L", {"tdD"}));
   EXPECT_EQ(*ARRAY(VARCHAR()), *testSchemaImportComplex("+L", {"U"}));
 
-  // Map.
-  EXPECT_EQ(
-      *MAP(VARCHAR(), BOOLEAN()), *testSchemaImportComplex("+m", {"U", "b"}));
-  EXPECT_EQ(
-      *MAP(SMALLINT(), REAL()), *testSchemaImportComplex("+m", {"s", "f"}));
+  // Map. The keys and values are the children of a struct child.
+  EXPECT_EQ(*MAP(VARCHAR(), BOOLEAN()), *testSchemaImportMap("U", "b"));
+  EXPECT_EQ(*MAP(SMALLINT(), REAL()), *testSchemaImportMap("s", "f"));
+  EXPECT_THROW(testSchemaImportComplex("+m", {"U", "b"}), VeloxException);
 
   // Row/struct.
   EXPECT_EQ(
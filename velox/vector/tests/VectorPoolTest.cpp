@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/vector/VectorPool.h"
+#include "velox/vector/tests/VectorTestBase.h"
+
+using namespace facebook::velox;
+
+class VectorPoolTest : public testing::Test, public test::VectorTestBase {};
+
+TEST_F(VectorPoolTest, reuse) {
+  VectorPool vectorPool(pool());
+
+  auto vector = vectorPool.get(BIGINT(), 1'000);
+  EXPECT_EQ(1'000, vector->size());
+  EXPECT_EQ(0, vectorPool.numHits());
+  EXPECT_EQ(1, vectorPool.numMisses());
+
+  auto flat = vector->asFlatVector<int64_t>();
+  for (auto i = 0; i < 1'000; ++i) {
+    flat->set(i, i);
+  }
+  flat->setNull(10, true);
+  auto* rawValues = flat->rawValues();
+
+  ASSERT_TRUE(vectorPool.release(vector));
+  EXPECT_EQ(nullptr, vector);
+
+  // A request of the same or a somewhat smaller size gets the same memory
+  // with no nulls.
+  vector = vectorPool.get(BIGINT(), 600);
+  EXPECT_EQ(1, vectorPool.numHits());
+  EXPECT_EQ(600, vector->size());
+  EXPECT_EQ(rawValues, vector->asFlatVector<int64_t>()->rawValues());
+  EXPECT_FALSE(vector->isNullAt(10));
+
+  // A larger size or a different type does not hit.
+  ASSERT_TRUE(vectorPool.release(vector));
+  vectorPool.get(BIGINT(), 2'000);
+  vectorPool.get(INTEGER(), 600);
+  EXPECT_EQ(1, vectorPool.numHits());
+  EXPECT_EQ(3, vectorPool.numMisses());
+}
+
+TEST_F(VectorPoolTest, release) {
+  VectorPool vectorPool(pool());
+
+  // Vectors referenced from elsewhere are not taken.
+  VectorPtr vector = makeFlatVector<int32_t>(100, [](auto row) { return row; });
+  auto copy = vector;
+  EXPECT_FALSE(vectorPool.release(vector));
+  EXPECT_NE(nullptr, vector);
+  copy.reset();
+  EXPECT_TRUE(vectorPool.release(vector));
+
+  // Strings whose buffers are shared are not taken.
+  VectorPtr strings = makeFlatVector<std::string>(
+      std::vector<std::string>(100, std::string(20, 'x')));
+  auto buffers = strings->asFlatVector<StringView>()->stringBuffers();
+  EXPECT_FALSE(vectorPool.release(strings));
+  buffers.clear();
+  EXPECT_TRUE(vectorPool.release(strings));
+
+  // Complex types and empty vectors are not pooled.
+  VectorPtr array = makeArrayVector<int32_t>({{1, 2}, {3}});
+  EXPECT_FALSE(vectorPool.release(array));
+  VectorPtr empty = makeFlatVector<int32_t>(0, [](auto row) { return row; });
+  EXPECT_FALSE(vectorPool.release(empty));
+
+  // The number of vectors per size class is bounded.
+  std::vector<VectorPtr> vectors;
+  for (auto i = 0; i < VectorPool::kVectorsPerSizeClass + 2; ++i) {
+    vectors.push_back(vectorPool.get(DOUBLE(), 100));
+  }
+  EXPECT_EQ(VectorPool::kVectorsPerSizeClass, vectorPool.release(vectors));
+}